@@ -13,6 +13,8 @@
 #include "api/api-doc/storage_service.json.hh"
 #include <vector>
 #include <seastar/http/exception.hh>
+#include <seastar/core/with_scheduling_group.hh>
+#include <seastar/coroutine/exception.hh>
 #include "sstables/sstables.hh"
 #include "sstables/metadata_collector.hh"
 #include "utils/assert.hh"
@@ -22,6 +24,8 @@
 #include "db/data_listeners.hh"
 #include "storage_service.hh"
 #include "compaction/compaction_manager.hh"
+#include "mutation/json.hh"
+#include "readers/compacting.hh"
 #include "unimplemented.hh"
 
 #include <boost/range/algorithm/copy.hpp>
@@ -370,6 +374,185 @@ uint64_t accumulate_on_active_memtables(replica::table& t, noncopyable_function<
     return ret;
 }
 
+// The last row received by the client of an interrupted export, which
+// resumes right after it.
+struct export_cursor {
+    dht::decorated_key pk;
+    // Unset if the last row received was the static row.
+    std::optional<clustering_key> ck;
+};
+
+template <typename Key>
+static std::optional<Key> parse_export_key(const http::request& req, const schema& s, const char* name) {
+    auto value = req.get_query_param(name);
+    if (value.empty()) {
+        return std::nullopt;
+    }
+    try {
+        auto key = Key::from_bytes(from_hex(value));
+        Key::get_compound_type(s)->validate(key.representation());
+        return key;
+    } catch (...) {
+        throw bad_param_exception(fmt::format("Invalid {}: {}", name, value));
+    }
+}
+
+// The range to export and, when resuming an export, the cursor to resume it
+// from. The cursor is given by the raw keys of the last row received, as
+// written to the output, and takes the place of start_token.
+static std::pair<dht::partition_range, std::optional<export_cursor>> parse_export_params(const http::request& req, const schema& s) {
+    auto parse_bound = [&] (const char* name, bool inclusive) -> std::optional<dht::token_range::bound> {
+        auto value = req.get_query_param(name);
+        if (value.empty()) {
+            return std::nullopt;
+        }
+        try {
+            return dht::token_range::bound(dht::token::from_sstring(value), inclusive);
+        } catch (...) {
+            throw bad_param_exception(fmt::format("Invalid {}: {}", name, value));
+        }
+    };
+    auto start = parse_bound("start_token", false);
+    auto end = parse_bound("end_token", true);
+    auto after_pk = parse_export_key<partition_key>(req, s, "after_partition_key");
+    auto after_ck = parse_export_key<clustering_key>(req, s, "after_clustering_key");
+    if (after_ck && !after_pk) {
+        throw bad_param_exception("after_clustering_key requires after_partition_key");
+    }
+    if (after_pk && start) {
+        throw bad_param_exception("after_partition_key and start_token are mutually exclusive");
+    }
+    if (after_ck && !after_ck->is_full(s)) {
+        throw bad_param_exception(fmt::format("Invalid after_clustering_key: {}", req.get_query_param("after_clustering_key")));
+    }
+    if (!after_pk) {
+        if (start && end && start->value() >= end->value()) {
+            throw bad_param_exception(fmt::format("start_token {} must be less than end_token {}", start->value(), end->value()));
+        }
+        return {dht::to_partition_range(dht::token_range(std::move(start), std::move(end))), std::nullopt};
+    }
+    auto cursor = export_cursor{dht::decorate_key(s, std::move(*after_pk)), std::move(after_ck)};
+    if (end && cursor.pk.token() > end->value()) {
+        throw bad_param_exception(fmt::format("The token {} of after_partition_key must not be greater than end_token {}", cursor.pk.token(), end->value()));
+    }
+    // The rest of the cursor's partition is read again, its rows up to the
+    // cursor are skipped by export_table().
+    auto range = dht::to_partition_range(dht::token_range(std::nullopt, std::move(end)));
+    range = dht::partition_range(dht::partition_range::bound(dht::ring_position(cursor.pk), true), range.end());
+    return {std::move(range), std::move(cursor)};
+}
+
+// Writes the live cells of the row, along with the keys identifying it, as a
+// single line of JSON.
+static sstring export_row_to_json(const schema& s, const dht::decorated_key& dk, const clustering_key* ck, const row& cells,
+        column_kind kind, gc_clock::time_point now) {
+    std::stringstream ss;
+    mutation_json::mutation_partition_json_writer writer(s, ss);
+    auto& w = writer.writer();
+    w.StartObject();
+    w.Key("partition_key");
+    w.DataKey(s, dk);
+    if (ck) {
+        w.Key("clustering_key");
+        w.DataKey(s, *ck);
+    }
+    w.Key("columns");
+    w.StartObject();
+    cells.for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+        auto& cdef = s.column_at(kind, id);
+        if (cdef.is_atomic()) {
+            auto ac = cell.as_atomic_cell(cdef);
+            if (!ac.is_live(tombstone(), now, cdef.is_counter())) {
+                return;
+            }
+            w.Key(cdef.name_as_text());
+            writer.write_atomic_cell_value(ac, cdef.type);
+        } else {
+            cell.as_collection_mutation().with_deserialized(*cdef.type, [&] (collection_mutation_view_description mv) {
+                collection_mutation_view_description live;
+                for (const auto& c : mv.cells) {
+                    if (c.second.is_live(tombstone(), now, false)) {
+                        live.cells.push_back(c);
+                    }
+                }
+                if (live.cells.empty()) {
+                    return;
+                }
+                w.Key(cdef.name_as_text());
+                writer.write_collection_value(live, cdef.type);
+            });
+        }
+    });
+    w.EndObject();
+    w.EndObject();
+    ss << '\n';
+    return std::move(ss).str();
+}
+
+// Streams the live rows of the table in the given range to `out`.
+//
+// The rows are read from all shards of this node in token order, by a
+// multishard streaming reader whose shard readers are evictable, so an export
+// that is slow to consume doesn't pin resources on the shards. The reads go
+// through the streaming semaphore when called in the streaming scheduling
+// group. Writing to `out` provides the back-pressure: the reader is only
+// pulled as fast as the client consumes the response.
+//
+// The reader is compacted, so that the data shadowed by partition, range and
+// row tombstones is dropped, whether or not the streaming reader already
+// compacts it (see enable_compacting_data_for_streaming_and_repair).
+//
+// When resuming from a cursor, the range starts with the cursor's partition,
+// whose rows up to and including the cursor's row are skipped.
+static future<> export_table(sharded<replica::database>& db, table_id id, dht::partition_range range, std::optional<export_cursor> cursor,
+        output_stream<char>& out) {
+    auto& t = db.local().find_column_family(id);
+    auto s = t.schema();
+    auto permit = co_await db.local().obtain_reader_permit(t, "export", db::no_timeout, {});
+    const auto now = gc_clock::now();
+    // Purging doesn't matter, as tombstones are not exported.
+    auto reader = make_compacting_reader(make_multishard_streaming_reader(db, s, std::move(permit), range, now, {}, read_ahead::yes),
+            now, can_never_purge, t.get_compaction_manager().get_tombstone_gc_state());
+    std::exception_ptr ex;
+    try {
+        std::optional<dht::decorated_key> dk;
+        // Whether the current partition is the one of the cursor.
+        bool resuming = false;
+        const auto ck_cmp = clustering_key::tri_compare(*s);
+        while (auto mf = co_await reader()) {
+            switch (mf->mutation_fragment_kind()) {
+                case mutation_fragment_v2::kind::partition_start:
+                    dk = mf->as_partition_start().key();
+                    resuming = cursor && dk->equal(*s, cursor->pk);
+                    break;
+                case mutation_fragment_v2::kind::static_row:
+                    // The static row comes first, so it was received before the cursor.
+                    if (!resuming && mf->as_static_row().is_live(*s, now)) {
+                        co_await out.write(export_row_to_json(*s, *dk, nullptr, mf->as_static_row().cells(), column_kind::static_column, now));
+                    }
+                    break;
+                case mutation_fragment_v2::kind::clustering_row:
+                    if (resuming && cursor->ck && ck_cmp(mf->as_clustering_row().key(), *cursor->ck) <= 0) {
+                        break;
+                    }
+                    if (mf->as_clustering_row().is_live(*s, tombstone(), now)) {
+                        co_await out.write(export_row_to_json(*s, *dk, &mf->as_clustering_row().key(), mf->as_clustering_row().cells(), column_kind::regular_column, now));
+                    }
+                    break;
+                case mutation_fragment_v2::kind::range_tombstone_change:
+                case mutation_fragment_v2::kind::partition_end:
+                    break;
+            }
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+}
+
 void set_column_family(http_context& ctx, routes& r, sharded<db::system_keyspace>& sys_ks) {
     cf::get_column_family_name.set(r, [&ctx] (const_req req){
         std::vector<sstring> res;
@@ -1103,6 +1286,30 @@ void set_column_family(http_context& ctx, routes& r, sharded<db::system_keyspace
     });
 
 
+    cf::export_table.set(r, [&ctx] (std::unique_ptr<http::request> req) {
+        auto id = get_uuid(req->get_path_param("name"), ctx.db.local());
+        auto [range, cursor] = parse_export_params(*req, *ctx.db.local().find_schema(id));
+        apilog.info("export_table: name={} range={}", req->get_path_param("name"), range);
+
+        std::function<future<>(output_stream<char>&&)> f = [&db = ctx.db, id, range = std::move(range), cursor = std::move(cursor)] (output_stream<char>&& o) -> future<> {
+            auto out = std::move(o);
+            std::exception_ptr ex;
+            try {
+                co_await with_scheduling_group(db.local().get_streaming_scheduling_group(), [&] {
+                    return export_table(db, id, range, cursor, out);
+                });
+                co_await out.flush();
+            } catch (...) {
+                ex = std::current_exception();
+            }
+            co_await out.close();
+            if (ex) {
+                co_await coroutine::return_exception_ptr(std::move(ex));
+            }
+        };
+        return make_ready_future<json::json_return_type>(std::move(f));
+    });
+
     cf::toppartitions.set(r, [&ctx] (std::unique_ptr<http::request> req) {
         auto name = req->get_path_param("name");
         auto [ks, cf] = parse_fully_qualified_cf_name(name);
@@ -1261,6 +1468,7 @@ void unset_column_family(http_context& ctx, routes& r) {
     cf::set_crc_check_chance.unset(r);
     cf::get_sstable_count_per_level.unset(r);
     cf::get_sstables_for_key.unset(r);
+    cf::export_table.unset(r);
     cf::toppartitions.unset(r);
     cf::force_major_compaction.unset(r);
 }
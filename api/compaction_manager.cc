@@ -94,6 +94,37 @@ void set_compaction_manager(http_context& ctx, routes& r, sharded<compaction_man
         });
     });
 
+    cm::get_read_amplification_scores.set(r, [&ctx] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        using scores_map = std::unordered_map<std::pair<sstring, sstring>, double, utils::tuple_hash>;
+        auto scores = co_await ctx.db.map_reduce0([] (replica::database& db) -> future<scores_map> {
+            scores_map scores;
+            auto& cm = db.get_compaction_manager();
+            co_await db.get_tables_metadata().for_each_table_gently([&] (table_id, lw_shared_ptr<replica::table> table) -> future<> {
+                auto& score = scores[std::make_pair(table->schema()->ks_name(), table->schema()->cf_name())];
+                co_await table->parallel_foreach_table_state([&] (compaction::table_state& ts) {
+                    score += cm.read_amplification_score(ts);
+                    return make_ready_future<>();
+                });
+            });
+            co_return scores;
+        }, scores_map(), [] (scores_map a, const scores_map& b) {
+            for (auto& [table, score] : b) {
+                a[table] += score;
+            }
+            return a;
+        });
+        std::vector<cm::read_amplification_score> res;
+        res.reserve(scores.size());
+        for (auto& [table, score] : scores) {
+            cm::read_amplification_score s;
+            s.ks = table.first;
+            s.cf = table.second;
+            s.score = score;
+            res.push_back(std::move(s));
+        }
+        co_return res;
+    });
+
     cm::force_user_defined_compaction.set(r, [] (std::unique_ptr<http::request> req) {
         //TBD
         // FIXME
@@ -209,6 +240,7 @@ void set_compaction_manager(http_context& ctx, routes& r, sharded<compaction_man
 void unset_compaction_manager(http_context& ctx, routes& r) {
     cm::get_compactions.unset(r);
     cm::get_pending_tasks_by_table.unset(r);
+    cm::get_read_amplification_scores.unset(r);
     cm::force_user_defined_compaction.unset(r);
     cm::stop_compaction.unset(r);
     cm::stop_keyspace_compaction.unset(r);
@@ -13,8 +13,50 @@
 #include <seastar/core/file.hh>
 #include <chrono>
 #include <cmath>
+#include <optional>
 
 #include "seastarx.hh"
+#include "utils/updateable_value.hh"
+
+namespace seastar::metrics {
+class metric_groups;
+}
+
+struct pid_gains {
+    float kp;
+    float ki;
+    float kd;
+};
+
+// Proportional-integral-derivative feedback controller.
+//
+// Drives an output in [0, 1] so that a measurement settles at a target. The proportional term
+// reacts to the current error, the integral term accumulates the error over time and holds the
+// output that keeps the measurement at the target once it is reached, and the derivative term
+// damps the reaction to fast changes of the measurement.
+//
+// The integral term is clamped to the output range and stops accumulating while the output is
+// saturated in the direction of the error (anti-windup), so that a long period at either bound
+// doesn't cause a large overshoot when the measurement comes back.
+class pid_controller {
+    std::optional<float> _last_measurement;
+    float _error = 0;
+    float _proportional = 0;
+    float _integral = 0;
+    float _derivative = 0;
+    float _output = 0;
+public:
+    // Computes the output for a measurement taken dt seconds after the previous one.
+    // Measurement and target are expected to be normalized to about [0, 1].
+    float update(float measurement, float target, float dt, const pid_gains& gains) noexcept;
+    void reset() noexcept;
+
+    float error() const noexcept { return _error; }
+    float proportional() const noexcept { return _proportional; }
+    float integral() const noexcept { return _integral; }
+    float derivative() const noexcept { return _derivative; }
+    float output() const noexcept { return _output; }
+};
 
 // Simple proportional controller to adjust shares for processes for which a backlog can be clearly
 // defined.
@@ -35,10 +77,23 @@
 // region, and aggressively in the third region.
 //
 // The constants q1 and q2 are used to determine the proportional factor at each stage.
+//
+// Alternatively, when a target backlog is configured, the controller ignores the control points
+// in between and sets the shares with a pid_controller that keeps the backlog at the target,
+// between the output of the first and last control points. The backlog is normalized by the input
+// of the last control point.
 class backlog_controller {
 public:
     using scheduling_group = seastar::scheduling_group;
 
+    struct feedback_config {
+        // The feedback mode is used while the target is higher than 0.
+        utils::updateable_value<float> target_backlog = utils::updateable_value<float>(0);
+        utils::updateable_value<float> kp = utils::updateable_value<float>(1.0);
+        utils::updateable_value<float> ki = utils::updateable_value<float>(0.1);
+        utils::updateable_value<float> kd = utils::updateable_value<float>(0.05);
+    };
+
     future<> shutdown() {
         _update_timer.cancel();
         return std::move(_inflight_update);
@@ -60,6 +115,10 @@ class backlog_controller {
     std::vector<control_point> _control_points;
 
     std::function<float()> _current_backlog;
+    feedback_config _feedback;
+    pid_controller _pid;
+    std::chrono::duration<float> _interval;
+    float _shares = 0;
     timer<> _update_timer;
     // updating shares for an I/O class may contact another shard and returns a future.
     future<> _inflight_update;
@@ -75,13 +134,16 @@ class backlog_controller {
     }
 
     void adjust();
+    float adjust_with_feedback(float backlog, float target);
 
     backlog_controller(scheduling_group sg, std::chrono::milliseconds interval,
                        std::vector<control_point> control_points, std::function<float()> backlog,
-                       float static_shares = 0)
+                       float static_shares = 0, feedback_config feedback = {})
         : _scheduling_group(std::move(sg))
         , _control_points()
         , _current_backlog(std::move(backlog))
+        , _feedback(std::move(feedback))
+        , _interval(interval)
         , _update_timer([this] { adjust(); })
         , _inflight_update(make_ready_future<>())
         , _static_shares(static_shares)
@@ -94,6 +156,14 @@ class backlog_controller {
 public:
     backlog_controller(backlog_controller&&) = default;
     float backlog_of_shares(float shares) const;
+
+    const pid_controller& feedback_state() const noexcept {
+        return _pid;
+    }
+
+    // Registers gauges for the shares set by the controller and for the state of its
+    // pid_controller, in the given metrics group.
+    void register_metrics(seastar::metrics::metric_groups& metrics, const sstring& group);
 };
 
 // memtable flush CPU controller.
@@ -114,11 +184,13 @@ class backlog_controller {
 class flush_controller : public backlog_controller {
     static constexpr float hard_dirty_limit = 1.0f;
 public:
-    flush_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, float soft_limit, std::function<float()> current_dirty)
+    flush_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, float soft_limit, std::function<float()> current_dirty,
+                     feedback_config feedback = {})
         : backlog_controller(std::move(sg), std::move(interval),
           std::vector<backlog_controller::control_point>({{0.0, 0.0}, {soft_limit, 10}, {soft_limit + (hard_dirty_limit - soft_limit) / 2, 200} , {hard_dirty_limit, 1000}}),
           std::move(current_dirty),
-          static_shares
+          static_shares,
+          std::move(feedback)
         )
     {}
 };
@@ -128,11 +200,13 @@ class compaction_controller : public backlog_controller {
     static constexpr unsigned normalization_factor = 30;
     static constexpr float disable_backlog = std::numeric_limits<double>::infinity();
     static constexpr float backlog_disabled(float backlog) { return std::isinf(backlog); }
-    compaction_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, std::function<float()> current_backlog)
+    compaction_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, std::function<float()> current_backlog,
+                          feedback_config feedback = {})
         : backlog_controller(std::move(sg), std::move(interval),
           std::vector<backlog_controller::control_point>({{0.0, 50}, {1.5, 100} , {normalization_factor, 1000}}),
           std::move(current_backlog),
-          static_shares
+          static_shares,
+          std::move(feedback)
         )
     {}
 };
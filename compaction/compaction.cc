@@ -32,6 +32,7 @@
 #include "sstables/exceptions.hh"
 #include "sstables/sstables.hh"
 #include "sstables/sstable_writer.hh"
+#include "sstables/index_reader.hh"
 #include "sstables/progress_monitor.hh"
 #include "sstables/sstables_manager.hh"
 #include "compaction.hh"
@@ -50,6 +51,7 @@
 #include "utils/pretty_printers.hh"
 #include "readers/multi_range.hh"
 #include "readers/compacting.hh"
+#include "readers/pipelined.hh"
 #include "tombstone_gc.hh"
 #include "replica/database.hh"
 #include "timestamp.hh"
@@ -303,6 +305,129 @@ struct compaction_writer {
         : compaction_writer(nullptr, std::move(writer), std::move(sst)) {}
 };
 
+class compacted_fragments_writer;
+
+// Copies the partitions of an input sstable which are not present in any other
+// input sstable straight into the compaction output, without decoding them into
+// mutation fragments and encoding them again.
+//
+// The source sstable has neither tombstones nor expiring cells, so a partition
+// which is present only in it has nothing to be merged or purged. As bloom
+// filters have no false negatives, a partition which none of the filters of the
+// other inputs may contain is known to be present only in the source.
+class raw_partition_copier {
+    const schema& _schema;
+    shared_sstable _source;
+    std::vector<shared_sstable> _others;
+    reader_permit _permit;
+    index_reader _index;
+    std::optional<input_stream<char>> _data;
+    uint64_t _data_position = 0;
+    // Larger partitions would get a promoted index when rewritten, and the
+    // promoted index of the source is not copied. It is also bounded by the
+    // large data thresholds, see setup_raw_partition_copier().
+    const uint64_t _max_partition_size;
+    std::optional<bool> _compatible_with_output;
+    compacted_fragments_writer* _writer = nullptr;
+    uint64_t _copied_partitions = 0;
+    uint64_t _copied_bytes = 0;
+public:
+    raw_partition_copier(const schema& s, shared_sstable source, std::vector<shared_sstable> others, reader_permit permit, uint64_t max_partition_size)
+        : _schema(s)
+        , _source(std::move(source))
+        , _others(std::move(others))
+        , _permit(std::move(permit))
+        , _index(_source, _permit, tracing::trace_state_ptr(), use_caching::no)
+        , _max_partition_size(max_partition_size)
+    { }
+
+    void set_writer(compacted_fragments_writer& writer) noexcept {
+        _writer = &writer;
+    }
+
+    // Copies the partition if possible, and returns true if it did.
+    // Must be called in a seastar thread, in partition order, and only between
+    // the partitions written by the compacted_fragments_writer.
+    bool try_copy(const dht::decorated_key& dk);
+
+    uint64_t copied_partitions() const noexcept {
+        return _copied_partitions;
+    }
+
+    uint64_t copied_bytes() const noexcept {
+        return _copied_bytes;
+    }
+
+    future<> close() noexcept;
+};
+
+// Skips the partitions copied by the raw_partition_copier, so that they don't
+// reach the compactor.
+struct raw_partition_copy_filter {
+    raw_partition_copier& copier;
+
+    bool operator()(const dht::decorated_key& dk) {
+        return !copier.try_copy(dk);
+    }
+
+    bool operator()(const mutation_fragment_v2&) const {
+        return true;
+    }
+
+    void on_end_of_stream() const { }
+};
+
+// Estimates the size of the output partitions, to isolate the large ones in
+// dedicated sstables. A partition is estimated by the sum of its sizes in the
+// inputs, according to their partition index. Only inputs whose large data stats
+// show a partition above the threshold are looked up.
+class large_partition_detector {
+    const schema& _schema;
+    const uint64_t _threshold;
+    std::vector<std::unique_ptr<index_reader>> _indexes;
+public:
+    large_partition_detector(const schema& s, uint64_t threshold, const sstable_set& inputs, reader_permit permit)
+        : _schema(s)
+        , _threshold(threshold)
+    {
+        for (auto& sst : *inputs.all()) {
+            auto stat = sst->get_large_data_stat(large_data_type::partition_size);
+            if (stat && stat->max_value >= _threshold) {
+                _indexes.push_back(std::make_unique<index_reader>(sst, permit, tracing::trace_state_ptr(), use_caching::no));
+            }
+        }
+    }
+
+    bool empty() const noexcept {
+        return _indexes.empty();
+    }
+
+    // Must be called in a seastar thread, in partition order.
+    bool is_large(const dht::decorated_key& dk) {
+        uint64_t size = 0;
+        for (auto& index : _indexes) {
+            auto& sst = index->sstable();
+            if (index->eof() || dk.tri_compare(_schema, sst->get_first_decorated_key()) < 0
+                    || dk.tri_compare(_schema, sst->get_last_decorated_key()) > 0) {
+                continue;
+            }
+            if (!index->advance_lower_and_check_if_present(dk).get()) {
+                continue;
+            }
+            auto start = index->get_data_file_position();
+            index->advance_to_next_partition().get();
+            size += index->data_file_positions().start - start;
+        }
+        return size >= _threshold;
+    }
+
+    future<> close() noexcept {
+        for (auto& index : _indexes) {
+            co_await index->close();
+        }
+    }
+};
+
 class compacted_fragments_writer {
     compaction& _c;
     std::optional<compaction_writer> _compaction_writer = {};
@@ -311,7 +436,13 @@ class compacted_fragments_writer {
     creator_func_t _create_compaction_writer;
     stop_func_t _stop_compaction_writer;
     std::optional<utils::observer<>> _stop_request_observer;
+    raw_partition_copier* _raw_copier = nullptr;
+    large_partition_detector* _large_partition_detector = nullptr;
     bool _unclosed_partition = false;
+    // Set while a large partition is written to a dedicated sstable.
+    bool _isolating_partition = false;
+    // Set once the current writer was given a partition.
+    bool _writer_has_partitions = false;
     struct partition_state {
         dht::decorated_key_opt dk;
         // Partition tombstone is saved for the purpose of replicating it to every fragment storing a partition pL.
@@ -341,10 +472,16 @@ class compacted_fragments_writer {
     void do_consume_new_partition(const dht::decorated_key& dk);
     stop_iteration do_consume_end_of_partition();
 public:
-    explicit compacted_fragments_writer(compaction& c, creator_func_t cpw, stop_func_t scw)
+    explicit compacted_fragments_writer(compaction& c, creator_func_t cpw, stop_func_t scw, raw_partition_copier* raw_copier = nullptr,
+            large_partition_detector* large_partition_detector = nullptr)
             : _c(c)
             , _create_compaction_writer(std::move(cpw))
-            , _stop_compaction_writer(std::move(scw)) {
+            , _stop_compaction_writer(std::move(scw))
+            , _raw_copier(raw_copier)
+            , _large_partition_detector(large_partition_detector) {
+        if (_raw_copier) {
+            _raw_copier->set_writer(*this);
+        }
     }
     explicit compacted_fragments_writer(compaction& c, creator_func_t cpw, stop_func_t scw, utils::observable<>& sro)
             : _c(c)
@@ -374,6 +511,11 @@ class compacted_fragments_writer {
 
     stop_iteration consume_end_of_partition();
     void consume_end_of_stream();
+
+    // Like sstable_writer::can_copy_raw_partitions_from(), for the writer which
+    // the partition dk would be written to.
+    bool can_copy_raw_partitions_from(const dht::decorated_key& dk, const sstable& source);
+    void consume_raw_partition(const dht::decorated_key& dk, const sstable& source, temporary_buffer<char> data);
 };
 
 using use_backlog_tracker = bool_class<class use_backlog_tracker_tag>;
@@ -504,9 +646,13 @@ class compaction {
     db::replay_position _rp;
     encoding_stats_collector _stats_collector;
     const bool _can_split_large_partition = false;
+    const uint64_t _isolate_partitions_above;
     bool _contains_multi_fragment_runs = false;
     mutation_source_metadata _ms_metadata = {};
     const compaction_sstable_replacer_fn _replacer;
+    const compaction_checkpoint_fn _checkpointer;
+    // Range of the input which is compacted, restricted when resuming from a checkpoint.
+    const dht::partition_range _input_range;
     const run_id _run_identifier;
     // optional clone of sstable set to be used for expiration purposes, so it will be set if expiration is enabled.
     std::optional<sstable_set> _sstable_set;
@@ -525,6 +671,12 @@ class compaction {
     utils::observable<> _stop_request_observable;
     // optional tombstone_gc_state that is used when gc has to check only the compacting sstables to collect tombstones.
     std::optional<tombstone_gc_state> _tombstone_gc_state_with_commitlog_check_disabled;
+    // Set if the partitions of one of the input sstables can be copied to the output without rewriting them.
+    std::unique_ptr<raw_partition_copier> _raw_copier;
+    // The output is encoded against the minimal timestamp of the raw copy source, see setup_raw_partition_copier().
+    std::optional<api::timestamp_type> _raw_copy_min_timestamp;
+    // Set if partitions estimated above _isolate_partitions_above are written to dedicated sstables.
+    std::unique_ptr<large_partition_detector> _large_partition_detector;
 private:
     // Keeps track of monitors for input sstable.
     // If _update_backlog_tracker is set to true, monitors are responsible for adjusting backlog as compaction progresses.
@@ -565,7 +717,12 @@ class compaction {
         , _max_sstable_size(descriptor.max_sstable_bytes)
         , _sstable_level(descriptor.level)
         , _can_split_large_partition(descriptor.can_split_large_partition)
+        , _isolate_partitions_above(descriptor.isolate_partitions_above)
         , _replacer(std::move(descriptor.replacer))
+        , _checkpointer(std::move(descriptor.checkpointer))
+        , _input_range(descriptor.resume_after
+                ? dht::partition_range::make_starting_with(dht::partition_range::bound(dht::ring_position(*descriptor.resume_after), false))
+                : dht::partition_range::make_open_ended_both_sides())
         , _run_identifier(descriptor.run_identifier)
         , _sstable_set(std::move(descriptor.all_sstables_snapshot))
         , _selector(_sstable_set ? _sstable_set->make_incremental_selector() : std::optional<sstable_set::incremental_selector>{})
@@ -636,7 +793,11 @@ class compaction {
     }
 
     encoding_stats get_encoding_stats() const {
-        return _stats_collector.get();
+        auto stats = _stats_collector.get();
+        if (_raw_copy_min_timestamp) {
+            stats.min_timestamp = *_raw_copy_min_timestamp;
+        }
+        return stats;
     }
 
     compaction_completion_desc
@@ -703,7 +864,13 @@ class compaction {
     }
 
     virtual bool enable_garbage_collected_sstable_writer() const noexcept {
-        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max() && bool(_replacer);
+        return (_contains_multi_fragment_runs || bool(_checkpointer)) && _max_sstable_size != std::numeric_limits<uint64_t>::max() && bool(_replacer);
+    }
+
+    // Checkpoints are only consistent if the outputs are sealed in key order,
+    // with no partition spanning two of them.
+    bool checkpointing_enabled() const {
+        return bool(_checkpointer) && enable_garbage_collected_sstable_writer() && !use_interposer_consumer() && !_can_split_large_partition;
     }
 public:
     compaction& operator=(const compaction&) = delete;
@@ -729,7 +896,7 @@ class compaction {
         if (!_owned_ranges_checker) {
             return make_sstable_reader(_schema,
                                        _permit,
-                                       query::full_partition_range,
+                                       _input_range,
                                        _schema->full_slice(),
                                        tracing::trace_state_ptr(),
                                        ::streamed_mutation::forwarding::no,
@@ -754,12 +921,15 @@ class compaction {
         });
 
         auto owned_range_generator = [this] () -> std::optional<dht::partition_range> {
-            auto r = _owned_ranges_checker->next_owned_range();
-            if (r == nullptr) {
-                return std::nullopt;
+            while (auto r = _owned_ranges_checker->next_owned_range()) {
+                auto pr = dht::to_partition_range(*r).intersection(_input_range, dht::ring_position_comparator(*_schema));
+                if (!pr) {
+                    continue;
+                }
+                log_trace("Skipping to the next owned range {}", *pr);
+                return pr;
             }
-            log_trace("Skipping to the next owned range {}", *r);
-            return dht::to_partition_range(*r);
+            return std::nullopt;
         };
 
         return make_flat_multi_range_reader(_schema, _permit, std::move(source),
@@ -828,6 +998,76 @@ class compaction {
 
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
+
+        setup_raw_partition_copier();
+        setup_large_partition_detector();
+    }
+
+    // The output partitions are estimated from the partition index of the inputs, which
+    // requires them to be written in partition order, by a single writer.
+    void setup_large_partition_detector() {
+        if (_isolate_partitions_above == std::numeric_limits<uint64_t>::max() || use_interposer_consumer()) {
+            return;
+        }
+        auto detector = std::make_unique<large_partition_detector>(*_schema, _isolate_partitions_above, *_compacting, _permit);
+        if (detector->empty()) {
+            return;
+        }
+        log_debug("Partitions larger than {} will be written to dedicated sstables", utils::pretty_printed_data_size(_isolate_partitions_above));
+        _large_partition_detector = std::move(detector);
+    }
+
+    // Regular compaction of non-counter tables, whose output is not segregated,
+    // copies the partitions of the largest input sstable without tombstones and
+    // expiring cells which aren't present in other inputs, see raw_partition_copier.
+    void setup_raw_partition_copier() {
+        if (_type != compaction_type::Compaction || use_interposer_consumer() || _schema->is_counter() || _compacting->size() < 2) {
+            return;
+        }
+        shared_sstable source;
+        for (auto& sst : *_compacting->all()) {
+            // Live cells and row markers are recorded with the maximal local deletion
+            // time, so only the minimum tells whether there are tombstones or expiring cells.
+            if (!sst->has_correct_max_deletion_time() || sst->get_stats_metadata().min_local_deletion_time != std::numeric_limits<int32_t>::max()) {
+                continue;
+            }
+            if (!source || sst->data_size() > source->data_size()) {
+                source = sst;
+            }
+        }
+        if (!source) {
+            return;
+        }
+        // The copied partitions have to be encoded against the same minimal timestamp
+        // as in the source. Using it for the output is only worthwhile if it doesn't
+        // exceed the timestamps of the other inputs, as they would otherwise be
+        // encoded with negative deltas, which take the most space.
+        auto min_timestamp = source->get_serialization_header().get_min_timestamp();
+        if (min_timestamp > _stats_collector.get().min_timestamp) {
+            log_debug("Not copying partitions of {} as is, since it doesn't hold the oldest timestamp of the inputs", source->get_filename());
+            return;
+        }
+        std::vector<shared_sstable> others;
+        for (auto& sst : *_compacting->all()) {
+            if (sst != source) {
+                others.push_back(sst);
+            }
+        }
+        // Copied partitions are not parsed, so the large data handler can't check
+        // their rows and cells. They are limited to the size below which they can't
+        // exceed any of its thresholds, as every row and collection element takes
+        // at least a byte.
+        auto& large_data_handler = source->get_large_data_handler();
+        uint64_t max_partition_size = std::min({
+                uint64_t(make_sstable_writer_config(_type).promoted_index_block_size),
+                large_data_handler.get_partition_threshold_bytes(),
+                large_data_handler.get_row_threshold_bytes(),
+                large_data_handler.get_cell_threshold_bytes(),
+                large_data_handler.get_rows_count_threshold(),
+                large_data_handler.get_collection_elements_count_threshold()});
+        log_debug("Partitions present only in {} will be copied as is", source->get_filename());
+        _raw_copy_min_timestamp = min_timestamp;
+        _raw_copier = std::make_unique<raw_partition_copier>(*_schema, std::move(source), std::move(others), _permit, max_partition_size);
     }
 
     // This consumer will perform mutation compaction on producer side using
@@ -842,7 +1082,18 @@ class compaction {
             });
         });
         const auto& gc_state = get_tombstone_gc_state();
-        return consumer(make_compacting_reader(setup_sstable_reader(), compaction_time, max_purgeable_func(), gc_state));
+        return consumer(maybe_pipeline(make_compacting_reader(setup_sstable_reader(), compaction_time, max_purgeable_func(), gc_state)));
+    }
+
+    // Produces the input in a background fiber, up to compaction_data::pipeline_depth buffers
+    // ahead of the output writers, so that reading, decompressing and merging the next partitions
+    // overlaps with serializing, compressing and writing the previous ones.
+    // Partitions copied as is are skipped by the input reader, reading them ahead would defeat that.
+    mutation_reader maybe_pipeline(mutation_reader reader) const {
+        if (!_cdata.pipeline_depth || _raw_copier) {
+            return reader;
+        }
+        return make_pipelined_reader(std::move(reader), _cdata.pipeline_depth);
     }
 
     future<> consume() {
@@ -857,28 +1108,37 @@ class compaction {
         {
             return seastar::async([this, reader = std::move(reader), now] () mutable {
                 auto close_reader = deferred_close(reader);
+                std::optional<deferred_close<large_partition_detector>> close_large_partition_detector;
+                if (_large_partition_detector) {
+                    close_large_partition_detector.emplace(*_large_partition_detector);
+                }
+                auto consume_compacted = [this, &reader] (auto cfc) {
+                    if (!_raw_copier) {
+                        reader.consume_in_thread(std::move(cfc));
+                        return;
+                    }
+                    auto close_raw_copier = deferred_close(*_raw_copier);
+                    reader.consume_in_thread(std::move(cfc), raw_partition_copy_filter{*_raw_copier});
+                };
 
                 if (enable_garbage_collected_sstable_writer()) {
                     using compact_mutations = compact_for_compaction_v2<compacted_fragments_writer, compacted_fragments_writer>;
-                    auto cfc = compact_mutations(*schema(), now,
+                    consume_compacted(compact_mutations(*schema(), now,
                         max_purgeable_func(),
                         get_tombstone_gc_state(),
                         get_compacted_fragments_writer(),
-                        get_gc_compacted_fragments_writer());
-
-                    reader.consume_in_thread(std::move(cfc));
+                        get_gc_compacted_fragments_writer()));
                     return;
                 }
                 using compact_mutations = compact_for_compaction_v2<compacted_fragments_writer, noop_compacted_fragments_consumer>;
-                auto cfc = compact_mutations(*schema(), now,
+                consume_compacted(compact_mutations(*schema(), now,
                     max_purgeable_func(),
                     get_tombstone_gc_state(),
                     get_compacted_fragments_writer(),
-                    noop_compacted_fragments_consumer());
-                reader.consume_in_thread(std::move(cfc));
+                    noop_compacted_fragments_consumer()));
             });
         });
-        return consumer(setup_sstable_reader());
+        return consumer(maybe_pipeline(setup_sstable_reader()));
     }
 
     // based on the specified policies, the `compaction` base class designates
@@ -913,6 +1173,7 @@ class compaction {
                 .start_size = _start_size,
                 .end_size = _end_size,
                 .bloom_filter_checks = _bloom_filter_checks,
+                .raw_copied_partitions = _raw_copier ? _raw_copier->copied_partitions() : 0,
                 .reader_statistics = std::move(_reader_statistics),
             },
         };
@@ -923,6 +1184,10 @@ class compaction {
 
         on_end_of_compaction();
 
+        if (_raw_copier) {
+            log_debug("Copied {} partitions ({}) as is", _raw_copier->copied_partitions(), utils::pretty_printed_data_size(_raw_copier->copied_bytes()));
+        }
+
         // FIXME: there is some missing information in the log message below.
         // look at CompactionTask::runMayThrow() in origin for reference.
         // - add support to merge summary (message: Partition merge counts were {%s}.).
@@ -967,7 +1232,9 @@ class compaction {
     compacted_fragments_writer get_compacted_fragments_writer() {
         return compacted_fragments_writer(*this,
             [this] (const dht::decorated_key& dk) { return create_compaction_writer(dk); },
-            [this] (compaction_writer* cw) { stop_sstable_writer(cw); });
+            [this] (compaction_writer* cw) { stop_sstable_writer(cw); },
+            _raw_copier.get(),
+            _large_partition_detector.get());
     }
 
     const schema_ptr& schema() const {
@@ -1026,10 +1293,15 @@ compacted_fragments_writer::compacted_fragments_writer(compacted_fragments_write
         : _c(other._c)
         , _compaction_writer(std::move(other._compaction_writer))
         , _create_compaction_writer(std::move(other._create_compaction_writer))
-        , _stop_compaction_writer(std::move(other._stop_compaction_writer)) {
+        , _stop_compaction_writer(std::move(other._stop_compaction_writer))
+        , _raw_copier(std::exchange(other._raw_copier, nullptr))
+        , _large_partition_detector(std::exchange(other._large_partition_detector, nullptr)) {
     if (std::exchange(other._stop_request_observer, std::nullopt)) {
         _stop_request_observer = make_stop_request_observer(_c._stop_request_observable);
     }
+    if (_raw_copier) {
+        _raw_copier->set_writer(*this);
+    }
 }
 
 void compacted_fragments_writer::maybe_abort_compaction() {
@@ -1043,6 +1315,7 @@ void compacted_fragments_writer::stop_current_writer() {
     // stop sstable writer being currently used.
     _stop_compaction_writer(&*_compaction_writer);
     _compaction_writer = std::nullopt;
+    _writer_has_partitions = false;
 }
 
 bool compacted_fragments_writer::can_split_large_partition() const {
@@ -1092,6 +1365,7 @@ void compacted_fragments_writer::do_consume_new_partition(const dht::decorated_k
     _c.on_new_partition();
     _compaction_writer->writer.consume_new_partition(dk);
     _unclosed_partition = true;
+    _writer_has_partitions = true;
 }
 
 stop_iteration compacted_fragments_writer::do_consume_end_of_partition() {
@@ -1100,6 +1374,13 @@ stop_iteration compacted_fragments_writer::do_consume_end_of_partition() {
 }
 
 void compacted_fragments_writer::consume_new_partition(const dht::decorated_key& dk) {
+    if (_large_partition_detector && _large_partition_detector->is_large(dk)) [[unlikely]] {
+        _c.log_debug("Writing large partition {} to a dedicated sstable", dk);
+        if (_writer_has_partitions) {
+            stop_current_writer();
+        }
+        _isolating_partition = true;
+    }
     _current_partition = {
         .dk = dk,
         .tombstone = tombstone(),
@@ -1138,7 +1419,7 @@ stop_iteration compacted_fragments_writer::consume(range_tombstone_change&& rtc)
 
 stop_iteration compacted_fragments_writer::consume_end_of_partition() {
     auto ret = do_consume_end_of_partition();
-    if (ret == stop_iteration::yes) {
+    if (ret == stop_iteration::yes || std::exchange(_isolating_partition, false)) {
         stop_current_writer();
     }
     return ret;
@@ -1151,6 +1432,78 @@ void compacted_fragments_writer::consume_end_of_stream() {
     }
 }
 
+bool compacted_fragments_writer::can_copy_raw_partitions_from(const dht::decorated_key& dk, const sstable& source) {
+    if (!_compaction_writer) {
+        _compaction_writer = _create_compaction_writer(dk);
+    }
+    return _compaction_writer->writer.can_copy_raw_partitions_from(source);
+}
+
+void compacted_fragments_writer::consume_raw_partition(const dht::decorated_key& dk, const sstable& source, temporary_buffer<char> data) {
+    maybe_abort_compaction();
+    if (!_compaction_writer) {
+        _compaction_writer = _create_compaction_writer(dk);
+    }
+    _c.on_new_partition();
+    _c._cdata.total_keys_written++;
+    _writer_has_partitions = true;
+    if (_compaction_writer->writer.consume_raw_partition(dk, source, std::move(data)) == stop_iteration::yes) {
+        stop_current_writer();
+    }
+}
+
+bool raw_partition_copier::try_copy(const dht::decorated_key& dk) {
+    if (!_writer || _index.eof() || _compatible_with_output == false) {
+        return false;
+    }
+    auto hk = sstable::make_hashed_key(_schema, dk.key());
+    for (auto& sst : _others) {
+        if (sst->get_first_decorated_key().tri_compare(_schema, dk) <= 0
+                && dk.tri_compare(_schema, sst->get_last_decorated_key()) <= 0
+                && sst->filter_has_key(hk)) {
+            return false;
+        }
+    }
+    if (!_index.advance_lower_and_check_if_present(dk).get() || _index.get_promoted_index_size()) {
+        return false;
+    }
+    auto start = _index.get_data_file_position();
+    _index.advance_to_next_partition().get();
+    auto end = _index.data_file_positions().start;
+    if (end - start > _max_partition_size) {
+        return false;
+    }
+    if (!_compatible_with_output) {
+        _compatible_with_output = _writer->can_copy_raw_partitions_from(dk, *_source);
+        if (!*_compatible_with_output) {
+            clogger.debug("Cannot copy partitions of {} as is, its serialization differs from the output", _source->get_filename());
+            return false;
+        }
+    }
+
+    if (!_data) {
+        _data.emplace(_source->data_stream(start, _source->data_size() - start, _permit, tracing::trace_state_ptr(), {}));
+        _data_position = start;
+    }
+    _data->skip(start - _data_position).get();
+    auto data = _data->read_exactly(end - start).get();
+    if (data.size() != end - start) {
+        throw malformed_sstable_exception(format("Unexpected end of data while copying partition {}", dk), _source->get_filename());
+    }
+    _data_position = end;
+    _writer->consume_raw_partition(dk, *_source, std::move(data));
+    _copied_partitions++;
+    _copied_bytes += end - start;
+    return true;
+}
+
+future<> raw_partition_copier::close() noexcept {
+    co_await _index.close();
+    if (_data) {
+        co_await _data->close();
+    }
+}
+
 class regular_compaction : public compaction {
     seastar::semaphore _replacer_lock = {1};
 public:
@@ -1224,8 +1577,11 @@ class regular_compaction : public compaction {
             return sst->get_last_decorated_key().tri_compare(*s, dk) > 0;
         };
         auto exhausted = std::partition(_sstables.begin(), _sstables.end(), not_exhausted);
+        const bool checkpoint = checkpointing_enabled();
 
-        if (exhausted != _sstables.end()) {
+        // When checkpointing, the sealed output is made available even if it doesn't
+        // exhaust any input, so the checkpoint doesn't depend on unsealed outputs.
+        if (exhausted != _sstables.end() || checkpoint) {
             // The goal is that exhausted sstables will be deleted as soon as possible,
             // so we need to release reference to them.
             std::for_each(exhausted, _sstables.end(), [this] (shared_sstable& sst) {
@@ -1251,6 +1607,12 @@ class regular_compaction : public compaction {
             _sstables.erase(exhausted, _sstables.end());
             dynamic_cast<compaction_read_monitor_generator&>(unwrap_monitor_generator()).remove_exhausted_sstables(exhausted_ssts);
         }
+        if (checkpoint) {
+            _checkpointer(compaction_checkpoint{
+                .remaining_inputs = _sstables,
+                .last_key = sst->get_last_decorated_key(),
+            });
+        }
     }
 
     void replace_remaining_exhausted_sstables() {
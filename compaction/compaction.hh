@@ -53,6 +53,8 @@ struct compaction_data {
     abort_source abort;
     utils::UUID compaction_uuid;
     unsigned compaction_fan_in = 0;
+    // Number of input buffers read ahead of the output writers, 0 disables pipelining.
+    unsigned pipeline_depth = 0;
     struct replacement {
         const std::vector<shared_sstable> removed;
         const std::vector<shared_sstable> added;
@@ -78,6 +80,8 @@ struct compaction_stats {
     uint64_t validation_errors = 0;
     // Bloom filter checks during max purgeable calculation
     uint64_t bloom_filter_checks = 0;
+    // Partitions copied to the output without being rewritten
+    uint64_t raw_copied_partitions = 0;
     combined_reader_statistics reader_statistics;
 
     compaction_stats& operator+=(const compaction_stats& r) {
@@ -86,6 +90,7 @@ struct compaction_stats {
         end_size += r.end_size;
         validation_errors += r.validation_errors;
         bloom_filter_checks += r.bloom_filter_checks;
+        raw_copied_partitions += r.raw_copied_partitions;
         return *this;
     }
     friend compaction_stats operator+(const compaction_stats& l, const compaction_stats& r) {
@@ -45,6 +45,17 @@ using compaction_sstable_creator_fn = std::function<shared_sstable(shard_id shar
 // Replaces old sstable(s) by new one(s) which contain all non-expired data.
 using compaction_sstable_replacer_fn = std::function<void(compaction_completion_desc)>;
 
+// State of a compaction right after its sealed outputs were passed to the replacer,
+// from which the compaction can be resumed, see compaction_descriptor::resume_after.
+struct compaction_checkpoint {
+    // Input sstables which weren't replaced yet.
+    std::vector<shared_sstable> remaining_inputs;
+    // All the data of the inputs up to and including this partition is in the sealed outputs.
+    dht::decorated_key last_key;
+};
+// Records a compaction checkpoint, called in a seastar thread.
+using compaction_checkpoint_fn = std::function<void(const compaction_checkpoint&)>;
+
 class compaction_type_options {
 public:
     struct regular {
@@ -155,6 +166,9 @@ struct compaction_descriptor {
     uint64_t max_sstable_bytes;
     // Can split large partitions at clustering boundary.
     bool can_split_large_partition = false;
+    // Partitions estimated to be larger than this are written to dedicated sstables,
+    // so they don't skew the size of the sstables they would otherwise share.
+    uint64_t isolate_partitions_above = std::numeric_limits<uint64_t>::max();
     // Run identifier of output sstables.
     sstables::run_id run_identifier;
     // The options passed down to the compaction code.
@@ -167,6 +181,14 @@ struct compaction_descriptor {
 
     compaction_sstable_creator_fn creator;
     compaction_sstable_replacer_fn replacer;
+    // If set, every sealed output is passed to the replacer right away, even if
+    // it doesn't exhaust any input, and the resulting checkpoint is recorded.
+    // Requires a replacer and a max_sstable_bytes limit.
+    compaction_checkpoint_fn checkpointer;
+    // If engaged, only the partitions following this one are compacted. Used to
+    // resume a compaction from a checkpoint, together with the remaining inputs
+    // and the run identifier of the checkpointed compaction.
+    std::optional<dht::decorated_key> resume_after;
 
     // Denotes if this compaction task is comprised solely of completely expired SSTables
     sstables::has_only_fully_expired has_only_fully_expired = has_only_fully_expired::no;
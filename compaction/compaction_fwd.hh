@@ -18,7 +18,9 @@ namespace compaction {
 class table_state;
 class strategy_control;
 struct compaction_state;
+class maintenance_batch;
 
 using owned_ranges_ptr = seastar::lw_shared_ptr<const dht::token_range_vector>;
+using maintenance_batch_ptr = seastar::lw_shared_ptr<maintenance_batch>;
 
 } // namespace compaction
@@ -25,6 +25,7 @@
 #include "utils/assert.hh"
 #include "utils/error_injection.hh"
 #include "utils/UUID_gen.hh"
+#include "utils/pretty_printers.hh"
 #include "db/system_keyspace.hh"
 #include "tombstone_gc-internals.hh"
 #include <cmath>
@@ -182,6 +183,18 @@ static inline int calculate_weight(const sstables::compaction_descriptor& descri
     return calculate_weight(descriptor.sstables_size());
 }
 
+// Calculate the read amplification score of a compaction job, i.e. the expected number of
+// sstables that reads of the table are spared per second once the job is done.
+// A read touches on average sstables_per_read() sstables, and compacting fan_in overlapping
+// runs into a single one saves it up to fan_in - 1 of them.
+static inline double calculate_read_amplification_score(const table_state& t, const sstables::compaction_descriptor& descriptor) {
+    if (descriptor.sstables.empty()) {
+        return 0;
+    }
+    auto touched = std::min(t.sstables_per_read(), double(descriptor.fan_in()));
+    return std::max(touched - 1, 0.0) * t.read_rate();
+}
+
 unsigned compaction_manager::current_compaction_fan_in_threshold() const {
     if (_tasks.empty()) {
         return 0;
@@ -519,6 +532,11 @@ class sstables_task_executor : public compaction_task_executor, public sstables_
 };
 
 class major_compaction_task_executor : public compaction_task_executor, public major_compaction_task_impl {
+    // Engaged if this compaction resumes a checkpointed one, or once it recorded a checkpoint.
+    std::optional<sstables::run_id> _checkpointed_run;
+    // Input size of the whole compaction, and how much of it was compacted before it was resumed.
+    uint64_t _total_bytes = 0;
+    uint64_t _resumed_bytes = 0;
 public:
     major_compaction_task_executor(compaction_manager& mgr,
             throw_if_stopping do_throw_if_stopping,
@@ -532,7 +550,14 @@ class major_compaction_task_executor : public compaction_task_executor, public m
     }
 
     virtual future<tasks::task_manager::task::progress> get_progress() const override {
-        return compaction_task_impl::get_progress(_compaction_data, _progress_monitor);
+        auto progress = co_await compaction_task_impl::get_progress(_compaction_data, _progress_monitor);
+        if (!_resumed_bytes) {
+            co_return progress;
+        }
+        co_return tasks::task_manager::task::progress{
+            .completed = is_done() ? _total_bytes : std::min<double>(_total_bytes, _resumed_bytes + progress.completed),
+            .total = double(_total_bytes),
+        };
     }
 
     virtual void abort() noexcept override {
@@ -543,6 +568,105 @@ class major_compaction_task_executor : public compaction_task_executor, public m
         return perform();
     }
 
+    bool checkpointing_enabled() const {
+        return _cm._sys_ks && _cm._cfg.checkpoint_major();
+    }
+
+    // Looks for the checkpoint of an interrupted major compaction of this compaction group,
+    // and returns the descriptor resuming it if its remaining inputs are all still candidates.
+    // Checkpoints whose inputs were partly compacted by other compactions since are dropped.
+    future<std::optional<sstables::compaction_descriptor>> maybe_resume(table_state& t, const std::vector<sstables::shared_sstable>& candidates) {
+        auto sys_ks = _cm._sys_ks;
+        auto s = t.schema();
+        auto by_generation = candidates
+                | std::views::transform([] (const sstables::shared_sstable& sst) { return std::pair(fmt::to_string(sst->generation()), sst); })
+                | std::ranges::to<std::unordered_map<sstring, sstables::shared_sstable>>();
+        for (auto& entry : co_await sys_ks->get_compaction_checkpoints(s->id())) {
+            std::vector<sstables::shared_sstable> inputs;
+            for (auto& generation : entry.inputs) {
+                if (auto it = by_generation.find(generation); it != by_generation.end()) {
+                    inputs.push_back(it->second);
+                }
+            }
+            if (inputs.empty()) {
+                // The checkpoint belongs to another shard or compaction group.
+                continue;
+            }
+            if (inputs.size() != entry.inputs.size()) {
+                cmlog.info("Dropping stale checkpoint of major compaction {} on behalf of {}, some of its inputs were compacted since", entry.run_id, t);
+                co_await sys_ks->remove_compaction_checkpoint(s->id(), entry.run_id);
+                continue;
+            }
+
+            auto run = sstables::run_id(entry.run_id);
+            auto last_key = dht::decorate_key(*s, partition_key::from_bytes(entry.last_key));
+            std::optional<uint32_t> level;
+            // Outputs sealed after the checkpoint was recorded already hold the data following it.
+            t.main_sstable_set().for_each_sstable([&] (const sstables::shared_sstable& sst) {
+                if (sst->run_identifier() != run) {
+                    return;
+                }
+                level = sst->get_sstable_level();
+                if (sst->get_last_decorated_key().tri_compare(*s, last_key) > 0) {
+                    last_key = sst->get_last_decorated_key();
+                }
+            });
+
+            auto descriptor = t.get_compaction_strategy().get_major_compaction_job(t, std::move(inputs));
+            descriptor.run_identifier = run;
+            descriptor.level = level.value_or(descriptor.level);
+            descriptor.resume_after = std::move(last_key);
+            _checkpointed_run = run;
+            _total_bytes = entry.bytes_total;
+            _resumed_bytes = entry.bytes_done;
+            cmlog.info("Resuming major compaction {} on behalf of {}, {} of {} were compacted before it was interrupted", entry.run_id, t,
+                    utils::pretty_printed_data_size(_resumed_bytes), utils::pretty_printed_data_size(_total_bytes));
+            co_return descriptor;
+        }
+        co_return std::nullopt;
+    }
+
+    // Records the progress of the compaction each time it seals an output, see compaction_descriptor::checkpointer.
+    sstables::compaction_checkpoint_fn make_checkpointer(table_state& t, sstables::run_id run) {
+        return [this, &t, run, sys_ks = _cm._sys_ks] (const sstables::compaction_checkpoint& checkpoint) {
+            auto s = t.schema();
+            auto entry = db::compaction_checkpoint_entry{
+                .table_uuid = s->id(),
+                .run_id = run.uuid(),
+                .ks = s->ks_name(),
+                .cf = s->cf_name(),
+                .inputs = checkpoint.remaining_inputs
+                        | std::views::transform([] (const sstables::shared_sstable& sst) { return fmt::to_string(sst->generation()); })
+                        | std::ranges::to<std::unordered_set<sstring>>(),
+                .last_key = to_bytes(checkpoint.last_key.key().representation()),
+                .bytes_total = int64_t(_total_bytes),
+                .bytes_done = int64_t(_resumed_bytes + _progress_monitor.get_progress()),
+            };
+            _checkpointed_run = run;
+            sys_ks->save_compaction_checkpoint(std::move(entry)).handle_exception([&t] (std::exception_ptr ep) {
+                cmlog.warn("Failed to record the progress of major compaction on behalf of {}: {}", t, ep);
+            }).get();
+            // Interrupts the compaction once at most remaining_inputs (if given) of its inputs are left.
+            utils::get_local_injector().inject("major_compaction_stop_after_checkpoint", [this, &checkpoint] (auto& handler) -> future<> {
+                auto remaining_inputs = handler.template get<size_t>("remaining_inputs");
+                if (!remaining_inputs || checkpoint.remaining_inputs.size() <= *remaining_inputs) {
+                    _compaction_data.stop("major_compaction_stop_after_checkpoint");
+                }
+                co_return;
+            }).get();
+        };
+    }
+
+    future<> remove_checkpoint(table_state& t) {
+        if (!_checkpointed_run) {
+            co_return;
+        }
+        auto sys_ks = _cm._sys_ks;
+        co_await sys_ks->remove_compaction_checkpoint(t.schema()->id(), _checkpointed_run->uuid()).handle_exception([&t] (std::exception_ptr ep) {
+            cmlog.warn("Failed to remove the checkpoint of major compaction on behalf of {}: {}", t, ep);
+        });
+    }
+
     // first take major compaction semaphore, then exclusely take compaction lock for table.
     // it cannot be the other way around, or minor compaction for this table would be
     // prevented while an ongoing major compaction doesn't release the semaphore.
@@ -560,8 +684,19 @@ class major_compaction_task_executor : public compaction_task_executor, public m
         // those are eligible for major compaction.
         table_state* t = _compacting_table;
         sstables::compaction_strategy cs = t->get_compaction_strategy();
-        sstables::compaction_descriptor descriptor = cs.get_major_compaction_job(*t, _cm.get_candidates(*t));
+        auto candidates = _cm.get_candidates(*t);
+        std::optional<sstables::compaction_descriptor> resumed;
+        if (checkpointing_enabled()) {
+            resumed = co_await maybe_resume(*t, candidates);
+        }
+        sstables::compaction_descriptor descriptor = resumed ? std::move(*resumed) : cs.get_major_compaction_job(*t, std::move(candidates));
         descriptor.gc_check_only_compacting_sstables = _consider_only_existing_data;
+        if (checkpointing_enabled()) {
+            if (!resumed) {
+                _total_bytes = descriptor.sstables_size();
+            }
+            descriptor.checkpointer = make_checkpointer(*t, descriptor.run_identifier);
+        }
         auto compacting = compacting_sstable_registration(_cm, _cm.get_compaction_state(t), descriptor.sstables);
         auto on_replace = compacting.update_on_sstable_replacement();
         setup_new_compaction(descriptor.run_identifier);
@@ -582,6 +717,7 @@ class major_compaction_task_executor : public compaction_task_executor, public m
         });
 
         co_await compact_sstables_and_update_history(std::move(descriptor), _compaction_data, on_replace);
+        co_await remove_checkpoint(*t);
 
         finish_compaction();
 
@@ -780,8 +916,9 @@ auto fmt::formatter<compaction::compaction_task_executor>::format(const compacti
                           ex._description, fmt::ptr(&ex), *t, fmt::ptr(t));
 }
 
-inline compaction_controller make_compaction_controller(const compaction_manager::scheduling_group& csg, uint64_t static_shares, std::function<double()> fn) {
-    return compaction_controller(csg, static_shares, 250ms, std::move(fn));
+inline compaction_controller make_compaction_controller(const compaction_manager::scheduling_group& csg, uint64_t static_shares, std::function<double()> fn,
+        backlog_controller::feedback_config feedback = {}) {
+    return compaction_controller(csg, static_shares, 250ms, std::move(fn), std::move(feedback));
 }
 
 compaction::compaction_state::~compaction_state() {
@@ -866,8 +1003,13 @@ future<semaphore_units<named_semaphore_exception_factory>> compaction_task_execu
     });
 }
 
+future<semaphore_units<named_semaphore_exception_factory>> compaction_task_executor::acquire_maintenance_permit(const compaction_manager::maintenance_batch_ptr& batch) {
+    return acquire_semaphore(batch ? batch->semaphore() : _cm._maintenance_ops_sem);
+}
+
 void compaction_task_executor::setup_new_compaction(sstables::run_id output_run_id) {
     _compaction_data = _cm.create_compaction_data();
+    _compaction_data.pipeline_depth = _cm._cfg.pipeline_depth();
     _output_run_identifier = output_run_id;
     switch_state(state::active);
 }
@@ -934,7 +1076,7 @@ compaction_manager::compaction_manager(config cfg, abort_source& as, tasks::task
             return compaction_controller::normalization_factor;
         }
         return b;
-    }))
+    }, _cfg.controller_feedback))
     , _backlog_manager(_compaction_controller)
     , _early_abort_subscription(as.subscribe([this] () noexcept {
         do_stop();
@@ -1011,6 +1153,7 @@ void compaction_manager::register_metrics() {
         sm::make_counter("validation_errors", [this] { return _validation_errors; },
                        sm::description("Holds the number of encountered validation errors.")),
     });
+    _compaction_controller.register_metrics(_metrics, "compaction_manager");
 }
 
 void compaction_manager::enable() {
@@ -1043,9 +1186,15 @@ future<> compaction_manager::postponed_compactions_reevaluation() {
         // for moving the list to be processed into a local.
         auto postponed = std::exchange(_postponed, {});
         try {
-            for (auto it = postponed.begin(); it != postponed.end();) {
-                table_state* t = *it;
-                it = postponed.erase(it);
+            // Resubmit the tables whose pending job spares reads the most sstables first, so that
+            // they are the first to claim the weights released by finished compactions.
+            auto by_score = postponed | std::ranges::to<std::vector>();
+            std::ranges::stable_sort(by_score, std::greater<>(), [this] (table_state* t) {
+                auto it = _compaction_state.find(t);
+                return it != _compaction_state.end() ? it->second.read_amplification_score : 0.0;
+            });
+            for (table_state* t : by_score) {
+                postponed.erase(t);
                 // skip reevaluation of a table_state that became invalid post its removal
                 if (!_compaction_state.contains(t)) {
                     continue;
@@ -1275,6 +1424,11 @@ class regular_compaction_task_executor : public compaction_task_executor, public
             sstables::compaction_strategy cs = t.get_compaction_strategy();
             sstables::compaction_descriptor descriptor = cs.get_sstables_for_compaction(t, _cm.get_strategy_control());
             int weight = calculate_weight(descriptor);
+            _compaction_state.read_amplification_score = calculate_read_amplification_score(t, descriptor);
+            if (!descriptor.sstables.empty() && !is_system_keyspace(_status.keyspace)) {
+                // Lets tests observe the score of a picked job before it runs.
+                co_await utils::get_local_injector().inject("compaction_regular_compaction_task_executor_picked_job", utils::wait_for_message(60s));
+            }
 
             if (descriptor.sstables.empty() || !can_proceed() || t.is_auto_compaction_disabled_by_user()) {
                 cmlog.debug("{}: sstables={} can_proceed={} auto_compaction={}", *this, descriptor.sstables.size(), can_proceed(), t.is_auto_compaction_disabled_by_user());
@@ -1535,6 +1689,11 @@ class offstrategy_compaction_task_executor : public compaction_task_executor, pu
 
 }
 
+future<compaction_manager::maintenance_batch_ptr> compaction_manager::start_maintenance_batch() {
+    auto permit = co_await seastar::get_units(_maintenance_ops_sem, 1);
+    co_return make_lw_shared<maintenance_batch>(std::move(permit));
+}
+
 future<bool> compaction_manager::perform_offstrategy(table_state& t, tasks::task_info info) {
     auto gh = start_compaction(t);
     if (!gh) {
@@ -1553,21 +1712,24 @@ class rewrite_sstables_compaction_task_executor : public sstables_task_executor
     owned_ranges_ptr _owned_ranges_ptr;
     compacting_sstable_registration _compacting;
     compaction_manager::can_purge_tombstones _can_purge;
+    compaction_manager::maintenance_batch_ptr _batch;
 
 public:
     rewrite_sstables_compaction_task_executor(compaction_manager& mgr, throw_if_stopping do_throw_if_stopping, table_state* t, tasks::task_id parent_id, sstables::compaction_type_options options, owned_ranges_ptr owned_ranges_ptr,
                                      std::vector<sstables::shared_sstable> sstables, compacting_sstable_registration compacting,
-                                     compaction_manager::can_purge_tombstones can_purge, sstring type_options_desc = "")
+                                     compaction_manager::can_purge_tombstones can_purge, sstring type_options_desc = "", compaction_manager::maintenance_batch_ptr batch = {})
         : sstables_task_executor(mgr, do_throw_if_stopping, t, options.type(), sstring(sstables::to_string(options.type())), std::move(sstables), parent_id, std::move(type_options_desc))
         , _options(std::move(options))
         , _owned_ranges_ptr(std::move(owned_ranges_ptr))
         , _compacting(std::move(compacting))
         , _can_purge(can_purge)
+        , _batch(std::move(batch))
     {}
 
     virtual void release_resources() noexcept override {
         _compacting.release_all();
         _owned_ranges_ptr = nullptr;
+        _batch = nullptr;
         sstables_task_executor::release_resources();
     }
 
@@ -1576,7 +1738,7 @@ class rewrite_sstables_compaction_task_executor : public sstables_task_executor
         sstables::compaction_stats stats{};
 
         switch_state(state::pending);
-        auto maintenance_permit = co_await acquire_semaphore(_cm._maintenance_ops_sem);
+        auto maintenance_permit = co_await acquire_maintenance_permit(_batch);
 
         while (!_sstables.empty() && can_proceed()) {
             auto sst = consume_sstable();
@@ -1738,8 +1900,8 @@ future<compaction_manager::compaction_stats_opt> compaction_manager::perform_tas
 future<compaction_manager::compaction_stats_opt>
 compaction_manager::rewrite_sstables(table_state& t, sstables::compaction_type_options options, owned_ranges_ptr owned_ranges_ptr,
                                      get_candidates_func get_func, tasks::task_info info, can_purge_tombstones can_purge,
-                                     sstring options_desc) {
-    return perform_task_on_all_files<rewrite_sstables_compaction_task_executor>(info, t, std::move(options), std::move(owned_ranges_ptr), std::move(get_func), can_purge, std::move(options_desc));
+                                     sstring options_desc, maintenance_batch_ptr batch) {
+    return perform_task_on_all_files<rewrite_sstables_compaction_task_executor>(info, t, std::move(options), std::move(owned_ranges_ptr), std::move(get_func), can_purge, std::move(options_desc), std::move(batch));
 }
 
 namespace compaction {
@@ -1827,15 +1989,17 @@ class cleanup_sstables_compaction_task_executor : public compaction_task_executo
     owned_ranges_ptr _owned_ranges_ptr;
     compacting_sstable_registration _compacting;
     std::vector<sstables::compaction_descriptor> _pending_cleanup_jobs;
+    compaction_manager::maintenance_batch_ptr _batch;
 public:
     cleanup_sstables_compaction_task_executor(compaction_manager& mgr, throw_if_stopping do_throw_if_stopping, table_state* t, tasks::task_id parent_id, sstables::compaction_type_options options, owned_ranges_ptr owned_ranges_ptr,
-                                     std::vector<sstables::shared_sstable> candidates, compacting_sstable_registration compacting)
+                                     std::vector<sstables::shared_sstable> candidates, compacting_sstable_registration compacting, compaction_manager::maintenance_batch_ptr batch = {})
             : compaction_task_executor(mgr, do_throw_if_stopping, t, options.type(), sstring(sstables::to_string(options.type())))
             , cleanup_compaction_task_impl(mgr._task_manager_module, tasks::task_id::create_random_id(), 0, "compaction group", t->schema()->ks_name(), t->schema()->cf_name(), "", parent_id)
             , _cleanup_options(std::move(options))
             , _owned_ranges_ptr(std::move(owned_ranges_ptr))
             , _compacting(std::move(compacting))
             , _pending_cleanup_jobs(t->get_compaction_strategy().get_cleanup_compaction_jobs(*t, std::move(candidates)))
+            , _batch(std::move(batch))
     {
         // Cleanup is made more resilient under disk space pressure, by cleaning up smaller jobs first, so larger jobs
         // will have more space available released by previous jobs.
@@ -1851,6 +2015,7 @@ class cleanup_sstables_compaction_task_executor : public compaction_task_executo
         _pending_cleanup_jobs = {};
         _compacting.release_all();
         _owned_ranges_ptr = nullptr;
+        _batch = nullptr;
     }
 
     virtual future<tasks::task_manager::task::progress> get_progress() const override {
@@ -1867,7 +2032,7 @@ class cleanup_sstables_compaction_task_executor : public compaction_task_executo
 
     virtual future<compaction_manager::compaction_stats_opt>  do_run() override {
         switch_state(state::pending);
-        auto maintenance_permit = co_await acquire_semaphore(_cm._maintenance_ops_sem);
+        auto maintenance_permit = co_await acquire_maintenance_permit(_batch);
 
         while (!_pending_cleanup_jobs.empty() && can_proceed()) {
             auto active_job = std::move(_pending_cleanup_jobs.back());
@@ -1980,7 +2145,7 @@ const std::unordered_set<sstables::shared_sstable>& compaction_manager::sstables
     return cs.sstables_requiring_cleanup;
 }
 
-future<> compaction_manager::perform_cleanup(owned_ranges_ptr sorted_owned_ranges, table_state& t, tasks::task_info info) {
+future<> compaction_manager::perform_cleanup(owned_ranges_ptr sorted_owned_ranges, table_state& t, tasks::task_info info, maintenance_batch_ptr batch) {
     auto gh = start_compaction(t);
     if (!gh) {
         co_return;
@@ -1990,7 +2155,7 @@ future<> compaction_manager::perform_cleanup(owned_ranges_ptr sorted_owned_range
     constexpr auto max_idle_duration = std::chrono::seconds(300);
     auto& cs = get_compaction_state(&t);
 
-    co_await try_perform_cleanup(sorted_owned_ranges, t, info);
+    co_await try_perform_cleanup(sorted_owned_ranges, t, info, batch);
     auto last_idle = seastar::lowres_clock::now();
 
     while (!cs.sstables_requiring_cleanup.empty()) {
@@ -2020,12 +2185,12 @@ future<> compaction_manager::perform_cleanup(owned_ranges_ptr sorted_owned_range
         if (!has_sstables_eligible_for_compaction()) {
             continue;
         }
-        co_await try_perform_cleanup(sorted_owned_ranges, t, info);
+        co_await try_perform_cleanup(sorted_owned_ranges, t, info, batch);
         last_idle = seastar::lowres_clock::now();
     }
 }
 
-future<> compaction_manager::try_perform_cleanup(owned_ranges_ptr sorted_owned_ranges, table_state& t, tasks::task_info info) {
+future<> compaction_manager::try_perform_cleanup(owned_ranges_ptr sorted_owned_ranges, table_state& t, tasks::task_info info, maintenance_batch_ptr batch) {
     auto check_for_cleanup = [this, &t] {
         return std::ranges::any_of(_tasks, [&t] (auto& task) {
             return task.compacting_table() == &t && task.compaction_type() == sstables::compaction_type::Cleanup;
@@ -2067,7 +2232,8 @@ future<> compaction_manager::try_perform_cleanup(owned_ranges_ptr sorted_owned_r
     if (found_maintenance_sstables) {
         co_await perform_offstrategy(t, info);
     }
-    if (utils::get_local_injector().enter("major_compaction_before_cleanup")) {
+    // Major compaction takes the maintenance permit, which a batch already holds.
+    if (!batch && utils::get_local_injector().enter("major_compaction_before_cleanup")) {
         co_await perform_major_compaction(t, info);
     }
 
@@ -2078,11 +2244,11 @@ future<> compaction_manager::try_perform_cleanup(owned_ranges_ptr sorted_owned_r
     };
 
     co_await perform_task_on_all_files<cleanup_sstables_compaction_task_executor>(info, t, sstables::compaction_type_options::make_cleanup(), std::move(sorted_owned_ranges),
-                                                                         std::move(get_sstables));
+                                                                         std::move(get_sstables), std::move(batch));
 }
 
 // Submit a table to be upgraded and wait for its termination.
-future<> compaction_manager::perform_sstable_upgrade(owned_ranges_ptr sorted_owned_ranges, table_state& t, bool exclude_current_version, tasks::task_info info) {
+future<> compaction_manager::perform_sstable_upgrade(owned_ranges_ptr sorted_owned_ranges, table_state& t, bool exclude_current_version, tasks::task_info info, maintenance_batch_ptr batch) {
     auto get_sstables = [this, &t, exclude_current_version] {
         std::vector<sstables::shared_sstable> tables;
 
@@ -2106,7 +2272,8 @@ future<> compaction_manager::perform_sstable_upgrade(owned_ranges_ptr sorted_own
     // Note that we potentially could be doing multiple
     // upgrades here in parallel, but that is really the users
     // problem.
-    return rewrite_sstables(t, sstables::compaction_type_options::make_upgrade(), std::move(sorted_owned_ranges), std::move(get_sstables), info).discard_result();
+    return rewrite_sstables(t, sstables::compaction_type_options::make_upgrade(), std::move(sorted_owned_ranges), std::move(get_sstables), info,
+            can_purge_tombstones::yes, "", std::move(batch)).discard_result();
 }
 
 future<compaction_manager::compaction_stats_opt> compaction_manager::perform_split_compaction(table_state& t, sstables::compaction_type_options::split opt, tasks::task_info info) {
@@ -2245,6 +2412,11 @@ bool compaction_manager::has_table_ongoing_compaction(const table_state& t) cons
     });
 };
 
+double compaction_manager::read_amplification_score(const table_state& t) const {
+    auto it = _compaction_state.find(const_cast<table_state*>(&t));
+    return it != _compaction_state.end() ? it->second.read_amplification_score : 0;
+}
+
 bool compaction_manager::compaction_disabled(table_state& t) const {
     if (auto it = _compaction_state.find(&t); it != _compaction_state.end()) {
         return it->second.compaction_disabled();
@@ -43,6 +43,26 @@ namespace sstables { class test_env_compaction_manager; }
 namespace compaction {
 using throw_if_stopping = bool_class<struct throw_if_stopping_tag>;
 
+// Runs the maintenance operations (cleanup, sstable upgrade) of many small tables
+// back to back in a single maintenance slot.
+//
+// The batch holds the maintenance permit for its whole lifetime, so operations
+// started with it don't queue for the permit one table at a time, and other
+// maintenance operations wait until the batch is released. Operations within
+// the batch are serialized by the batch's own semaphore instead.
+class maintenance_batch {
+    semaphore_units<named_semaphore_exception_factory> _permit;
+    named_semaphore _sem = {1, named_semaphore_exception_factory{"maintenance batch"}};
+public:
+    explicit maintenance_batch(semaphore_units<named_semaphore_exception_factory> permit) noexcept
+        : _permit(std::move(permit))
+    {}
+
+    named_semaphore& semaphore() noexcept {
+        return _sem;
+    }
+};
+
 class compaction_task_executor;
 class sstables_task_executor;
 class major_compaction_task_executor;
@@ -76,13 +96,19 @@ class compaction_manager {
         scheduling_group maintenance_sched_group;
         size_t available_memory = 0;
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
+        backlog_controller::feedback_config controller_feedback;
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
+        utils::updateable_value<uint32_t> pipeline_depth = utils::updateable_value<uint32_t>(0);
+        utils::updateable_value<bool> checkpoint_major = utils::updateable_value<bool>(false);
+        utils::updateable_value<uint32_t> maintenance_batch_threshold_in_mb = utils::updateable_value<uint32_t>(0);
         std::chrono::seconds flush_all_tables_before_major = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::days(1));
     };
 
 public:
     class can_purge_tombstones_tag;
     using can_purge_tombstones = bool_class<can_purge_tombstones_tag>;
+    using maintenance_batch = compaction::maintenance_batch;
+    using maintenance_batch_ptr = compaction::maintenance_batch_ptr;
 
 private:
     shared_ptr<compaction::task_manager_module> _task_manager_module;
@@ -239,7 +265,7 @@ class compaction_manager {
     future<compaction_manager::compaction_stats_opt> perform_task_on_all_files(tasks::task_info info, table_state& t, sstables::compaction_type_options options, owned_ranges_ptr owned_ranges_ptr, get_candidates_func get_func, Args... args);
 
     future<compaction_stats_opt> rewrite_sstables(compaction::table_state& t, sstables::compaction_type_options options, owned_ranges_ptr, get_candidates_func, tasks::task_info info,
-                                                  can_purge_tombstones can_purge = can_purge_tombstones::yes, sstring options_desc = "");
+                                                  can_purge_tombstones can_purge = can_purge_tombstones::yes, sstring options_desc = "", maintenance_batch_ptr batch = {});
 
     // Stop all fibers, without waiting. Safe to be called multiple times.
     void do_stop() noexcept;
@@ -286,6 +312,15 @@ class compaction_manager {
         return _cfg.flush_all_tables_before_major;
     }
 
+    // Tables whose live data is smaller than this should have their
+    // maintenance run in a maintenance_batch. Zero disables batching.
+    uint64_t maintenance_batch_threshold() const noexcept {
+        return uint64_t(_cfg.maintenance_batch_threshold_in_mb.get()) << 20;
+    }
+
+    // Waits for a maintenance slot and returns a batch holding it.
+    future<maintenance_batch_ptr> start_maintenance_batch();
+
     void register_metrics();
 
     // enable the compaction manager.
@@ -324,9 +359,11 @@ class compaction_manager {
     // Cleanup is about discarding keys that are no longer relevant for a
     // given sstable, e.g. after node loses part of its token range because
     // of a newly added node.
-    future<> perform_cleanup(owned_ranges_ptr sorted_owned_ranges, compaction::table_state& t, tasks::task_info info);
+    //
+    // If `batch` is engaged, the cleanup runs in its maintenance slot.
+    future<> perform_cleanup(owned_ranges_ptr sorted_owned_ranges, compaction::table_state& t, tasks::task_info info, maintenance_batch_ptr batch = {});
 private:
-    future<> try_perform_cleanup(owned_ranges_ptr sorted_owned_ranges, compaction::table_state& t, tasks::task_info info);
+    future<> try_perform_cleanup(owned_ranges_ptr sorted_owned_ranges, compaction::table_state& t, tasks::task_info info, maintenance_batch_ptr batch);
 
     // Add sst to or remove it from the respective compaction_state.sstables_requiring_cleanup set.
     bool update_sstable_cleanup_state(table_state& t, const sstables::shared_sstable& sst, const dht::token_range_vector& sorted_owned_ranges);
@@ -334,7 +371,8 @@ class compaction_manager {
     future<> on_compaction_completion(table_state& t, sstables::compaction_completion_desc desc, sstables::offstrategy offstrategy);
 public:
     // Submit a table to be upgraded and wait for its termination.
-    future<> perform_sstable_upgrade(owned_ranges_ptr sorted_owned_ranges, compaction::table_state& t, bool exclude_current_version, tasks::task_info info);
+    // If `batch` is engaged, the upgrade runs in its maintenance slot.
+    future<> perform_sstable_upgrade(owned_ranges_ptr sorted_owned_ranges, compaction::table_state& t, bool exclude_current_version, tasks::task_info info, maintenance_batch_ptr batch = {});
 
     // Submit a table to be scrubbed and wait for its termination.
     future<compaction_stats_opt> perform_sstable_scrub(compaction::table_state& t, sstables::compaction_type_options::scrub opts, tasks::task_info info);
@@ -411,6 +449,11 @@ class compaction_manager {
     // Returns true if table has an ongoing compaction, running on its behalf
     bool has_table_ongoing_compaction(const compaction::table_state& t) const;
 
+    // Returns the expected number of sstables spared per second to reads of the table
+    // by the last regular compaction job picked for it, or 0 if it had none.
+    // Postponed compactions are resubmitted in decreasing order of this score.
+    double read_amplification_score(const compaction::table_state& t) const;
+
     bool compaction_disabled(compaction::table_state& t) const;
 
     // Stops ongoing compaction of a given type.
@@ -530,6 +573,8 @@ class compaction_task_executor
     state switch_state(state new_state);
 
     future<semaphore_units<named_semaphore_exception_factory>> acquire_semaphore(named_semaphore& sem, size_t units = 1);
+    // Acquires the maintenance permit, or the batch's one if the task runs in a maintenance batch.
+    future<semaphore_units<named_semaphore_exception_factory>> acquire_maintenance_permit(const compaction_manager::maintenance_batch_ptr& batch);
 
     // Return true if the task isn't stopped
     // and the compaction manager allows proceeding.
@@ -40,6 +40,9 @@ struct compaction_state {
 
     gc_clock::time_point last_regular_compaction;
 
+    // Read amplification score of the last regular compaction job picked for the table.
+    double read_amplification_score = 0;
+
     explicit compaction_state(table_state& t);
     compaction_state(compaction_state&&) = delete;
     ~compaction_state();
@@ -30,6 +30,7 @@
 #include "leveled_manifest.hh"
 #include "utils/to_string.hh"
 #include "incremental_compaction_strategy.hh"
+#include "unified_compaction_strategy.hh"
 #include "sstables/sstable_set_impl.hh"
 
 logging::logger leveled_manifest::logger("LeveledManifest");
@@ -70,7 +71,13 @@ bool compaction_strategy_impl::worth_dropping_tombstones(const shared_sstable& s
         return true;
     }
     auto droppable_ratio = sst->estimate_droppable_tombstone_ratio(compaction_time, t.get_tombstone_gc_state(), t.schema());
-    return droppable_ratio >= _tombstone_threshold;
+    if (droppable_ratio >= _tombstone_threshold) {
+        return true;
+    }
+    // Reads scanning many tombstones pay for them even when they are a small share of
+    // the sstable, so purge them once the droppable ones a read is expected to scan
+    // cross the read cost threshold.
+    return _tombstone_read_cost_threshold > 0 && droppable_ratio * t.tombstones_per_read() >= _tombstone_read_cost_threshold;
 }
 
 uint64_t compaction_strategy_impl::adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate, schema_ptr schema) const {
@@ -144,6 +151,21 @@ static db_clock::duration validate_tombstone_compaction_interval(const std::map<
     return tombstone_compaction_interval;
 }
 
+static double validate_tombstone_read_cost_threshold(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, compaction_strategy_impl::TOMBSTONE_READ_COST_THRESHOLD_OPTION);
+    auto threshold = cql3::statements::property_definitions::to_double(compaction_strategy_impl::TOMBSTONE_READ_COST_THRESHOLD_OPTION, tmp_value, compaction_strategy_impl::DEFAULT_TOMBSTONE_READ_COST_THRESHOLD);
+    if (threshold < 0.0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be non negative", compaction_strategy_impl::TOMBSTONE_READ_COST_THRESHOLD_OPTION, threshold));
+    }
+    return threshold;
+}
+
+static double validate_tombstone_read_cost_threshold(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto threshold = validate_tombstone_read_cost_threshold(options);
+    unchecked_options.erase(compaction_strategy_impl::TOMBSTONE_READ_COST_THRESHOLD_OPTION);
+    return threshold;
+}
+
 static bool validate_unchecked_tombstone_compaction(const std::map<sstring, sstring>& options) {
     auto unchecked_tombstone_compaction = compaction_strategy_impl::DEFAULT_UNCHECKED_TOMBSTONE_COMPACTION;
     auto tmp_value = compaction_strategy_impl::get_value(options, compaction_strategy_impl::UNCHECKED_TOMBSTONE_COMPACTION_OPTION);
@@ -178,6 +200,9 @@ void compaction_strategy_impl::validate_options_for_strategy_type(const std::map
         case compaction_strategy_type::incremental:
             incremental_compaction_strategy::validate_options(options, unchecked_options);
             break;
+        case compaction_strategy_type::unified:
+            unified_compaction_strategy::validate_options(options, unchecked_options);
+            break;
         default:
             break;
     }
@@ -195,6 +220,7 @@ void compaction_strategy_impl::validate_options(const std::map<sstring, sstring>
     validate_tombstone_threshold(options, unchecked_options);
     validate_tombstone_compaction_interval(options, unchecked_options);
     validate_unchecked_tombstone_compaction(options, unchecked_options);
+    validate_tombstone_read_cost_threshold(options, unchecked_options);
 
     auto it = options.find("enabled");
     if (it != options.end() && it->second != "true" && it->second != "false") {
@@ -207,6 +233,7 @@ compaction_strategy_impl::compaction_strategy_impl(const std::map<sstring, sstri
     _tombstone_threshold = validate_tombstone_threshold(options);
     _tombstone_compaction_interval = validate_tombstone_compaction_interval(options);
     _unchecked_tombstone_compaction = validate_unchecked_tombstone_compaction(options);
+    _tombstone_read_cost_threshold = validate_tombstone_read_cost_threshold(options);
 }
 
 } // namespace sstables
@@ -599,6 +626,8 @@ leveled_compaction_strategy::leveled_compaction_strategy(const std::map<sstring,
         : compaction_strategy_impl(options)
         , _max_sstable_size_in_mb(calculate_max_sstable_size_in_mb(compaction_strategy_impl::get_value(options, SSTABLE_SIZE_OPTION)))
         , _stcs_options(options)
+        , _large_partition_size_in_mb(cql3::statements::property_definitions::to_long(LARGE_PARTITION_SIZE_OPTION,
+                compaction_strategy_impl::get_value(options, LARGE_PARTITION_SIZE_OPTION), _max_sstable_size_in_mb))
 {
 }
 
@@ -614,6 +643,13 @@ void leveled_compaction_strategy::validate_options(const std::map<sstring, sstri
         throw exceptions::configuration_exception(fmt::format("{} value ({}) must be positive", SSTABLE_SIZE_OPTION, min_sstables_size));
     }
     unchecked_options.erase(SSTABLE_SIZE_OPTION);
+
+    tmp_value = compaction_strategy_impl::get_value(options, LARGE_PARTITION_SIZE_OPTION);
+    auto large_partition_size = cql3::statements::property_definitions::to_long(LARGE_PARTITION_SIZE_OPTION, tmp_value, min_sstables_size);
+    if (large_partition_size < 0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be non negative", LARGE_PARTITION_SIZE_OPTION, large_partition_size));
+    }
+    unchecked_options.erase(LARGE_PARTITION_SIZE_OPTION);
 }
 
 std::unique_ptr<compaction_backlog_tracker::impl> leveled_compaction_strategy::make_backlog_tracker() const {
@@ -640,7 +676,8 @@ time_window_compaction_strategy::time_window_compaction_strategy(const std::map<
     , _options(options)
     , _stcs_options(options)
 {
-    if (!options.contains(TOMBSTONE_COMPACTION_INTERVAL_OPTION) && !options.contains(TOMBSTONE_THRESHOLD_OPTION)) {
+    if (!options.contains(TOMBSTONE_COMPACTION_INTERVAL_OPTION) && !options.contains(TOMBSTONE_THRESHOLD_OPTION)
+            && !options.contains(TOMBSTONE_READ_COST_THRESHOLD_OPTION)) {
         _disable_tombstone_compaction = true;
         clogger.debug("Disabling tombstone compactions for TWCS");
     } else {
@@ -765,6 +802,9 @@ compaction_strategy make_compaction_strategy(compaction_strategy_type strategy,
     case compaction_strategy_type::incremental:
         impl = make_shared<incremental_compaction_strategy>(incremental_compaction_strategy(options));
         break;
+    case compaction_strategy_type::unified:
+        impl = ::make_shared<unified_compaction_strategy>(options);
+        break;
     default:
         throw std::runtime_error("strategy not supported");
     }
@@ -792,6 +832,7 @@ compaction_strategy_state compaction_strategy_state::make(const compaction_strat
         case compaction_strategy_type::null:
         case compaction_strategy_type::size_tiered:
         case compaction_strategy_type::incremental:
+        case compaction_strategy_type::unified:
             return compaction_strategy_state(default_empty_state{});
         case compaction_strategy_type::leveled:
             return compaction_strategy_state(leveled_compaction_strategy_state{});
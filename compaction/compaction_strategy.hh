@@ -72,6 +72,8 @@ class compaction_strategy {
             return "TimeWindowCompactionStrategy";
         case compaction_strategy_type::incremental:
             return "IncrementalCompactionStrategy";
+        case compaction_strategy_type::unified:
+            return "UnifiedCompactionStrategy";
         default:
             throw std::runtime_error("Invalid Compaction Strategy");
         }
@@ -90,6 +92,8 @@ class compaction_strategy {
             return compaction_strategy_type::time_window;
         } else if (short_name == "IncrementalCompactionStrategy") {
             return compaction_strategy_type::incremental;
+        } else if (short_name == "UnifiedCompactionStrategy") {
+            return compaction_strategy_type::unified;
         } else {
             throw exceptions::configuration_exception(format("Unable to find compaction strategy class '{}'", name));
         }
@@ -23,15 +23,21 @@ class compaction_strategy_impl {
     // minimum interval needed to perform tombstone removal compaction in seconds, default 86400 or 1 day.
     static constexpr std::chrono::seconds DEFAULT_TOMBSTONE_COMPACTION_INTERVAL() { return std::chrono::seconds(86400); }
     static constexpr auto DEFAULT_UNCHECKED_TOMBSTONE_COMPACTION = false;
+    static constexpr double DEFAULT_TOMBSTONE_READ_COST_THRESHOLD = 0;
     static constexpr auto TOMBSTONE_THRESHOLD_OPTION = "tombstone_threshold";
     static constexpr auto TOMBSTONE_COMPACTION_INTERVAL_OPTION = "tombstone_compaction_interval";
     static constexpr auto UNCHECKED_TOMBSTONE_COMPACTION_OPTION = "unchecked_tombstone_compaction";
+    static constexpr auto TOMBSTONE_READ_COST_THRESHOLD_OPTION = "tombstone_read_cost_threshold";
 protected:
     bool _use_clustering_key_filter = false;
     bool _disable_tombstone_compaction = false;
     float _tombstone_threshold = DEFAULT_TOMBSTONE_THRESHOLD;
     db_clock::duration _tombstone_compaction_interval = DEFAULT_TOMBSTONE_COMPACTION_INTERVAL();
     bool _unchecked_tombstone_compaction = DEFAULT_UNCHECKED_TOMBSTONE_COMPACTION;
+    // Droppable tombstones a read of the table is expected to scan in an sstable, above
+    // which the sstable is worth a tombstone compaction regardless of _tombstone_threshold.
+    // 0 disables it.
+    double _tombstone_read_cost_threshold = DEFAULT_TOMBSTONE_READ_COST_THRESHOLD;
 public:
     static std::optional<sstring> get_value(const std::map<sstring, sstring>& options, const sstring& name);
     static void validate_min_max_threshold(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
@@ -63,7 +69,8 @@ class compaction_strategy_impl {
     }
 
     // Check if a given sstable is entitled for tombstone compaction based on its
-    // droppable tombstone histogram and gc_before.
+    // droppable tombstone histogram and gc_before, and on the tombstones scanned
+    // by reads of the table.
     bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time, const table_state& t);
 
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const = 0;
@@ -18,6 +18,7 @@ enum class compaction_strategy_type {
     leveled,
     time_window,
     incremental,
+    unified,
 };
 
 enum class reshape_mode { strict, relaxed };
@@ -35,6 +35,7 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
 
     if (!candidate.sstables.empty()) {
         leveled_manifest::logger.debug("leveled: Compacting {} out of {} sstables", candidate.sstables.size(), table_s.main_sstable_set().all()->size());
+        isolate_large_partitions(candidate);
         return candidate;
     }
 
@@ -74,8 +75,16 @@ compaction_descriptor leveled_compaction_strategy::get_major_compaction_job(tabl
 
     auto max_sstable_size_in_bytes = _max_sstable_size_in_mb*1024*1024;
     auto ideal_level = ideal_level_for_input(candidates, max_sstable_size_in_bytes);
-    return make_major_compaction_job(std::move(candidates),
+    auto desc = make_major_compaction_job(std::move(candidates),
                                  ideal_level, max_sstable_size_in_bytes);
+    isolate_large_partitions(desc);
+    return desc;
+}
+
+void leveled_compaction_strategy::isolate_large_partitions(compaction_descriptor& descriptor) const {
+    if (_large_partition_size_in_mb > 0) {
+        descriptor.isolate_partitions_above = uint64_t(_large_partition_size_in_mb) * 1024 * 1024;
+    }
 }
 
 void leveled_compaction_strategy::notify_completion(table_state& table_s, const std::vector<shared_sstable>& removed, const std::vector<shared_sstable>& added) {
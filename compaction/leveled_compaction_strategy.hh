@@ -37,13 +37,22 @@ struct leveled_compaction_strategy_state {
 class leveled_compaction_strategy : public compaction_strategy_impl {
     static constexpr int32_t DEFAULT_MAX_SSTABLE_SIZE_IN_MB = 160;
     static constexpr auto SSTABLE_SIZE_OPTION = "sstable_size_in_mb";
+    static constexpr auto LARGE_PARTITION_SIZE_OPTION = "large_partition_size_in_mb";
 
     int32_t _max_sstable_size_in_mb = DEFAULT_MAX_SSTABLE_SIZE_IN_MB;
     size_tiered_compaction_strategy_options _stcs_options;
+    // Partitions above this size are written to dedicated sstables, 0 disables it.
+    // Defaults to _max_sstable_size_in_mb.
+    int64_t _large_partition_size_in_mb;
 private:
     int32_t calculate_max_sstable_size_in_mb(std::optional<sstring> option_value) const;
 
     leveled_compaction_strategy_state& get_state(table_state& table_s) const;
+
+    // Sets the descriptor up to write large partitions to dedicated sstables. They
+    // would otherwise fill most of an sstable whose size doesn't reflect its key range,
+    // and be rewritten whenever any of its neighbours is compacted.
+    void isolate_large_partitions(compaction_descriptor& descriptor) const;
 public:
     static unsigned ideal_level_for_input(const std::vector<sstables::shared_sstable>& input, uint64_t max_sstable_size);
     static void validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
@@ -60,6 +60,13 @@ class table_state {
     virtual const std::string get_group_id() const noexcept = 0;
     virtual seastar::condition_variable& get_staging_done_condition() noexcept = 0;
     virtual dht::token_range get_token_range_after_split(const dht::token& t) const noexcept = 0;
+    // Average number of sstables touched by the single-partition reads of the table
+    // of the last minute.
+    virtual double sstables_per_read() const noexcept = 0;
+    // Number of reads per second served by the table, averaged over the last minute.
+    virtual double read_rate() const noexcept = 0;
+    // Average number of dead rows and range tombstones scanned by a query of the table.
+    virtual double tombstones_per_read() const noexcept = 0;
 };
 
 } // namespace compaction
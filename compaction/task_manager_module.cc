@@ -211,6 +211,44 @@ future<> run_on_table(sstring op, replica::database& db, std::string keyspace, t
     }
 }
 
+// Moves the tables which are small enough to have their maintenance run
+// in a single maintenance batch out of `tables`, and returns them.
+static std::vector<table_info> extract_batched_tables(replica::database& db, std::vector<table_info>& tables) {
+    auto threshold = db.get_compaction_manager().maintenance_batch_threshold();
+    std::vector<table_info> batched;
+    if (!threshold) {
+        return batched;
+    }
+    std::erase_if(tables, [&] (const table_info& ti) {
+        try {
+            if (uint64_t(db.find_column_family(ti.id).get_stats().live_disk_space_used) < threshold) {
+                batched.push_back(ti);
+                return true;
+            }
+        } catch (const replica::no_such_column_family&) {
+            // Left for the table task to skip.
+        }
+        return false;
+    });
+    return batched;
+}
+
+// Runs `func` on each of `tables` in turn, all within a single maintenance batch,
+// instead of in a task of its own.
+static future<> run_batched_tables(sstring op, replica::database& db, std::string keyspace, std::vector<table_info> tables,
+        std::function<future<> (replica::table&, maintenance_batch_ptr)> func) {
+    if (tables.empty()) {
+        co_return;
+    }
+    tasks::tmlogger.debug("Running {} on {} tables of {} in a maintenance batch", op, tables.size(), keyspace);
+    auto batch = co_await db.get_compaction_manager().start_maintenance_batch();
+    for (auto& ti : tables) {
+        co_await run_on_table(op, db, keyspace, ti, [&] (replica::table& t) {
+            return func(t, batch);
+        });
+    }
+}
+
 future<> wait_for_your_turn(seastar::condition_variable& cv, tasks::task_manager::task_ptr& current_task, tasks::task_id id) {
     co_await cv.wait([&] {
         return current_task && current_task->id() == id;
@@ -477,12 +515,30 @@ future<> global_cleanup_compaction_task_impl::run() {
     });
 }
 
+// Note that we do not hold an effective_replication_map_ptr throughout
+// the cleanup operation, so the topology might change.
+// Since clenaup is an admin operation required for vnodes,
+// it is the responsibility of the system operator to not
+// perform additional incompatible range movements during cleanup.
+static future<owned_ranges_ptr> get_cleanup_owned_ranges(replica::database& db, std::string_view ks_name) {
+    const auto& erm = db.find_keyspace(ks_name).get_vnode_effective_replication_map();
+    co_return compaction::make_owned_ranges_ptr(co_await db.get_keyspace_local_ranges(erm));
+}
+
 future<> shard_cleanup_keyspace_compaction_task_impl::run() {
     seastar::condition_variable cv;
     tasks::task_manager::task_ptr current_task;
     tasks::task_info parent_info{_status.id, _status.shard};
+    auto tables = _local_tables;
+    auto batched_tables = extract_batched_tables(_db, tables);
+    if (!batched_tables.empty()) {
+        auto owned_ranges_ptr = co_await get_cleanup_owned_ranges(_db, _status.keyspace);
+        co_await run_batched_tables("force_keyspace_cleanup", _db, _status.keyspace, std::move(batched_tables), [&] (replica::table& t, maintenance_batch_ptr batch) {
+            return t.perform_cleanup_compaction(owned_ranges_ptr, parent_info, replica::table::do_flush::no, std::move(batch));
+        });
+    }
     std::vector<table_tasks_info> table_tasks;
-    for (auto& ti : _local_tables) {
+    for (auto& ti : tables) {
         table_tasks.emplace_back(co_await _module->make_and_start_task<table_cleanup_keyspace_compaction_task_impl>(parent_info, _status.keyspace, ti.name, _status.id, _db, ti, cv, current_task), ti);
     }
 
@@ -491,16 +547,7 @@ future<> shard_cleanup_keyspace_compaction_task_impl::run() {
 
 future<> table_cleanup_keyspace_compaction_task_impl::run() {
     co_await wait_for_your_turn(_cv, _current_task, _status.id);
-    // Note that we do not hold an effective_replication_map_ptr throughout
-    // the cleanup operation, so the topology might change.
-    // Since clenaup is an admin operation required for vnodes,
-    // it is the responsibility of the system operator to not
-    // perform additional incompatible range movements during cleanup.
-    auto get_owned_ranges = [&] (std::string_view ks_name) -> future<owned_ranges_ptr> {
-        const auto& erm = _db.find_keyspace(ks_name).get_vnode_effective_replication_map();
-        co_return compaction::make_owned_ranges_ptr(co_await _db.get_keyspace_local_ranges(erm));
-    };
-    auto owned_ranges_ptr = co_await get_owned_ranges(_status.keyspace);
+    auto owned_ranges_ptr = co_await get_cleanup_owned_ranges(_db, _status.keyspace);
     co_await run_on_table("force_keyspace_cleanup", _db, _status.keyspace, _ti, [&] (replica::table& t) {
         // skip the flush, as cleanup_keyspace_compaction_task_impl::run should have done this.
         return t.perform_cleanup_compaction(owned_ranges_ptr, tasks::task_info{_status.id, _status.shard}, replica::table::do_flush::no);
@@ -558,12 +605,31 @@ future<> upgrade_sstables_compaction_task_impl::run() {
     });
 }
 
+static future<owned_ranges_ptr> get_upgrade_owned_ranges(replica::database& db, std::string_view keyspace_name) {
+    const auto& ks = db.find_keyspace(keyspace_name);
+    if (ks.get_replication_strategy().is_per_table()) {
+        co_return nullptr;
+    }
+    const auto& erm = ks.get_vnode_effective_replication_map();
+    co_return compaction::make_owned_ranges_ptr(co_await db.get_keyspace_local_ranges(erm));
+}
+
 future<> shard_upgrade_sstables_compaction_task_impl::run() {
     seastar::condition_variable cv;
     tasks::task_manager::task_ptr current_task;
     tasks::task_info parent_info{_status.id, _status.shard};
+    auto tables = _table_infos;
+    auto batched_tables = extract_batched_tables(_db, tables);
+    if (!batched_tables.empty()) {
+        auto owned_ranges_ptr = co_await get_upgrade_owned_ranges(_db, _status.keyspace);
+        co_await run_batched_tables("upgrade_sstables", _db, _status.keyspace, std::move(batched_tables), [&] (replica::table& t, maintenance_batch_ptr batch) {
+            return t.parallel_foreach_table_state([&] (compaction::table_state& ts) -> future<> {
+                return t.get_compaction_manager().perform_sstable_upgrade(owned_ranges_ptr, ts, _exclude_current_version, parent_info, batch);
+            });
+        });
+    }
     std::vector<table_tasks_info> table_tasks;
-    for (auto& ti : _table_infos) {
+    for (auto& ti : tables) {
         table_tasks.emplace_back(co_await _module->make_and_start_task<table_upgrade_sstables_compaction_task_impl>(parent_info, _status.keyspace, ti.name, _status.id, _db, ti, cv, current_task, _exclude_current_version), ti);
     }
 
@@ -572,15 +638,7 @@ future<> shard_upgrade_sstables_compaction_task_impl::run() {
 
 future<> table_upgrade_sstables_compaction_task_impl::run() {
     co_await wait_for_your_turn(_cv, _current_task, _status.id);
-    auto get_owned_ranges = [&] (std::string_view keyspace_name) -> future<owned_ranges_ptr> {
-        const auto& ks = _db.find_keyspace(keyspace_name);
-        if (ks.get_replication_strategy().is_per_table()) {
-            co_return nullptr;
-        }
-        const auto& erm = ks.get_vnode_effective_replication_map();
-        co_return compaction::make_owned_ranges_ptr(co_await _db.get_keyspace_local_ranges(erm));
-    };
-    auto owned_ranges_ptr = co_await get_owned_ranges(_status.keyspace);
+    auto owned_ranges_ptr = co_await get_upgrade_owned_ranges(_db, _status.keyspace);
     tasks::task_info info{_status.id, _status.shard};
     co_await run_on_table("upgrade_sstables", _db, _status.keyspace, _ti, [&] (replica::table& t) -> future<> {
         return t.parallel_foreach_table_state([&] (compaction::table_state& ts) -> future<> {
@@ -0,0 +1,539 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "sstables/sstables.hh"
+#include "sstables/sstable_set_impl.hh"
+#include "cql3/statements/property_definitions.hh"
+#include "unified_compaction_strategy.hh"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <queue>
+#include <ranges>
+#include <boost/algorithm/string.hpp>
+
+namespace sstables {
+
+extern logging::logger clogger;
+
+static constexpr int max_scaling_parameter = 1000;
+
+static std::vector<int> parse_scaling_parameters(const sstring& value) {
+    auto invalid = [&value] {
+        return exceptions::configuration_exception(fmt::format("{} value ({}) must be a comma-separated list of N, T<fanout>, L<fanout> "
+            "or integers between {} and {}", unified_compaction_strategy_options::SCALING_PARAMETERS_KEY, value, -max_scaling_parameter, max_scaling_parameter));
+    };
+    auto to_int = [&] (std::string_view s) {
+        int v = 0;
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+        if (s.empty() || ec != std::errc() || ptr != s.data() + s.size() || std::abs(v) > max_scaling_parameter) {
+            throw invalid();
+        }
+        return v;
+    };
+
+    std::vector<std::string> parts;
+    boost::split(parts, value, boost::is_any_of(","));
+    std::vector<int> ret;
+    ret.reserve(parts.size());
+    for (auto& part : parts) {
+        boost::trim(part);
+        auto kind = part.empty() ? '\0' : std::toupper(part[0]);
+        if (kind == 'N' && part.size() == 1) {
+            ret.push_back(0);
+        } else if (kind == 'T' || kind == 'L') {
+            auto fanout = to_int(std::string_view(part).substr(1));
+            if (fanout < 2) {
+                throw invalid();
+            }
+            ret.push_back(kind == 'T' ? fanout - 2 : 2 - fanout);
+        } else {
+            ret.push_back(to_int(part));
+        }
+    }
+    return ret;
+}
+
+static std::vector<int> validate_scaling_parameters(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, unified_compaction_strategy_options::SCALING_PARAMETERS_KEY);
+    return parse_scaling_parameters(tmp_value.value_or(unified_compaction_strategy_options::DEFAULT_SCALING_PARAMETERS));
+}
+
+static std::vector<int> validate_scaling_parameters(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto scaling_parameters = validate_scaling_parameters(options);
+    unchecked_options.erase(unified_compaction_strategy_options::SCALING_PARAMETERS_KEY);
+    return scaling_parameters;
+}
+
+static long validate_size_in_mb(const std::map<sstring, sstring>& options, const char* key, uint64_t default_value) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, key);
+    auto size_in_mb = cql3::statements::property_definitions::to_long(key, tmp_value, default_value);
+    if (size_in_mb <= 0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be positive", key, size_in_mb));
+    }
+    return size_in_mb;
+}
+
+static long validate_size_in_mb(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options, const char* key, uint64_t default_value) {
+    auto size_in_mb = validate_size_in_mb(options, key, default_value);
+    unchecked_options.erase(key);
+    return size_in_mb;
+}
+
+static int validate_base_shard_count(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY);
+    auto base_shard_count = cql3::statements::property_definitions::to_int(unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY,
+        tmp_value, unified_compaction_strategy_options::DEFAULT_BASE_SHARD_COUNT);
+    if (base_shard_count < 1 || base_shard_count > 1024) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be between 1 and 1024",
+            unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY, base_shard_count));
+    }
+    return base_shard_count;
+}
+
+static int validate_base_shard_count(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto base_shard_count = validate_base_shard_count(options);
+    unchecked_options.erase(unified_compaction_strategy_options::BASE_SHARD_COUNT_KEY);
+    return base_shard_count;
+}
+
+unified_compaction_strategy_options::unified_compaction_strategy_options(const std::map<sstring, sstring>& options) {
+    scaling_parameters = validate_scaling_parameters(options);
+    target_sstable_size = validate_size_in_mb(options, TARGET_SSTABLE_SIZE_KEY, DEFAULT_TARGET_SSTABLE_SIZE_IN_MB) * 1024 * 1024;
+    min_sstable_size = validate_size_in_mb(options, MIN_SSTABLE_SIZE_KEY, DEFAULT_MIN_SSTABLE_SIZE_IN_MB) * 1024 * 1024;
+    base_shard_count = validate_base_shard_count(options);
+}
+
+// options is a map of compaction strategy options and their values.
+// unchecked_options is an analogical map from which already checked options are deleted.
+// This helps making sure that only allowed options are being set.
+void unified_compaction_strategy_options::validate(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    validate_scaling_parameters(options, unchecked_options);
+    validate_size_in_mb(options, unchecked_options, TARGET_SSTABLE_SIZE_KEY, DEFAULT_TARGET_SSTABLE_SIZE_IN_MB);
+    validate_size_in_mb(options, unchecked_options, MIN_SSTABLE_SIZE_KEY, DEFAULT_MIN_SSTABLE_SIZE_IN_MB);
+    validate_base_shard_count(options, unchecked_options);
+    compaction_strategy_impl::validate_min_max_threshold(options, unchecked_options);
+}
+
+int unified_compaction_strategy_options::scaling_parameter(unsigned level) const noexcept {
+    return scaling_parameters[std::min(size_t(level), scaling_parameters.size() - 1)];
+}
+
+unsigned unified_compaction_strategy_options::fanout(unsigned level) const noexcept {
+    return 2 + std::abs(scaling_parameter(level));
+}
+
+unsigned unified_compaction_strategy_options::threshold(unsigned level) const noexcept {
+    return scaling_parameter(level) < 0 ? 2 : fanout(level);
+}
+
+unsigned unified_compaction_strategy_options::level_for(double density) const noexcept {
+    unsigned level = 0;
+    double upper = double(min_sstable_size) * fanout(level);
+    while (density >= upper) {
+        upper *= fanout(++level);
+    }
+    return level;
+}
+
+double unified_compaction_strategy_options::rewrite_cost(double density) const noexcept {
+    density = std::max(density, 1.0);
+    double cost = 0;
+    double lower = min_sstable_size;
+    for (unsigned level = 0; ; ++level) {
+        auto f = fanout(level);
+        // In a leveled level, each sstable is merged with an overlapping sstable which is
+        // on average fanout/2 times larger, while a tiered level writes each byte once.
+        double level_cost = scaling_parameter(level) < 0 ? f / 2.0 : 1.0;
+        double upper = lower * f;
+        if (density < upper) {
+            return cost + level_cost * std::log(density / lower) / std::log(f);
+        }
+        cost += level_cost;
+        lower = upper;
+    }
+}
+
+unsigned unified_compaction_strategy_options::shard_count(double density) const noexcept {
+    static constexpr uint64_t max_shard_multiplier = 1 << 20;
+    auto target = double(target_sstable_size);
+    if (density < target * base_shard_count) {
+        return std::clamp<uint64_t>(std::bit_floor(uint64_t(density / target)), 1, base_shard_count);
+    }
+    return base_shard_count * std::min(std::bit_floor(uint64_t(density / (target * base_shard_count))), max_shard_multiplier);
+}
+
+class unified_compaction_strategy::density_calculator {
+    uint64_t _first = std::numeric_limits<uint64_t>::max();
+    uint64_t _last = 0;
+    uint64_t _total_bytes = 0;
+
+    static uint64_t first_token(const shared_sstable& sst) {
+        return sst->get_first_decorated_key().token().unbias();
+    }
+    static uint64_t last_token(const shared_sstable& sst) {
+        return sst->get_last_decorated_key().token().unbias();
+    }
+public:
+    template <std::ranges::input_range Range>
+    explicit density_calculator(const Range& sstables) {
+        for (const shared_sstable& sst : sstables) {
+            _first = std::min(_first, first_token(sst));
+            _last = std::max(_last, last_token(sst));
+            _total_bytes += sst->data_size();
+        }
+    }
+
+    // Density of data of the given size spanning the tokens [first, last], relative to
+    // the token range of the whole set. The set is the sstables of a compaction group,
+    // so with tablets the density is relative to the tablet's range.
+    // The density is capped at the size of the whole set, to keep sstables of very few
+    // partitions from being considered as dense as the whole set.
+    double density(uint64_t size, uint64_t first, uint64_t last) const noexcept {
+        if (_first >= _last) {
+            return size;
+        }
+        double fraction = (double(last - first) + 1) / (double(_last - _first) + 1);
+        return std::min(size / fraction, double(std::max(_total_bytes, size)));
+    }
+
+    double density(const shared_sstable& sst) const noexcept {
+        return density(sst->data_size(), first_token(sst), last_token(sst));
+    }
+
+    double density(const std::vector<shared_sstable>& sstables) const noexcept {
+        uint64_t size = 0;
+        uint64_t first = std::numeric_limits<uint64_t>::max();
+        uint64_t last = 0;
+        for (auto& sst : sstables) {
+            size += sst->data_size();
+            first = std::min(first, first_token(sst));
+            last = std::max(last, last_token(sst));
+        }
+        return sstables.empty() ? 0 : density(size, first, last);
+    }
+};
+
+std::vector<std::vector<shared_sstable>>
+unified_compaction_strategy::get_levels(const std::vector<shared_sstable>& sstables, const density_calculator& densities,
+        const unified_compaction_strategy_options& options) {
+    std::vector<std::vector<shared_sstable>> levels;
+    for (auto& sst : sstables) {
+        auto level = options.level_for(densities.density(sst));
+        if (level >= levels.size()) {
+            levels.resize(level + 1);
+        }
+        levels[level].push_back(sst);
+    }
+    return levels;
+}
+
+unified_compaction_strategy::overlapping_set unified_compaction_strategy::max_overlapping_set(const std::vector<shared_sstable>& sstables) {
+    auto first_token = [] (const shared_sstable& sst) { return sst->get_first_decorated_key().token(); };
+    auto last_token = [] (const shared_sstable& sst) { return sst->get_last_decorated_key().token(); };
+
+    auto sorted = sstables;
+    std::ranges::sort(sorted, std::less<dht::token>(), first_token);
+
+    // Sweep the sstables by their first token, keeping the last tokens of those
+    // which are still open, to find the token contained by most sstables.
+    std::priority_queue<dht::token, std::vector<dht::token>, std::greater<dht::token>> open_ends;
+    size_t max_overlap = 0;
+    dht::token max_overlap_token;
+    for (auto& sst : sorted) {
+        auto first = first_token(sst);
+        while (!open_ends.empty() && open_ends.top() < first) {
+            open_ends.pop();
+        }
+        open_ends.push(last_token(sst));
+        if (open_ends.size() > max_overlap) {
+            max_overlap = open_ends.size();
+            max_overlap_token = first;
+        }
+    }
+
+    auto contains_token = [&] (const shared_sstable& sst) {
+        return first_token(sst) <= max_overlap_token && max_overlap_token <= last_token(sst);
+    };
+    auto boundary = std::ranges::stable_partition(sorted, contains_token).begin();
+    if (boundary == sorted.begin()) {
+        return {};
+    }
+
+    // The sstables containing the token have to be compacted together to reduce the
+    // read amplification around it, and the others overlapping their range would only
+    // be merged with their output later, so they are worth compacting in the same round.
+    auto range_first = std::ranges::min(std::ranges::subrange(sorted.begin(), boundary) | std::views::transform(first_token));
+    auto range_last = std::ranges::max(std::ranges::subrange(sorted.begin(), boundary) | std::views::transform(last_token));
+    sorted.erase(std::remove_if(boundary, sorted.end(), [&] (const shared_sstable& sst) {
+        return range_last < first_token(sst) || last_token(sst) < range_first;
+    }), sorted.end());
+    return overlapping_set{std::move(sorted), max_overlap};
+}
+
+std::vector<shared_sstable> unified_compaction_strategy::trim(overlapping_set set, size_t max_sstables) {
+    auto& sstables = set.sstables;
+    if (sstables.size() > max_sstables) {
+        // The remaining sstables will be picked up by the next rounds.
+        auto by_size = [&] (auto first, auto middle, auto last) {
+            std::partial_sort(first, middle, last, [] (const shared_sstable& a, const shared_sstable& b) {
+                return a->data_size() < b->data_size();
+            });
+        };
+        if (set.overlap >= max_sstables) {
+            by_size(sstables.begin(), sstables.begin() + max_sstables, sstables.begin() + set.overlap);
+        } else {
+            by_size(sstables.begin() + set.overlap, sstables.begin() + max_sstables, sstables.end());
+        }
+        sstables.resize(max_sstables);
+    }
+    return std::move(sstables);
+}
+
+unsigned unified_compaction_strategy::threshold(table_state& table_s, unsigned level) const noexcept {
+    auto threshold = _options.threshold(level);
+    if (table_s.compaction_enforce_min_threshold()) {
+        threshold = std::max(threshold, table_s.min_compaction_threshold());
+    }
+    return threshold;
+}
+
+compaction_descriptor
+unified_compaction_strategy::make_descriptor(std::vector<shared_sstable> sstables, const density_calculator& densities) const {
+    auto shards = _options.shard_count(densities.density(sstables));
+    auto max_sstable_bytes = compaction_descriptor::default_max_sstable_bytes;
+    if (shards > 1) {
+        auto total_bytes = std::ranges::fold_left(sstables | std::views::transform(std::mem_fn(&sstable::data_size)), uint64_t(0), std::plus{});
+        max_sstable_bytes = std::max<uint64_t>(1, (total_bytes + shards - 1) / shards);
+    }
+    return compaction_descriptor(std::move(sstables), 0, max_sstable_bytes);
+}
+
+compaction_descriptor
+unified_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control) {
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto candidates = control.candidates(table_s);
+    density_calculator densities(*table_s.main_sstable_set().all());
+    auto levels = get_levels(candidates, densities, _options);
+
+    // Pick the level with most overlapping sstables, as it is the one amplifying reads
+    // the most. On ties the lower level is picked, as it is cheaper to compact.
+    overlapping_set selected;
+    unsigned selected_level = 0;
+    for (unsigned level = 0; level < levels.size(); level++) {
+        auto overlapping = max_overlapping_set(levels[level]);
+        if (overlapping.overlap >= threshold(table_s, level) && overlapping.overlap > selected.overlap) {
+            selected = std::move(overlapping);
+            selected_level = level;
+        }
+    }
+
+    if (selected.overlap) {
+        clogger.debug("UCS: compacting {} sstables of level {} overlapping up to {} deep for {}.{}", std::min(selected.sstables.size(), max_threshold),
+                selected_level, selected.overlap, table_s.schema()->ks_name(), table_s.schema()->cf_name());
+        return make_descriptor(trim(std::move(selected), max_threshold), densities);
+    }
+
+    if (!table_s.tombstone_gc_enabled()) {
+        return compaction_descriptor();
+    }
+
+    // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
+    // ratio is greater than threshold.
+    // prefer oldest sstables from the highest levels because they will be easier to satisfy conditions for
+    // tombstone purge, i.e. less likely to shadow even older data.
+    auto compaction_time = gc_clock::now();
+    for (auto& level : levels | std::views::reverse) {
+        std::erase_if(level, [this, compaction_time, &table_s] (const shared_sstable& sst) {
+            return !worth_dropping_tombstones(sst, compaction_time, table_s);
+        });
+        if (level.empty()) {
+            continue;
+        }
+        auto it = std::ranges::min_element(level, std::less<api::timestamp_type>(), [] (const shared_sstable& sst) {
+            return sst->get_stats_metadata().min_timestamp;
+        });
+        return make_descriptor({ *it }, densities);
+    }
+    return compaction_descriptor();
+}
+
+compaction_descriptor
+unified_compaction_strategy::get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
+    if (candidates.empty()) {
+        return compaction_descriptor();
+    }
+    density_calculator densities(candidates);
+    auto desc = make_descriptor(std::move(candidates), densities);
+    return make_major_compaction_job(std::move(desc.sstables), 0, desc.max_sstable_bytes);
+}
+
+int64_t unified_compaction_strategy::estimated_pending_compactions(table_state& table_s) const {
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto all = *table_s.main_sstable_set().all() | std::ranges::to<std::vector>();
+    density_calculator densities(all);
+    int64_t n = 0;
+
+    auto levels = get_levels(all, densities, _options);
+    for (unsigned level = 0; level < levels.size(); level++) {
+        auto overlapping = max_overlapping_set(levels[level]);
+        if (overlapping.overlap >= threshold(table_s, level)) {
+            n += (overlapping.sstables.size() + max_threshold - 1) / max_threshold;
+        }
+    }
+    return n;
+}
+
+compaction_descriptor
+unified_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const {
+    auto mode = cfg.mode;
+    size_t offstrategy_threshold = std::max(schema->min_compaction_threshold(), 4);
+    size_t max_sstables = std::max(schema->max_compaction_threshold(), int(offstrategy_threshold));
+
+    if (mode == reshape_mode::relaxed) {
+        offstrategy_threshold = max_sstables;
+    }
+
+    density_calculator densities(input);
+    auto levels = get_levels(input, densities, _options);
+    for (unsigned level = 0; level < levels.size(); level++) {
+        auto overlapping = max_overlapping_set(levels[level]);
+        if (overlapping.overlap >= std::max(offstrategy_threshold, size_t(_options.threshold(level)))) {
+            auto desc = make_descriptor(trim(std::move(overlapping), max_sstables), densities);
+            desc.options = compaction_type_options::make_reshape();
+            return desc;
+        }
+    }
+
+    return compaction_descriptor();
+}
+
+std::unique_ptr<sstable_set_impl> unified_compaction_strategy::make_sstable_set(schema_ptr schema) const {
+    return std::make_unique<partitioned_sstable_set>(std::move(schema), false);
+}
+
+unified_compaction_strategy::unified_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _options(options)
+{
+}
+
+// options is a map of compaction strategy options and their values.
+// unchecked_options is an analogical map from which already checked options are deleted.
+// This helps making sure that only allowed options are being set.
+void unified_compaction_strategy::validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    unified_compaction_strategy_options::validate(options, unchecked_options);
+}
+
+}
+
+// Backlog for one SSTable under UCS, built like the size-tiered one (see size_tiered_backlog_tracker.hh):
+//
+//   Bi = Ei * (R(T) - R(Di)),
+//
+// where Ei is the effective size of the SSTable, Di its density and T the total size of the
+// table. R(d) is the number of times a byte is expected to be rewritten until it reaches
+// density d, see unified_compaction_strategy_options::rewrite_cost(). Only the SSTables of
+// levels which currently need compaction contribute to the backlog.
+//
+// With S = Sum { Si } and C = Sum { Ci } over the contributing SSTables, the aggregate backlog is
+//
+//   A = (S - C) * R(T) - (Sum { Si * R(Di) } - Sum { Ci * R(Di) }),
+//
+// so only the SSTables being compacted need to be visited when computing it.
+class unified_backlog_tracker final : public compaction_backlog_tracker::impl {
+    using strategy = sstables::unified_compaction_strategy;
+
+    struct sstables_backlog_contribution {
+        uint64_t bytes = 0;
+        double value = 0;
+        // The rewrite cost of each contributing SSTable.
+        std::unordered_map<sstables::shared_sstable, double> costs;
+    };
+
+    sstables::unified_compaction_strategy_options _options;
+    uint64_t _total_bytes = 0;
+    sstables_backlog_contribution _contrib;
+    std::unordered_set<sstables::shared_sstable> _all;
+
+    sstables_backlog_contribution calculate_sstables_backlog_contribution(const std::vector<sstables::shared_sstable>& all) const {
+        sstables_backlog_contribution contrib;
+        strategy::density_calculator densities(all);
+        auto levels = strategy::get_levels(all, densities, _options);
+        for (unsigned level = 0; level < levels.size(); level++) {
+            if (strategy::max_overlapping_set(levels[level]).overlap < _options.threshold(level)) {
+                continue;
+            }
+            for (auto& sst : levels[level]) {
+                auto cost = _options.rewrite_cost(densities.density(sst));
+                contrib.bytes += sst->data_size();
+                contrib.value += sst->data_size() * cost;
+                contrib.costs.emplace(sst, cost);
+            }
+        }
+        return contrib;
+    }
+public:
+    explicit unified_backlog_tracker(sstables::unified_compaction_strategy_options options) : _options(std::move(options)) {}
+
+    virtual double backlog(const compaction_backlog_tracker::ongoing_writes& ow, const compaction_backlog_tracker::ongoing_compactions& oc) const override {
+        uint64_t compacted_bytes = 0;
+        double compacted_value = 0;
+        for (auto const& [sst, rp] : oc) {
+            auto it = _contrib.costs.find(sst);
+            if (it == _contrib.costs.end()) {
+                continue;
+            }
+            auto compacted = rp->compacted();
+            compacted_bytes += compacted;
+            compacted_value += compacted * it->second;
+        }
+        // Bail out if effective backlog is zero, which happens in a small window where ongoing compaction exhausted
+        // input files but is still sealing output files or doing managerial stuff like updating history table
+        if (_contrib.bytes <= compacted_bytes) {
+            return 0;
+        }
+        auto b = (_contrib.bytes - compacted_bytes) * _options.rewrite_cost(_total_bytes) - (_contrib.value - compacted_value);
+        return b > 0 ? b : 0;
+    }
+
+    // Provides strong exception safety guarantees.
+    virtual void replace_sstables(const std::vector<sstables::shared_sstable>& old_ssts, const std::vector<sstables::shared_sstable>& new_ssts) override {
+        auto tmp_all = _all;
+        auto tmp_total_bytes = _total_bytes;
+        tmp_all.reserve(_all.size() + new_ssts.size());
+
+        for (auto& sst : old_ssts) {
+            if (sst->data_size() > 0 && tmp_all.erase(sst)) {
+                tmp_total_bytes -= sst->data_size();
+            }
+        }
+        for (auto& sst : new_ssts) {
+            if (sst->data_size() > 0 && tmp_all.insert(sst).second) {
+                tmp_total_bytes += sst->data_size();
+            }
+        }
+        auto tmp_contrib = calculate_sstables_backlog_contribution(tmp_all | std::ranges::to<std::vector>());
+
+        std::invoke([&] () noexcept {
+            _all = std::move(tmp_all);
+            _total_bytes = tmp_total_bytes;
+            _contrib = std::move(tmp_contrib);
+        });
+    }
+};
+
+namespace sstables {
+
+std::unique_ptr<compaction_backlog_tracker::impl> unified_compaction_strategy::make_backlog_tracker() const {
+    return std::make_unique<unified_backlog_tracker>(_options);
+}
+
+}
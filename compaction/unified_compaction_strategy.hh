@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include "compaction_strategy_impl.hh"
+#include "sstables/shared_sstable.hh"
+
+class unified_backlog_tracker;
+
+namespace sstables {
+
+// The unified compaction strategy (UCS) groups sstables into levels by their density,
+// i.e. their size divided by the fraction of the token range they cover, and compacts
+// sstables of the same level once enough of them overlap.
+//
+// Each level has a scaling parameter W, which moves the strategy continuously between
+// leveled (W < 0) and tiered (W > 0) behaviour:
+//
+//   fanout(W) = 2 + |W|,
+//   threshold(W) = W < 0 ? 2 : fanout(W),
+//
+// where fanout is the ratio between the density bounds of consecutive levels, and
+// threshold is the number of overlapping sstables that triggers a compaction in the level.
+// W can be given as an integer, or as T<n> (tiered with fanout n), L<n> (leveled with
+// fanout n) or N (W = 0).
+class unified_compaction_strategy_options {
+public:
+    static constexpr auto DEFAULT_SCALING_PARAMETERS = "T4";
+    static constexpr uint64_t DEFAULT_TARGET_SSTABLE_SIZE_IN_MB = 1024;
+    static constexpr uint64_t DEFAULT_MIN_SSTABLE_SIZE_IN_MB = 100;
+    static constexpr unsigned DEFAULT_BASE_SHARD_COUNT = 4;
+    static constexpr auto SCALING_PARAMETERS_KEY = "scaling_parameters";
+    static constexpr auto TARGET_SSTABLE_SIZE_KEY = "target_sstable_size_in_mb";
+    static constexpr auto MIN_SSTABLE_SIZE_KEY = "min_sstable_size_in_mb";
+    static constexpr auto BASE_SHARD_COUNT_KEY = "base_shard_count";
+private:
+    // One parameter per level, the last one applies to all the levels above.
+    std::vector<int> scaling_parameters = { 2 };
+    uint64_t target_sstable_size = DEFAULT_TARGET_SSTABLE_SIZE_IN_MB * 1024 * 1024;
+    uint64_t min_sstable_size = DEFAULT_MIN_SSTABLE_SIZE_IN_MB * 1024 * 1024;
+    unsigned base_shard_count = DEFAULT_BASE_SHARD_COUNT;
+public:
+    unified_compaction_strategy_options(const std::map<sstring, sstring>& options);
+    unified_compaction_strategy_options() = default;
+
+    static void validate(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
+
+    int scaling_parameter(unsigned level) const noexcept;
+    unsigned fanout(unsigned level) const noexcept;
+    unsigned threshold(unsigned level) const noexcept;
+
+    // Level of sstables of the given density. Level 0 holds all the densities
+    // below min_sstable_size * fanout(0).
+    unsigned level_for(double density) const noexcept;
+
+    // Number of times a byte is expected to be rewritten until it reaches the
+    // given density: one rewrite per tiered level and fanout/2 per leveled one.
+    double rewrite_cost(double density) const noexcept;
+
+    // Number of sstables a compaction output of the given density is split into,
+    // so that each of them is about target_sstable_size. It is a power of two
+    // multiple of base_shard_count, or a power of two below it for small outputs,
+    // so that the outputs of different compactions share their boundaries.
+    unsigned shard_count(double density) const noexcept;
+
+    friend class unified_compaction_strategy;
+};
+
+class unified_compaction_strategy : public compaction_strategy_impl {
+    unified_compaction_strategy_options _options;
+
+    // Computes sstable densities relative to the token range spanned by a set of sstables.
+    class density_calculator;
+
+    // Groups the sstables into levels by density, sstables of level i are at index i.
+    static std::vector<std::vector<shared_sstable>> get_levels(const std::vector<shared_sstable>& sstables,
+            const density_calculator& densities, const unified_compaction_strategy_options& options);
+
+    struct overlapping_set {
+        // The sstables containing the token contained by most sstables, followed by the
+        // other sstables overlapping the token range spanned by the former.
+        std::vector<shared_sstable> sstables;
+        // The number of sstables containing that token, i.e. the read amplification of the set.
+        size_t overlap = 0;
+    };
+
+    // Returns the sstables overlapping the range around the most overlapped token.
+    static overlapping_set max_overlapping_set(const std::vector<shared_sstable>& sstables);
+
+    // Trims the set to at most max_sstables sstables, keeping the ones containing the
+    // most overlapped token first, and the smallest ones among the rest.
+    static std::vector<shared_sstable> trim(overlapping_set set, size_t max_sstables);
+
+    // Number of overlapping sstables which triggers a compaction of the given level.
+    // When compaction_enforce_min_threshold is set, it is at least the table's min_threshold.
+    unsigned threshold(table_state& table_s, unsigned level) const noexcept;
+
+    // Returns a descriptor which splits the output of the given sstables according to
+    // the density of the result, see unified_compaction_strategy_options::shard_count().
+    compaction_descriptor make_descriptor(std::vector<shared_sstable> sstables, const density_calculator& densities) const;
+public:
+    unified_compaction_strategy() = default;
+
+    unified_compaction_strategy(const std::map<sstring, sstring>& options);
+
+    static void validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
+
+    virtual compaction_descriptor get_sstables_for_compaction(table_state& table_s, strategy_control& control) override;
+
+    virtual compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual int64_t estimated_pending_compactions(table_state& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::unified;
+    }
+
+    virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const override;
+
+    virtual std::unique_ptr<sstable_set_impl> make_sstable_set(schema_ptr schema) const override;
+
+    friend class ::unified_backlog_tracker;
+};
+
+}
@@ -451,6 +451,7 @@ scylla_tests = set([
     'test/boost/anchorless_list_test',
     'test/boost/auth_passwords_test',
     'test/boost/auth_resource_test',
+    'test/boost/backlog_controller_test',
     'test/boost/big_decimal_test',
     'test/boost/bloom_filter_test',
     'test/boost/bptree_test',
@@ -845,6 +846,7 @@ scylla_core = (['message/messaging_service.cc',
                 'compaction/compaction_manager.cc',
                 'compaction/incremental_compaction_strategy.cc',
                 'compaction/incremental_backlog_tracker.cc',
+                'compaction/unified_compaction_strategy.cc',
                 'sstables/integrity_checked_file_impl.cc',
                 'sstables/prepended_input_stream.cc',
                 'sstables/m_format_read_helpers.cc',
@@ -1356,6 +1358,7 @@ scylla_tools = ['tools/scylla-local-file-key-generator.cc',
                 'tools/utils.cc',
                 'tools/lua_sstable_consumer.cc']
 scylla_perfs = ['test/perf/perf_alternator.cc',
+                'test/perf/perf_compaction_strategy.cc',
                 'test/perf/perf_fast_forward.cc',
                 'test/perf/perf_row_cache_update.cc',
                 'test/perf/perf_simple_query.cc',
@@ -902,7 +902,7 @@ typeColumns[create_type_statement& expr]
 
 
 /**
- * CREATE INDEX [IF NOT EXISTS] [indexName] ON <columnFamily> (<columnName>);
+ * CREATE INDEX [IF NOT EXISTS] [indexName] ON <columnFamily> (<columnName>) [INCLUDE (<columnName>, ...)];
  * CREATE CUSTOM INDEX [IF NOT EXISTS] [indexName] ON <columnFamily> (<columnName>) USING <indexClass>;
  */
 createIndexStatement returns [std::unique_ptr<create_index_statement> expr]
@@ -911,12 +911,14 @@ createIndexStatement returns [std::unique_ptr<create_index_statement> expr]
         bool if_not_exists = false;
         auto name = ::make_shared<cql3::index_name>();
         std::vector<::shared_ptr<index_target::raw>> targets;
+        std::vector<::shared_ptr<cql3::column_identifier::raw>> included_columns;
     }
     : K_CREATE (K_CUSTOM { props->is_custom = true; })? K_INDEX (K_IF K_NOT K_EXISTS { if_not_exists = true; } )?
         (idxName[*name])? K_ON cf=columnFamilyName '(' (target1=indexIdent { targets.emplace_back(target1); } (',' target2=indexIdent { targets.emplace_back(target2); } )*)? ')'
+        (K_INCLUDE '(' c1=cident { included_columns.push_back(c1); } (',' cn=cident { included_columns.push_back(cn); } )* ')')?
         (K_USING cls=STRING_LITERAL { props->custom_class = sstring{$cls.text}; })?
         (K_WITH properties[*props])?
-      { $expr = std::make_unique<create_index_statement>(cf, name, targets, props, if_not_exists); }
+      { $expr = std::make_unique<create_index_statement>(cf, name, targets, std::move(included_columns), props, if_not_exists); }
     ;
 
 indexIdent returns [::shared_ptr<index_target::raw> id]
@@ -2138,6 +2140,7 @@ basic_unreserved_keyword returns [sstring str]
         | K_EXECUTE
         | K_MUTATION_FRAGMENTS
         | K_EFFECTIVE
+        | K_INCLUDE
         ) { $str = $k.text; }
     ;
 
@@ -2352,6 +2355,8 @@ K_EXECUTE:     E X E C U T E;
 
 K_MUTATION_FRAGMENTS:    M U T A T I O N '_' F R A G M E N T S;
 
+K_INCLUDE:     I N C L U D E;
+
 // Case-insensitive alpha characters
 fragment A: ('a'|'A');
 fragment B: ('b'|'B');
@@ -22,6 +22,7 @@
 #include "first_function.hh"
 #include "exceptions/exceptions.hh"
 #include "utils/multiprecision_int.hh"
+#include <seastar/core/byteorder.hh>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -95,6 +96,34 @@ class internal_scalar_function : public scalar_function {
     }
 };
 
+class internal_batch_aggregation_function : public internal_scalar_function, public batch_aggregation_function {
+public:
+    using batch_func = noncopyable_function<bytes_opt (bytes_opt state, const aggregation_batch& batch)>;
+private:
+    input_kind _input_kind;
+    batch_func _batch_func;
+public:
+    internal_batch_aggregation_function(
+            sstring name,
+            data_type return_type,
+            std::vector<data_type> arg_types,
+            noncopyable_function<bytes_opt (std::span<const bytes_opt> parameters)> func,
+            input_kind kind,
+            batch_func bfunc)
+            : internal_scalar_function(std::move(name), std::move(return_type), std::move(arg_types), std::move(func))
+            , _input_kind(kind)
+            , _batch_func(std::move(bfunc)) {
+    }
+
+    virtual input_kind batch_input_kind() const override {
+        return _input_kind;
+    }
+
+    virtual bytes_opt aggregate_batch(bytes_opt state, const aggregation_batch& batch) const override {
+        return _batch_func(std::move(state), batch);
+    }
+};
+
 // Called if any of the inputs is NULL
 using null_handler = bytes_opt (*)(std::span<const bytes_opt>);
 
@@ -145,6 +174,28 @@ make_internal_scalar_function(sstring name, null_handler nullhandler, Lambda fun
     return make_internal_scalar_function(std::move(name), nullhandler, +func);
 }
 
+template <typename Ret, typename... Args>
+shared_ptr<scalar_function>
+make_internal_batch_aggregation_function(sstring name, null_handler nullhandler, Ret (*func)(Args...),
+        batch_aggregation_function::input_kind kind, internal_batch_aggregation_function::batch_func bfunc) {
+    return ::make_shared<internal_batch_aggregation_function>(
+            std::move(name),
+            data_type_for<Ret>(),
+            std::vector({data_type_for<Args>()...}),
+            wrap_function_autonull(nullhandler, func),
+            kind,
+            std::move(bfunc)
+    );
+}
+
+template <typename Lambda>
+requires std::is_class_v<Lambda>
+shared_ptr<scalar_function>
+make_internal_batch_aggregation_function(sstring name, null_handler nullhandler, Lambda func,
+        batch_aggregation_function::input_kind kind, internal_batch_aggregation_function::batch_func bfunc) {
+    return make_internal_batch_aggregation_function(std::move(name), nullhandler, +func, kind, std::move(bfunc));
+}
+
 template<typename NarrowT, typename WideT>
 NarrowT
 narrow(WideT acc) {
@@ -166,6 +217,65 @@ narrow(WideT acc) {
 template <typename T>
 using accumulator_for = std::conditional_t<std::is_integral_v<T>, utils::multiprecision_int, T>;
 
+template <typename Type>
+constexpr batch_aggregation_function::input_kind batch_input_kind_for() {
+    return std::is_integral_v<Type> ? batch_aggregation_function::input_kind::integer : batch_aggregation_function::input_kind::floating_point;
+}
+
+// Adds the inputs of the batch to the accumulator, with the same result as
+// adding them one at a time.
+template <typename Type>
+requires std::is_arithmetic_v<Type>
+accumulator_for<Type> add_batch(accumulator_for<Type> acc, const aggregation_batch& batch) {
+    if constexpr (std::is_integral_v<Type>) {
+        int64_t sum = 0;
+        if constexpr (sizeof(Type) < sizeof(int64_t)) {
+            // Narrower integers can't overflow int64_t in any batch we can
+            // hold in memory, so this loop can be vectorized.
+            for (auto v : batch.integers) {
+                sum += v;
+            }
+        } else {
+            for (auto v : batch.integers) {
+                int64_t next;
+                if (__builtin_add_overflow(sum, v, &next)) {
+                    acc += sum;
+                    next = v;
+                }
+                sum = next;
+            }
+        }
+        acc += sum;
+    } else {
+        // Floating-point addition is not associative, so the inputs are added
+        // in order, to match the result of the row-by-row aggregation.
+        for (auto v : batch.floating_points) {
+            acc += static_cast<Type>(v);
+        }
+    }
+    return acc;
+}
+
+template <typename Type>
+static
+shared_ptr<scalar_function>
+make_sum_step() {
+    using Acc = accumulator_for<Type>;
+    auto step = [] (Acc acc, Type addend) -> Acc { return acc + addend; };
+    if constexpr (std::is_arithmetic_v<Type>) {
+        return make_internal_batch_aggregation_function("sum_step", return_accumulator_on_null, step, batch_input_kind_for<Type>(),
+                [] (bytes_opt state, const aggregation_batch& batch) -> bytes_opt {
+                    if (!state) {
+                        return state;
+                    }
+                    auto acc = value_cast<Acc>(data_type_for<Acc>()->deserialize(*state));
+                    return data_type_for<Acc>()->decompose(add_batch<Type>(std::move(acc), batch));
+                });
+    } else {
+        return make_internal_scalar_function("sum_step", return_accumulator_on_null, step);
+    }
+}
+
 template <typename Type>
 static
 shared_ptr<aggregate_function>
@@ -178,7 +288,7 @@ make_sum_function() {
             .result_type = data_type_for<Type>(),
             .argument_types = {data_type_for<Type>()},
             .initial_state = data_type_for<accumulator_for<Type>>()->decompose(Acc(0)),
-            .aggregation_function = make_internal_scalar_function("sum_step", return_accumulator_on_null, [] (Acc acc, Type addend) -> Acc { return acc + addend; }),
+            .aggregation_function = make_sum_step<Type>(),
             .state_to_result_function = make_internal_scalar_function("sum_finalizer", return_any_nonnull, [] (Acc acc) -> Type { return narrow<Type>(acc); }),
             .state_reduction_function = make_internal_scalar_function("sum_reducer", return_any_nonnull, [] (Acc a1, Acc a2) -> Acc { return a1 + a2; }),
         }
@@ -200,6 +310,49 @@ class impl_div_for_avg<big_decimal> {
         return x.div(y, big_decimal::rounding_mode::HALF_EVEN);
     }
 };
+template <typename Type>
+static
+shared_ptr<scalar_function>
+make_avg_step(data_type accumulator_tuple_type) {
+    using sum_type = accumulator_for<Type>;
+    auto step = [accumulator_tuple_type] (std::span<const bytes_opt> args) -> bytes_opt {
+        if (!args[0]) {
+            return std::nullopt;
+        }
+        if (!args[1]) {
+            return args[0];
+        }
+        data_value acc_value = accumulator_tuple_type->deserialize(*args[0]);
+        std::vector<data_value> acc = value_cast<tuple_type_impl::native_type>(std::move(acc_value));
+        auto sum = value_cast<sum_type>(acc[0]);
+        auto count = value_cast<int64_t>(acc[1]);
+        auto input = value_cast<Type>(data_type_for<Type>()->deserialize(*args[1]));
+        sum += input;
+        count += 1;
+        acc[0] = data_value(std::move(sum));
+        acc[1] = data_value(count);
+        return make_tuple_value(accumulator_tuple_type, acc).serialize();
+    };
+    auto arg_types = std::vector<data_type>({accumulator_tuple_type, data_type_for<Type>()});
+    if constexpr (std::is_arithmetic_v<Type>) {
+        return ::make_shared<internal_batch_aggregation_function>("avg_step", accumulator_tuple_type, std::move(arg_types), std::move(step), batch_input_kind_for<Type>(),
+                [accumulator_tuple_type] (bytes_opt state, const aggregation_batch& batch) -> bytes_opt {
+                    if (!state) {
+                        return std::nullopt;
+                    }
+                    data_value acc_value = accumulator_tuple_type->deserialize(*state);
+                    std::vector<data_value> acc = value_cast<tuple_type_impl::native_type>(std::move(acc_value));
+                    auto sum = value_cast<sum_type>(acc[0]);
+                    auto count = value_cast<int64_t>(acc[1]);
+                    acc[0] = data_value(add_batch<Type>(std::move(sum), batch));
+                    acc[1] = data_value(count + int64_t(batch.size));
+                    return make_tuple_value(accumulator_tuple_type, acc).serialize();
+                });
+    } else {
+        return ::make_shared<internal_scalar_function>("avg_step", accumulator_tuple_type, std::move(arg_types), std::move(step));
+    }
+}
+
 template <typename Type>
 static
 shared_ptr<aggregate_function>
@@ -213,28 +366,7 @@ make_avg_function() {
             .result_type = data_type_for<Type>(),
             .argument_types = {data_type_for<Type>()},
             .initial_state = make_tuple_value(accumulator_tuple_type, std::vector({data_value(sum_type(0)), data_value(int64_t(0))})).serialize(),
-            .aggregation_function = ::make_shared<internal_scalar_function>(
-                    "avg_step",
-                    accumulator_tuple_type,
-                    std::vector<data_type>({accumulator_tuple_type, data_type_for<Type>()}),
-                    [accumulator_tuple_type] (std::span<const bytes_opt> args) -> bytes_opt {
-                        if (!args[0]) {
-                            return std::nullopt;
-                        }
-                        if (!args[1]) {
-                            return args[0];
-                        }
-                        data_value acc_value = accumulator_tuple_type->deserialize(*args[0]);
-                        std::vector<data_value> acc = value_cast<tuple_type_impl::native_type>(std::move(acc_value));
-                        auto sum = value_cast<sum_type>(acc[0]);
-                        auto count = value_cast<int64_t>(acc[1]);
-                        auto input = value_cast<Type>(data_type_for<Type>()->deserialize(*args[1]));
-                        sum += input;
-                        count += 1;
-                        acc[0] = data_value(std::move(sum));
-                        acc[1] = data_value(count);
-                        return make_tuple_value(accumulator_tuple_type, acc).serialize();
-                    }),
+            .aggregation_function = make_avg_step<Type>(accumulator_tuple_type),
             .state_to_result_function = ::make_shared<internal_scalar_function>(
                     "avg_finalizer",
                     data_type_for<Type>(),
@@ -292,8 +424,87 @@ struct aggregate_type_for<time_native_type> {
     using type = time_native_type::primary_type;
 };
 
+bytes_opt
+add_batch_size_to_count(bytes_opt state, const aggregation_batch& batch) {
+    if (!batch.size) {
+        return state;
+    }
+    auto count = value_cast<int64_t>(long_type->deserialize(*state));
+    return data_value(count + int64_t(batch.size)).serialize();
+}
+
+int64_t
+read_fixed_width_integer(bytes_view v) {
+    auto p = reinterpret_cast<const char*>(v.data());
+    switch (v.size()) {
+        case 1: return read_be<int8_t>(p);
+        case 2: return read_be<int16_t>(p);
+        case 4: return read_be<int32_t>(p);
+        case 8: return read_be<int64_t>(p);
+    }
+    throw std::runtime_error(format("Unexpected fixed-width integer size {}", v.size()));
+}
+
+bytes
+write_fixed_width_integer(int64_t value, size_t width) {
+    bytes b(bytes::initialized_later(), width);
+    auto p = reinterpret_cast<char*>(b.data());
+    switch (width) {
+        case 1: write_be<int8_t>(p, value); break;
+        case 2: write_be<int16_t>(p, value); break;
+        case 4: write_be<int32_t>(p, value); break;
+        case 8: write_be<int64_t>(p, value); break;
+    }
+    return b;
+}
+
+// Batch aggregation for min() and max() over fixed-width integers: `pick`
+// returns true if its first argument should replace the second one as the
+// state. An empty state sorts before all values.
+template <typename Pick>
+internal_batch_aggregation_function::batch_func
+make_min_max_batch(size_t width, bool empty_state_wins, Pick pick) {
+    return [width, empty_state_wins, pick] (bytes_opt state, const aggregation_batch& batch) -> bytes_opt {
+        if (batch.integers.empty()) {
+            return state;
+        }
+        auto candidate = *std::ranges::min_element(batch.integers, [&] (int64_t a, int64_t b) { return pick(a, b); });
+        if (state) {
+            if (state->size() != width) {
+                if (empty_state_wins) {
+                    return state;
+                }
+            } else if (!pick(candidate, read_fixed_width_integer(*state))) {
+                return state;
+            }
+        }
+        return write_fixed_width_integer(candidate, width);
+    };
+}
+
 } // anonymous namespace
 
+std::optional<size_t>
+aggregate_fcts::batch_integer_width(const abstract_type& type) {
+    switch (type.without_reversed().get_kind()) {
+        case abstract_type::kind::byte: return 1;
+        case abstract_type::kind::short_kind: return 2;
+        case abstract_type::kind::int32: return 4;
+        case abstract_type::kind::long_kind: return 8;
+        case abstract_type::kind::timestamp: return 8;
+        default: return std::nullopt;
+    }
+}
+
+std::optional<size_t>
+aggregate_fcts::batch_floating_point_width(const abstract_type& type) {
+    switch (type.without_reversed().get_kind()) {
+        case abstract_type::kind::float_kind: return 4;
+        case abstract_type::kind::double_kind: return 8;
+        default: return std::nullopt;
+    }
+}
+
 /**
  * Creates a COUNT function for the specified type.
  *
@@ -309,7 +520,7 @@ aggregate_fcts::make_count_function(data_type input_type) {
             .result_type = long_type,
             .argument_types = {input_type},
             .initial_state = data_value(int64_t(0)).serialize(),
-            .aggregation_function = ::make_shared<internal_scalar_function>(
+            .aggregation_function = ::make_shared<internal_batch_aggregation_function>(
                     "count_step",
                     long_type,
                     std::vector<data_type>({long_type, input_type}),
@@ -320,7 +531,9 @@ aggregate_fcts::make_count_function(data_type input_type) {
                         auto count = value_cast<int64_t>(long_type->deserialize(*args[0]));
                         count += 1;
                         return data_value(count).serialize();
-                    }),
+                    },
+                    batch_aggregation_function::input_kind::count,
+                    add_batch_size_to_count),
             .state_to_result_function = make_internal_scalar_function("count_finalizer", return_any_nonnull, [] (int64_t count) { return count; }),
             .state_reduction_function = make_internal_scalar_function("count_reducer", return_any_nonnull, [] (int64_t c1, int64_t c2) { return c1 + c2; }),
         });
@@ -411,9 +624,9 @@ aggregate_fcts::make_count_rows_function() {
             .result_type = long_type,
             .argument_types = {},
             .initial_state = data_value(int64_t(0)).serialize(),
-            .aggregation_function = make_internal_scalar_function("count_step", return_any_nonnull, [] (int64_t accumulator) {
+            .aggregation_function = make_internal_batch_aggregation_function("count_step", return_any_nonnull, [] (int64_t accumulator) {
                 return accumulator + 1;
-            }),
+            }, batch_aggregation_function::input_kind::count, add_batch_size_to_count),
             .state_to_result_function = make_internal_scalar_function("count_finalizer", return_any_nonnull, [] (int64_t accumulator) {
                 return accumulator;
             }),
@@ -427,7 +640,7 @@ aggregate_fcts::make_count_rows_function() {
 shared_ptr<aggregate_function>
 aggregate_fcts::make_max_function(data_type io_type) {
     io_type = io_type->without_reversed().shared_from_this();
-    auto max = ::make_shared<internal_scalar_function>("max_step", io_type, std::vector({io_type, io_type}), [io_type] (std::span<const bytes_opt> args) -> bytes_opt {
+    auto step = [io_type] (std::span<const bytes_opt> args) -> bytes_opt {
         if (!args[0]) {
             return args[1];
         }
@@ -435,7 +648,14 @@ aggregate_fcts::make_max_function(data_type io_type) {
             return args[0];
         }
         return std::max(*args[0], *args[1], io_type->as_less_comparator());
-    });
+    };
+    shared_ptr<scalar_function> max;
+    if (auto width = batch_integer_width(*io_type)) {
+        max = ::make_shared<internal_batch_aggregation_function>("max_step", io_type, std::vector({io_type, io_type}), std::move(step),
+                batch_aggregation_function::input_kind::integer, make_min_max_batch(*width, false, std::greater<int64_t>()));
+    } else {
+        max = ::make_shared<internal_scalar_function>("max_step", io_type, std::vector({io_type, io_type}), std::move(step));
+    }
     return ::make_shared<db::functions::aggregate_function>(
         db::functions::stateless_aggregate_function{
             .name = function_name::native_function("max"),
@@ -455,7 +675,7 @@ aggregate_fcts::make_max_function(data_type io_type) {
 shared_ptr<aggregate_function>
 aggregate_fcts::make_min_function(data_type io_type) {
     io_type = io_type->without_reversed().shared_from_this();
-    auto min = ::make_shared<internal_scalar_function>("min_step", io_type, std::vector({io_type, io_type}), [io_type] (std::span<const bytes_opt> args) -> bytes_opt {
+    auto step = [io_type] (std::span<const bytes_opt> args) -> bytes_opt {
         if (!args[0]) {
             return args[1];
         }
@@ -463,7 +683,14 @@ aggregate_fcts::make_min_function(data_type io_type) {
             return args[0];
         }
         return std::min(*args[0], *args[1], io_type->as_less_comparator());
-    });
+    };
+    shared_ptr<scalar_function> min;
+    if (auto width = batch_integer_width(*io_type)) {
+        min = ::make_shared<internal_batch_aggregation_function>("min_step", io_type, std::vector({io_type, io_type}), std::move(step),
+                batch_aggregation_function::input_kind::integer, make_min_max_batch(*width, true, std::less<int64_t>()));
+    } else {
+        min = ::make_shared<internal_scalar_function>("min_step", io_type, std::vector({io_type, io_type}), std::move(step));
+    }
     return ::make_shared<db::functions::aggregate_function>(
         db::functions::stateless_aggregate_function{
             .name = function_name::native_function("min"),
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "aggregate_function.hh"
+#include <span>
 
 namespace cql3 {
 namespace functions {
@@ -36,6 +37,45 @@ make_min_function(data_type io_type);
 /// count(col) function for the specified type
 shared_ptr<aggregate_function> make_count_function(data_type input_type);
 
+/// A batch of non-null inputs of an aggregate, decoded into native values.
+/// Depending on the input kind of the aggregation function, either `integers`
+/// or `floating_points` holds the values, or neither for counting aggregates.
+struct aggregation_batch {
+    size_t size = 0;
+    std::span<const int64_t> integers;
+    std::span<const double> floating_points;
+};
+
+/// Implemented by the aggregation functions of native aggregates which can
+/// aggregate a whole batch of inputs at once, instead of being evaluated for
+/// each input row. The caller decodes the inputs into column-oriented vectors
+/// of native values, which the aggregate folds into its state in tight loops.
+class batch_aggregation_function {
+public:
+    enum class input_kind {
+        // Only the number of non-null inputs matters.
+        count,
+        // Inputs are fixed-width integers, widened to int64_t.
+        integer,
+        // Inputs are floating-point numbers, widened to double.
+        floating_point,
+    };
+
+    virtual ~batch_aggregation_function() = default;
+    virtual input_kind batch_input_kind() const = 0;
+    /// Equivalent to executing the aggregation function for each input of
+    /// the batch, in order.
+    virtual bytes_opt aggregate_batch(bytes_opt state, const aggregation_batch& batch) const = 0;
+};
+
+/// The size of the serialized values of `type`, if they are fixed-width
+/// integers which can be batch aggregated as integer inputs.
+std::optional<size_t> batch_integer_width(const abstract_type& type);
+
+/// The size of the serialized values of `type`, if they are floating-point
+/// numbers which can be batch aggregated as floating-point inputs.
+std::optional<size_t> batch_floating_point_width(const abstract_type& type);
+
 }
 }
 }
@@ -366,6 +366,29 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             _cql_stats.secondary_index_rows_read,
                             sm::description("Counts the total number of rows read during CQL requests performed using secondary indexes.")).set_skip_when_empty(),
 
+                    sm::make_counter(
+                            "secondary_index_covered_reads",
+                            _cql_stats.secondary_index_covered_reads,
+                            sm::description("Counts the CQL requests performed using secondary indexes, which were answered from the index alone, "
+                                            "because it includes all the selected columns.")).set_skip_when_empty(),
+
+                    sm::make_counter(
+                            "secondary_index_base_fetch_batches",
+                            _cql_stats.secondary_index_base_fetch_batches,
+                            sm::description("Counts the batches of base table partitions read in parallel by CQL requests performed using secondary indexes. "
+                                            "Divide secondary_index_base_fetch_partitions by it to get the average fetch parallelism.")).set_skip_when_empty(),
+
+                    sm::make_counter(
+                            "secondary_index_base_fetch_partitions",
+                            _cql_stats.secondary_index_base_fetch_partitions,
+                            sm::description("Counts the base table partitions read by CQL requests performed using secondary indexes.")).set_skip_when_empty(),
+
+                    sm::make_counter(
+                            "secondary_index_base_fetch_merged_rows",
+                            _cql_stats.secondary_index_base_fetch_merged_rows,
+                            sm::description("Counts the index rows of CQL requests performed using secondary indexes, "
+                                            "whose base row was read together with other rows of the same base partition.")).set_skip_when_empty(),
+
                     // read requests that required ALLOW FILTERING
                     sm::make_counter(
                             "filtered_read_requests",
@@ -390,6 +413,18 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             [this]() {return _cql_stats.filtered_rows_read_total - _cql_stats.filtered_rows_matched_total;},
                             sm::description("Counts the number of rows read during CQL requests that required ALLOW FILTERING and dropped by the filter. Number similar to filtered_rows_read_total indicates that filtering is not accurate and might cause performance degradation.")).set_skip_when_empty(),
 
+                    sm::make_counter(
+                            "select_page_rows_limit",
+                            _cql_stats.select_page_rows_limit,
+                            sm::description("Counts the sum of the row limits of the pages of paged CQL SELECT requests. "
+                                            "Compare with select_page_rows_returned to get the page fill ratio.")).set_skip_when_empty(),
+
+                    sm::make_counter(
+                            "select_page_rows_returned",
+                            _cql_stats.select_page_rows_returned,
+                            sm::description("Counts the rows returned in the pages of paged CQL SELECT requests. "
+                                            "A low ratio to select_page_rows_limit means pages are mostly cut by size or time limits.")).set_skip_when_empty(),
+
                     sm::make_counter(
                             "select_bypass_caches",
                             _cql_stats.select_bypass_caches,
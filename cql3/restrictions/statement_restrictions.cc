@@ -1269,6 +1269,8 @@ statement_restrictions::statement_restrictions(data_dictionary::database db,
 
     _clustering_row_level_filter = expr::make_conjunction(std::move(_clustering_row_level_filter), std::move(multi_column_restrictions));
 
+    prepare_key_eq_values();
+
     if (uses_secondary_indexing()) {
         auto& index_opt = _idx_opt;
         if (!index_opt) {
@@ -1288,6 +1290,52 @@ statement_restrictions::statement_restrictions(data_dictionary::database db,
     }
 }
 
+namespace {
+
+/// Returns the RHS of e if e is a single EQ restriction on a column, or nullptr.
+const expr::expression* single_column_eq_rhs(const expr::expression& e) {
+    auto binop = expr::as_if<expr::binary_operator>(&e);
+    if (!binop || binop->op != expr::oper_t::EQ || !expr::is<expr::column_value>(binop->lhs)) {
+        return nullptr;
+    }
+    return &binop->rhs;
+}
+
+} // anonymous namespace
+
+void statement_restrictions::prepare_key_eq_values() {
+    if (_partition_range_is_simple && !_partition_range_restrictions.empty()
+            && !has_partition_token(_partition_range_restrictions[0], *_schema)
+            && _partition_range_restrictions.size() == _schema->partition_key_size()) {
+        std::vector<expr::expression> values(_schema->partition_key_size());
+        bool all_eq = true;
+        for (const auto& e : _partition_range_restrictions) {
+            auto rhs = single_column_eq_rhs(e);
+            if (!rhs) {
+                all_eq = false;
+                break;
+            }
+            values[_schema->position(*expr::as<expr::column_value>(expr::as<expr::binary_operator>(e).lhs).col)] = *rhs;
+        }
+        if (all_eq) {
+            _partition_key_eq_values = std::move(values);
+        }
+    }
+
+    if (!_has_multi_column) {
+        std::vector<expr::expression> values;
+        values.reserve(_clustering_prefix_restrictions.size());
+        for (const auto& e : _clustering_prefix_restrictions) {
+            auto rhs = single_column_eq_rhs(e);
+            if (!rhs) {
+                return;
+            }
+            values.push_back(*rhs);
+        }
+        _clustering_prefix_eq_values = std::move(values);
+    }
+}
+
 bool
 statement_restrictions::clustering_key_restrictions_has_IN() const {
     return find(_clustering_columns_restrictions, expr::oper_t::IN);
@@ -1957,6 +2005,18 @@ dht::partition_range_vector statement_restrictions::get_partition_key_ranges(con
                     format("Unexpected size of token restrictions: {}", _partition_range_restrictions.size()));
         }
         return partition_ranges_from_token(_partition_range_restrictions[0], options, *_schema);
+    } else if (!_partition_key_eq_values.empty()) {
+        // A key lookup: the restrictions were reduced to the bound values at prepare time.
+        std::vector<managed_bytes> pk_value;
+        pk_value.reserve(_partition_key_eq_values.size());
+        for (const auto& rhs : _partition_key_eq_values) {
+            auto val = expr::evaluate(rhs, options).to_managed_bytes_opt();
+            if (!val) {
+                return {}; // All NULL comparisons fail; no partition matches.
+            }
+            pk_value.push_back(std::move(*val));
+        }
+        return {range_from_bytes(*_schema, pk_value)};
     } else if (_partition_range_is_simple) {
         // Special case to avoid extra allocations required for a Cartesian product.
         return partition_ranges_from_EQs(_partition_range_restrictions, options, *_schema);
@@ -2587,6 +2647,19 @@ std::vector<query::clustering_range> statement_restrictions::get_clustering_boun
     if (_clustering_prefix_restrictions.empty()) {
         return {query::clustering_range::make_open_ended_both_sides()};
     }
+    if (!_clustering_prefix_eq_values.empty()) {
+        // Each prefix column is restricted by a single EQ, so the bounds are the prefix itself.
+        std::vector<managed_bytes> prefix;
+        prefix.reserve(_clustering_prefix_eq_values.size());
+        for (const auto& rhs : _clustering_prefix_eq_values) {
+            auto val = expr::evaluate(rhs, options).to_managed_bytes_opt();
+            if (!val) {
+                return {}; // Impossible condition -- no rows can possibly match.
+            }
+            prefix.push_back(std::move(*val));
+        }
+        return {query::clustering_range::make_singular(clustering_key_prefix::from_exploded(std::move(prefix)))};
+    }
     if (find_binop(_clustering_prefix_restrictions[0], is_multi_column)) {
         bool all_natural = true, all_reverse = true; ///< Whether column types are reversed or natural.
         for (auto& r : _clustering_prefix_restrictions) { // TODO: move to constructor, do only once.
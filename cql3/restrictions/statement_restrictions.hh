@@ -117,6 +117,14 @@ class statement_restrictions {
 
     bool _partition_range_is_simple; ///< False iff _partition_range_restrictions imply a Cartesian product.
 
+    /// Right-hand sides of the restrictions of the partition key columns, in schema order, if each
+    /// partition key column is restricted by exactly one EQ.  Empty otherwise.  Computed at prepare
+    /// time, so that a key lookup only needs to evaluate the bound values on each execution.
+    std::vector<expr::expression> _partition_key_eq_values;
+
+    /// Like _partition_key_eq_values, but for the columns of _clustering_prefix_restrictions.
+    std::vector<expr::expression> _clustering_prefix_eq_values;
+
 
     check_indexes _check_indexes = check_indexes::yes;
     std::vector<const column_definition*> _column_defs_for_filtering;
@@ -286,6 +294,9 @@ class statement_restrictions {
 
     void process_partition_key_restrictions(bool for_view, bool allow_filtering, statements::statement_type type);
 
+    /// Fills _partition_key_eq_values and _clustering_prefix_eq_values, if the key restrictions allow it.
+    void prepare_key_eq_values();
+
     /**
      * Processes the clustering column restrictions.
      *
@@ -11,6 +11,7 @@
 #include "selection/selection.hh"
 #include "stats.hh"
 #include "utils/buffer_view-to-managed_bytes_view.hh"
+#include "utils/small_vector.hh"
 
 namespace cql3 {
 class untyped_result_set;
@@ -23,11 +24,18 @@ class result_generator {
     cql_stats* _stats;
 private:
     friend class untyped_result_set;
+    // Feeds the cells of a query::result to the visitor in selection order,
+    // without materializing the rows. Key components are passed to the visitor
+    // as views into the keys handed out by query::result_view::consume(), so
+    // no per-row allocation happens here: the partition key lives until the
+    // end of the partition, the clustering key for the duration of accept_new_row().
     template<typename Visitor>
     class query_result_visitor {
+        using key_components = utils::small_vector<managed_bytes_view, 8>;
+
         const schema& _schema;
-        std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        key_components _partition_key;
+        key_components _clustering_key;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
@@ -45,8 +53,15 @@ class result_generator {
         query_result_visitor(const schema& s, Visitor& visitor, const selection::selection& select)
             : _schema(s), _visitor(visitor), _selection(select) { }
 
+        static void explode_into(key_components& components, const auto& key, const schema& s) {
+            components.clear();
+            for (managed_bytes_view c : key.components(s)) {
+                components.push_back(c);
+            }
+        }
+
         void accept_new_partition(const partition_key& key, uint64_t row_count) {
-            _partition_key = key.explode(_schema);
+            explode_into(_partition_key, key, _schema);
             accept_new_partition(row_count);
         }
         void accept_new_partition(uint64_t row_count) {
@@ -56,8 +71,9 @@ class result_generator {
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            explode_into(_clustering_key, key, _schema);
             accept_new_row(static_row, row);
+            _clustering_key.clear();
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
             auto static_row_iterator = static_row.iterator();
@@ -66,11 +82,11 @@ class result_generator {
             for (auto&& def : _selection.get_columns()) {
                 switch (def->kind) {
                 case column_kind::partition_key:
-                    _visitor.accept_value(bytes_view(_partition_key[def->component_index()]));
+                    _visitor.accept_value(managed_bytes_view_opt(_partition_key[def->component_index()]));
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(bytes_view(_clustering_key[def->component_index()]));
+                        _visitor.accept_value(managed_bytes_view_opt(_clustering_key[def->component_index()]));
                     } else {
                         _visitor.accept_value(std::nullopt);
                     }
@@ -93,7 +109,7 @@ class result_generator {
                 auto static_row_iterator = static_row.iterator();
                 for (auto&& def : _selection.get_columns()) {
                     if (def->is_partition_key()) {
-                        _visitor.accept_value(bytes_view(_partition_key[def->component_index()]));
+                        _visitor.accept_value(managed_bytes_view_opt(_partition_key[def->component_index()]));
                     } else if (def->is_static()) {
                         accept_cell_value(*def, static_row_iterator);
                     } else {
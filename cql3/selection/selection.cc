@@ -20,7 +20,9 @@
 #include "cql3/expr/expr-utils.hh"
 #include "cql3/functions/first_function.hh"
 #include "cql3/functions/aggregate_fcts.hh"
+#include "utils/fragment_range.hh"
 
+#include <bit>
 #include <ranges>
 
 namespace cql3 {
@@ -344,10 +346,159 @@ class selection_with_processing : public selection {
 protected:
     class selectors_with_processing : public selectors {
     private:
+        using batch_aggregation_function = functions::aggregate_fcts::batch_aggregation_function;
+
+        // An aggregate of the inner loop whose inputs are buffered and
+        // aggregated in batches, instead of being evaluated for each row.
+        struct batched_aggregate {
+            // Index of the aggregate in the inner loop and of its state in the temporaries.
+            size_t index;
+            const batch_aggregation_function* func;
+            batch_aggregation_function::input_kind kind;
+            // Index of the input column in the selection, or none for count(*).
+            std::optional<uint32_t> column;
+            // Size of the serialized input values, for integer and floating-point inputs.
+            size_t width = 0;
+            size_t size = 0;
+            std::vector<int64_t> integers;
+            std::vector<double> floating_points;
+        };
+
+        // Number of input rows buffered before the batches are aggregated.
+        static constexpr size_t batch_size = 1024;
+
         const selection_with_processing& _sel;
         std::vector<raw_value> _temporaries;
         bool _requires_thread;
         std::uint64_t _input_row_count;
+        std::vector<batched_aggregate> _batched;
+        // Indexes in the inner loop of the aggregates evaluated for each row.
+        std::vector<size_t> _unbatched;
+        size_t _buffered_rows = 0;
+
+        std::optional<batched_aggregate> make_batched_aggregate(size_t index) const {
+            auto fc = expr::as_if<expr::function_call>(&_sel._inner_loop[index]);
+            if (!fc) {
+                return std::nullopt;
+            }
+            auto fn = std::get_if<shared_ptr<functions::function>>(&fc->func);
+            auto batch_fn = fn ? dynamic_cast<const batch_aggregation_function*>(fn->get()) : nullptr;
+            if (!batch_fn || fc->args.empty()) {
+                return std::nullopt;
+            }
+            auto state = expr::as_if<expr::temporary>(&fc->args[0]);
+            if (!state || state->index != index) {
+                return std::nullopt;
+            }
+            auto kind = batch_fn->batch_input_kind();
+            if (fc->args.size() == 1) {
+                if (kind != batch_aggregation_function::input_kind::count) {
+                    return std::nullopt;
+                }
+                return batched_aggregate{.index = index, .func = batch_fn, .kind = kind};
+            }
+            auto col = fc->args.size() == 2 ? expr::as_if<expr::column_value>(&fc->args[1]) : nullptr;
+            if (!col || !(col->col->is_regular() || col->col->is_static())) {
+                return std::nullopt;
+            }
+            auto column = _sel.index_of(*col->col);
+            if (column < 0) {
+                return std::nullopt;
+            }
+            auto& arg_types = (*fn)->arg_types();
+            std::optional<size_t> width;
+            switch (kind) {
+            case batch_aggregation_function::input_kind::count:
+                width = 0;
+                break;
+            case batch_aggregation_function::input_kind::integer:
+                width = functions::aggregate_fcts::batch_integer_width(*col->col->type);
+                if (width != functions::aggregate_fcts::batch_integer_width(*arg_types[1])) {
+                    return std::nullopt;
+                }
+                break;
+            case batch_aggregation_function::input_kind::floating_point:
+                width = functions::aggregate_fcts::batch_floating_point_width(*col->col->type);
+                if (width != functions::aggregate_fcts::batch_floating_point_width(*arg_types[1])) {
+                    return std::nullopt;
+                }
+                break;
+            }
+            if (!width) {
+                return std::nullopt;
+            }
+            return batched_aggregate{.index = index, .func = batch_fn, .kind = kind, .column = uint32_t(column), .width = *width};
+        }
+
+        expr::evaluation_inputs make_inner_loop_inputs(result_set_builder& rs) {
+            return expr::evaluation_inputs{
+                    .partition_key = rs.current_partition_key,
+                    .clustering_key = rs.current_clustering_key,
+                    .static_and_regular_columns = rs.current,
+                    .selection = &_sel,
+                    .options = nullptr,
+                    .static_and_regular_timestamps = rs._timestamps,
+                    .static_and_regular_ttls = rs._ttls,
+                    .temporaries = _temporaries,
+            };
+        }
+
+        void flush_batch(batched_aggregate& b) {
+            if (!b.size) {
+                return;
+            }
+            auto batch = functions::aggregate_fcts::aggregation_batch{
+                .size = b.size,
+                .integers = b.integers,
+                .floating_points = b.floating_points,
+            };
+            auto state = std::move(_temporaries[b.index]).to_bytes_opt();
+            _temporaries[b.index] = raw_value::make_value(b.func->aggregate_batch(std::move(state), batch));
+            b.size = 0;
+            b.integers.clear();
+            b.floating_points.clear();
+        }
+
+        void flush_batches() {
+            for (auto& b : _batched) {
+                flush_batch(b);
+            }
+            _buffered_rows = 0;
+        }
+
+        // Appends the input of the current row to the batch. Returns false if
+        // the value doesn't have the expected size (e.g. it is an empty
+        // value), in which case it has to be aggregated on its own.
+        static bool buffer_input(batched_aggregate& b, const managed_bytes& value) {
+            managed_bytes_view v(value);
+            switch (b.kind) {
+            case batch_aggregation_function::input_kind::count:
+                break;
+            case batch_aggregation_function::input_kind::integer:
+                if (v.size_bytes() != b.width) {
+                    return false;
+                }
+                switch (b.width) {
+                case 1: b.integers.push_back(read_simple_exactly<int8_t>(v)); break;
+                case 2: b.integers.push_back(read_simple_exactly<int16_t>(v)); break;
+                case 4: b.integers.push_back(read_simple_exactly<int32_t>(v)); break;
+                default: b.integers.push_back(read_simple_exactly<int64_t>(v)); break;
+                }
+                break;
+            case batch_aggregation_function::input_kind::floating_point:
+                if (v.size_bytes() != b.width) {
+                    return false;
+                }
+                if (b.width == 4) {
+                    b.floating_points.push_back(std::bit_cast<float>(read_simple_exactly<int32_t>(v)));
+                } else {
+                    b.floating_points.push_back(std::bit_cast<double>(read_simple_exactly<int64_t>(v)));
+                }
+                break;
+            }
+            ++b.size;
+            return true;
+        }
     public:
         explicit selectors_with_processing(const selection_with_processing& sel)
             : _sel(sel)
@@ -358,7 +509,15 @@ class selection_with_processing : public selection {
                 });
              }))
             , _input_row_count(0)
-        { }
+        {
+            for (size_t i = 0; i != _sel._inner_loop.size(); ++i) {
+                if (auto b = make_batched_aggregate(i)) {
+                    _batched.push_back(std::move(*b));
+                } else {
+                    _unbatched.push_back(i);
+                }
+            }
+        }
 
         virtual bool requires_thread() const override {
             return _requires_thread;
@@ -367,6 +526,12 @@ class selection_with_processing : public selection {
         virtual void reset() override {
             _temporaries = _sel._initial_values_for_temporaries;
             _input_row_count = 0;
+            for (auto& b : _batched) {
+                b.size = 0;
+                b.integers.clear();
+                b.floating_points.clear();
+            }
+            _buffered_rows = 0;
         }
 
         virtual bool is_aggregate() const override {
@@ -394,6 +559,7 @@ class selection_with_processing : public selection {
         }
 
         virtual std::vector<managed_bytes_opt> get_output_row() override {
+            flush_batches();
             std::vector<managed_bytes_opt> output_row;
             output_row.reserve(_sel._outer_loop.size());
             auto inputs = expr::evaluation_inputs{
@@ -414,20 +580,29 @@ class selection_with_processing : public selection {
         }
 
         virtual void add_input_row(result_set_builder& rs) override {
-            auto inputs = expr::evaluation_inputs{
-                    .partition_key = rs.current_partition_key,
-                    .clustering_key = rs.current_clustering_key,
-                    .static_and_regular_columns = rs.current,
-                    .selection = &_sel,
-                    .options = nullptr,
-                    .static_and_regular_timestamps = rs._timestamps,
-                    .static_and_regular_ttls = rs._ttls,
-                    .temporaries = _temporaries,
-            };
-            for (size_t i = 0; i != _sel._inner_loop.size(); ++i) {
+            auto inputs = make_inner_loop_inputs(rs);
+            for (auto& b : _batched) {
+                if (!b.column) {
+                    ++b.size;
+                    continue;
+                }
+                auto& value = rs.current[*b.column];
+                if (!value) {
+                    // Aggregates skip null inputs.
+                    continue;
+                }
+                if (!buffer_input(b, *value)) {
+                    flush_batch(b);
+                    _temporaries[b.index] = expr::evaluate(_sel._inner_loop[b.index], inputs);
+                }
+            }
+            for (auto i : _unbatched) {
                 _temporaries[i] = expr::evaluate(_sel._inner_loop[i], inputs);
             }
             ++_input_row_count;
+            if (!_batched.empty() && ++_buffered_rows == batch_size) {
+                flush_batches();
+            }
         }
 
         virtual std::uint64_t get_input_row_count() const override {
@@ -19,6 +19,7 @@
 #include "tombstone_gc_extension.hh"
 #include "tombstone_gc.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/sstable_value_index_extension.hh"
 #include "db/per_partition_rate_limit_options.hh"
 #include "utils/bloom_calculations.hh"
 
@@ -129,6 +130,10 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         throw exceptions::configuration_exception("Per-partition rate limit is not supported yet by the whole cluster");
     }
 
+    if (schema_extensions.contains(db::sstable_value_index_extension::NAME) && !db.features().sstable_value_index) {
+        throw exceptions::configuration_exception("The sstable value index is not supported yet by the whole cluster");
+    }
+
     auto tombstone_gc_options = get_tombstone_gc_options(schema_extensions);
     validate_tombstone_gc_options(tombstone_gc_options, db, ks_name);
 
@@ -36,11 +36,13 @@ namespace statements {
 create_index_statement::create_index_statement(cf_name name,
                                                ::shared_ptr<index_name> index_name,
                                                std::vector<::shared_ptr<index_target::raw>> raw_targets,
+                                               std::vector<::shared_ptr<column_identifier::raw>> raw_included_columns,
                                                ::shared_ptr<index_prop_defs> properties,
                                                bool if_not_exists)
     : schema_altering_statement(name)
     , _index_name(index_name->get_idx())
     , _raw_targets(raw_targets)
+    , _raw_included_columns(std::move(raw_included_columns))
     , _properties(properties)
     , _if_not_exists(if_not_exists)
 {
@@ -324,11 +326,49 @@ void create_index_statement::validate_targets_for_multi_column_index(std::vector
     }
 }
 
+std::vector<::shared_ptr<column_identifier>> create_index_statement::validate_included_columns(const schema& schema,
+        const std::vector<::shared_ptr<index_target>>& targets) const {
+    std::vector<::shared_ptr<column_identifier>> included_columns;
+    if (_raw_included_columns.empty()) {
+        return included_columns;
+    }
+    if (_properties->is_custom) {
+        throw exceptions::invalid_request_exception("CUSTOM indexes cannot include columns");
+    }
+    if (targets.size() != 1 || !std::holds_alternative<index_target::single_column>(targets.front()->value)) {
+        throw exceptions::invalid_request_exception("Only global indexes on a single column can include columns");
+    }
+    for (auto& raw_column : _raw_included_columns) {
+        auto column = raw_column->prepare_column_identifier(schema);
+        auto cd = schema.get_column_definition(column->name());
+        if (!cd) {
+            throw exceptions::invalid_request_exception(format("No column definition found for included column {}", *column));
+        }
+        if (!cd->is_regular()) {
+            throw exceptions::invalid_request_exception(
+                    format("Cannot include column {}: only regular columns can be included, key columns are always stored in the index", *column));
+        }
+        if (cd->name_as_text() == targets.front()->column_name()) {
+            throw exceptions::invalid_request_exception(format("Cannot include the indexed column {}", *column));
+        }
+        if (std::ranges::any_of(included_columns, [&] (auto& c) { return *c == *column; })) {
+            throw exceptions::invalid_request_exception(format("Duplicate included column {}", *column));
+        }
+        included_columns.push_back(std::move(column));
+    }
+    return included_columns;
+}
+
 std::optional<create_index_statement::base_schema_with_new_index> create_index_statement::build_index_schema(data_dictionary::database db) const {
     auto targets = validate_while_executing(db);
 
     auto schema = db.find_schema(keyspace(), column_family());
 
+    auto included_columns = validate_included_columns(*schema, targets);
+    if (!included_columns.empty() && !db.features().covering_indexes) {
+        throw exceptions::invalid_request_exception("Indexes including columns are not supported by some older nodes in this cluster. Please upgrade them.");
+    }
+
     sstring accepted_name = _index_name;
     if (accepted_name.empty()) {
         std::optional<sstring> index_name_root;
@@ -347,6 +387,9 @@ std::optional<create_index_statement::base_schema_with_new_index> create_index_s
     } else {
         kind = schema->is_compound() ? index_metadata_kind::composites : index_metadata_kind::keys;
     }
+    if (!included_columns.empty()) {
+        index_options.emplace(index_target::included_columns_option_name, secondary_index::target_parser::serialize_included_columns(included_columns));
+    }
     auto index = make_index_metadata(targets, accepted_name, kind, index_options);
     auto existing_index = schema->find_index_noname(index);
     if (existing_index) {
@@ -22,6 +22,7 @@ namespace statements {
 struct index_target {
     static const sstring target_option_name;
     static const sstring custom_index_option_name;
+    static const sstring included_columns_option_name;
     static const boost::regex target_regex;
 
     enum class target_type {
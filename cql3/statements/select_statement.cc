@@ -307,6 +307,50 @@ select_statement::make_partition_slice(const query_options& options) const
         std::move(static_columns), std::move(regular_columns), _opts, nullptr, per_partition_limit);
 }
 
+std::optional<query::row_filter> select_statement::make_row_filter(query_processor& qp, const query_options& options) const {
+    if (!_restrictions_need_filtering || !qp.db().features().replica_side_filtering) {
+        return std::nullopt;
+    }
+    query::row_filter filter;
+    for (const auto& [def, restrictions] : _restrictions->get_non_pk_restriction()) {
+        // Restrictions on static columns apply to the whole partition, and
+        // the replica can't compare collections or counters cell by cell.
+        if (!def->is_regular() || def->is_multi_cell() || def->is_counter()) {
+            continue;
+        }
+        for (const auto& restriction : expr::boolean_factors(restrictions)) {
+            auto binop = expr::as_if<expr::binary_operator>(&restriction);
+            if (!binop || !expr::is<expr::column_value>(binop->lhs) || binop->order != expr::comparison_order::cql
+                    || binop->null_handling != expr::null_handling_style::sql) {
+                continue;
+            }
+            using comparison = query::column_restriction::comparison;
+            std::optional<comparison> cmp;
+            switch (binop->op) {
+            case expr::oper_t::EQ: cmp = comparison::eq; break;
+            case expr::oper_t::NEQ: cmp = comparison::neq; break;
+            case expr::oper_t::LT: cmp = comparison::lt; break;
+            case expr::oper_t::LTE: cmp = comparison::lte; break;
+            case expr::oper_t::GT: cmp = comparison::gt; break;
+            case expr::oper_t::GTE: cmp = comparison::gte; break;
+            default: break;
+            }
+            if (!cmp) {
+                continue;
+            }
+            auto value = expr::evaluate(binop->rhs, options);
+            if (value.is_null()) {
+                continue;
+            }
+            filter.restrictions.push_back(query::column_restriction{def->id, *cmp, std::move(value).to_bytes()});
+        }
+    }
+    if (filter.restrictions.empty()) {
+        return std::nullopt;
+    }
+    return filter;
+}
+
 select_statement::get_limit_result select_statement::get_limit(
     const query_options& options, const std::optional<expr::expression>& limit, bool is_per_partition_limit) const
 {
@@ -418,6 +462,7 @@ select_statement::do_execute(query_processor& qp,
             query::is_first_page::no,
             options.get_timestamp(state));
     command->allow_limit = db::allow_per_partition_rate_limit::yes;
+    command->row_filter = make_row_filter(qp, options);
     logger.trace("Executing read query (reversed {}): table schema {}, query schema {}",
         slice.is_reversed(), _schema->version(), _query_schema->version());
     tracing::trace(state.get_trace_state(), "Executing read query (reversed {})", slice.is_reversed());
@@ -529,11 +574,15 @@ select_statement::execute_without_checking_exception_message_aggregate_or_paged(
                         " you must either remove the ORDER BY or the IN and sort client side, or disable paging for this query");
     }
 
+    page_size = p->adaptive_page_size(page_size);
+
     if (_selection->is_trivial() && !_restrictions_need_filtering && !_per_partition_limit) {
         coordinator_result<result_generator> result_gen = co_await p->fetch_page_generator_result(page_size, now, timeout, _stats);
         if (result_gen.has_error()) {
             co_return failed_result_to_result_message(std::move(result_gen));
         }
+        _stats.select_page_rows_limit += page_size;
+        _stats.select_page_rows_returned += p->stats().last_page_rows;
         result_generator&& generator = std::move(result_gen).assume_value();
         auto meta = [&] () -> shared_ptr<const cql3::metadata> {
             if (!p->is_exhausted()) {
@@ -554,6 +603,8 @@ select_statement::execute_without_checking_exception_message_aggregate_or_paged(
     if (result_rs.has_error()) {
         co_return failed_result_to_result_message(std::move(result_rs));
     }
+    _stats.select_page_rows_limit += page_size;
+    _stats.select_page_rows_returned += p->stats().last_page_rows;
     std::unique_ptr<cql3::result_set>&& rs = std::move(result_rs).assume_value();
     if (!p->is_exhausted()) {
         rs->get_metadata().set_paging_state(p->state());
@@ -672,6 +723,7 @@ indexed_table_select_statement::do_execute_base_query(
     }
 
     const bool is_paged = bool(paging_state);
+    const size_t max_concurrency = std::max<size_t>(qp.db().get_config().secondary_index_base_query_concurrency(), 1);
     base_query_state query_state{cmd->get_row_limit() * queried_ranges_count, std::move(ranges_to_vnodes)};
     {
         auto& merger = query_state.merger;
@@ -714,9 +766,11 @@ indexed_table_select_statement::do_execute_base_query(
                     command->slice.set_range(*_schema, base_pk, row_ranges);
                 }
             }
-            if (previous_result_size < query::result_memory_limiter::maximum_result_size && concurrency < max_base_table_query_concurrency) {
-                concurrency *= 2;
+            if (previous_result_size < query::result_memory_limiter::maximum_result_size && concurrency < max_concurrency) {
+                concurrency = std::min(concurrency * 2, max_concurrency);
             }
+            ++_stats.secondary_index_base_fetch_batches;
+            _stats.secondary_index_base_fetch_partitions += prange.size();
             coordinator_result<service::storage_proxy::coordinator_query_result> rqr = co_await qp.proxy().query_result(_schema, command, std::move(prange), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
             if (!rqr.has_value()) {
                 co_return std::move(rqr).as_failure();
@@ -747,6 +801,16 @@ indexed_table_select_statement::execute_base_query(
     }));
 }
 
+namespace {
+
+// The rows of a base table partition read by a query using a secondary index.
+struct base_partition_read {
+    dht::decorated_key partition;
+    std::vector<query::clustering_range> row_ranges;
+};
+
+}
+
 future<coordinator_result<std::tuple<foreign_ptr<lw_shared_ptr<query::result>>, lw_shared_ptr<query::read_command>>>>
 indexed_table_select_statement::do_execute_base_query(
         query_processor& qp,
@@ -758,44 +822,79 @@ indexed_table_select_statement::do_execute_base_query(
     using value_type = std::tuple<foreign_ptr<lw_shared_ptr<query::result>>, lw_shared_ptr<query::read_command>>;
     auto cmd = prepare_command_for_base_query(qp, options, state, now, bool(paging_state));
     auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    const size_t max_concurrency = std::max<size_t>(qp.db().get_config().secondary_index_base_query_concurrency(), 1);
+
+    // The keys are in token order, so the rows of a base partition are
+    // adjacent. They are read with a single request for the partition,
+    // instead of one request per row.
+    std::vector<base_partition_read> reads;
+    reads.reserve(primary_keys.size());
+    for (auto& key : primary_keys) {
+        if (reads.empty() || !reads.back().partition.equal(*_schema, key.partition)) {
+            reads.push_back(base_partition_read{std::move(key.partition), {}});
+        } else {
+            ++_stats.secondary_index_base_fetch_merged_rows;
+        }
+        if (key.clustering) {
+            reads.back().row_ranges.push_back(query::clustering_range::make_singular(std::move(key.clustering)));
+        }
+    }
+    if (cmd->slice.is_reversed()) {
+        for (auto& read : reads) {
+            std::ranges::reverse(read.row_ranges);
+        }
+    }
 
     query::result_merger merger(cmd->get_row_limit(), query::max_partitions);
-    std::vector<primary_key> keys = std::move(primary_keys);
-    std::vector<primary_key>::iterator key_it(keys.begin());
+    auto read_it = reads.begin();
     size_t previous_result_size = 0;
     size_t next_iteration_size = 0;
 
     const bool is_paged = bool(paging_state);
-    while (key_it != keys.end()) {
-        // Starting with 1 key, we check if the result was a short read, and if not,
-        // we continue exponentially, asking for 2x more key than before
-        auto already_done = std::distance(keys.begin(), key_it);
+    while (read_it != reads.end()) {
+        // Starting with 1 partition, we check if the result was a short read, and if not,
+        // we continue exponentially, asking for 2x more partitions than before
+        auto already_done = std::distance(reads.begin(), read_it);
         // If the previous result already provided 1MB worth of data,
         // stop increasing the number of fetched partitions
         if (previous_result_size < query::result_memory_limiter::maximum_result_size) {
             next_iteration_size = already_done + 1;
         }
-        next_iteration_size = std::min<size_t>({next_iteration_size, keys.size() - already_done, max_base_table_query_concurrency});
-        auto key_it_end = key_it + next_iteration_size;
-        auto command = ::make_lw_shared<query::read_command>(*cmd);
-
-        query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
-        coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>> rresult = co_await utils::result_map_reduce(key_it, key_it_end, coroutine::lambda([&] (auto& key)
-                -> future<coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>>> {
+        next_iteration_size = std::min<size_t>({next_iteration_size, reads.size() - already_done, max_concurrency});
+        auto read_it_end = read_it + next_iteration_size;
+        ++_stats.secondary_index_base_fetch_batches;
+        _stats.secondary_index_base_fetch_partitions += next_iteration_size;
+
+        coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>> rresult = nullptr;
+        if (std::all_of(read_it, read_it_end, [] (const base_partition_read& read) { return read.row_ranges.empty(); })) {
+            // All partitions are read with the same slice, so they are read
+            // with a single command, and the storage proxy reads the partitions
+            // owned by the same replica with a single request.
             auto command = ::make_lw_shared<query::read_command>(*cmd);
-            // for each partition, read just one clustering row (TODO: can
-            // get all needed rows of one partition at once.)
             command->slice._row_ranges.clear();
-            if (key.clustering) {
-                command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
-            }
+            auto pranges = std::ranges::subrange(read_it, read_it_end) | std::views::transform([] (const base_partition_read& read) {
+                return dht::partition_range::make_singular(read.partition);
+            }) | std::ranges::to<dht::partition_range_vector>();
             coordinator_result<service::storage_proxy::coordinator_query_result> rqr
-                    = co_await qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(key.partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
+                    = co_await qp.proxy().query_result(_schema, command, std::move(pranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
             if (!rqr.has_value()) {
                 co_return std::move(rqr).as_failure();
             }
-            co_return std::move(rqr.value().query_result);
-        }), std::move(oneshot_merger));
+            rresult = std::move(rqr.value().query_result);
+        } else {
+            query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
+            rresult = co_await utils::result_map_reduce(read_it, read_it_end, coroutine::lambda([&] (auto& read)
+                    -> future<coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>>> {
+                auto command = ::make_lw_shared<query::read_command>(*cmd);
+                command->slice._row_ranges = read.row_ranges;
+                coordinator_result<service::storage_proxy::coordinator_query_result> rqr
+                        = co_await qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(read.partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
+                if (!rqr.has_value()) {
+                    co_return std::move(rqr).as_failure();
+                }
+                co_return std::move(rqr.value().query_result);
+            }), std::move(oneshot_merger));
+        }
         if (!rresult.has_value()) {
             co_return std::move(rresult).as_failure();
         }
@@ -805,7 +904,7 @@ indexed_table_select_statement::do_execute_base_query(
         const bool page_limit_reached = is_paged && result->buf().size() >= query::result_memory_limiter::maximum_result_size;
         previous_result_size = result->buf().size();
         merger(std::move(result));
-        key_it = key_it_end;
+        read_it = read_it_end;
         if (is_short_read || page_limit_reached) {
             break;
         }
@@ -854,9 +953,11 @@ select_statement::execute_without_checking_exception_message_non_aggregate_unpag
     // doing post-query ordering.
     auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
     if (needs_post_query_ordering() && _limit) {
+        using partition_results = std::vector<foreign_ptr<lw_shared_ptr<query::result>>>;
         return do_with(std::forward<dht::partition_range_vector>(partition_ranges), [this, &qp, &state, &options, cmd, timeout](auto& prs) {
             SCYLLA_ASSERT(cmd->partition_limit == query::max_partitions);
-            query::result_merger merger(cmd->get_row_limit() * prs.size(), query::max_partitions);
+            partition_results results;
+            results.reserve(prs.size());
             return utils::result_map_reduce(prs.begin(), prs.end(), [this, &qp, &state, &options, cmd, timeout] (auto& pr) {
                 dht::partition_range_vector prange { pr };
                 auto command = ::make_lw_shared<query::read_command>(*cmd);
@@ -867,9 +968,12 @@ select_statement::execute_without_checking_exception_message_non_aggregate_unpag
                         {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()}).then(utils::result_wrap([] (service::storage_proxy::coordinator_query_result qr) {
                     return make_ready_future<coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>>>(std::move(qr.query_result));
                 }));
-            }, std::move(merger));
-        }).then(wrap_result_to_error_message([this, &options, now, cmd] (auto result) {
-            return this->process_results(std::move(result), cmd, options, now);
+            }, std::move(results), [] (partition_results results, foreign_ptr<lw_shared_ptr<query::result>> result) {
+                results.push_back(std::move(result));
+                return results;
+            });
+        }).then(wrap_result_to_error_message([this, &options, now, cmd] (partition_results results) {
+            return this->process_partition_results_top_n(std::move(results), cmd, options, now);
         }));
     } else {
         return qp.proxy().query_result(_query_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
@@ -944,6 +1048,91 @@ select_statement::process_results_complex(foreign_ptr<lw_shared_ptr<query::resul
     });
 }
 
+namespace {
+
+// Selects the first `limit` rows by `less` out of runs of rows which are each
+// sorted by `less`, like the rows of the partitions of a query ordered by
+// clustering columns. The selected rows are kept in a heap, with the last of
+// them on top, and a run is only consumed while its rows can enter the heap:
+// a run can't provide more than `limit` rows, and once one of its rows comes
+// after all the selected rows, so do all the remaining ones.
+template <typename Less>
+class top_n_rows_merger {
+    using row_type = std::vector<managed_bytes_opt>;
+
+    Less _less;
+    size_t _limit;
+    std::vector<row_type> _heap;
+public:
+    top_n_rows_merger(Less less, size_t limit) : _less(std::move(less)), _limit(limit) {
+    }
+
+    template <std::ranges::range Rows>
+    void add_run(const Rows& rows) {
+        for (const auto& row : rows) {
+            if (_heap.size() < _limit) {
+                _heap.push_back(row);
+                std::ranges::push_heap(_heap, _less);
+            } else if (_limit && _less(row, _heap.front())) {
+                std::ranges::pop_heap(_heap, _less);
+                _heap.back() = row;
+                std::ranges::push_heap(_heap, _less);
+            } else {
+                break;
+            }
+        }
+    }
+
+    std::vector<row_type> get() && {
+        std::ranges::sort_heap(_heap, _less);
+        return std::move(_heap);
+    }
+};
+
+}
+
+future<shared_ptr<cql_transport::messages::result_message>>
+select_statement::process_partition_results_top_n(std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results,
+        lw_shared_ptr<query::read_command> cmd,
+        const query_options& options,
+        gc_clock::time_point now) const {
+    // Each partition returns its rows in the order of the query, so the rows
+    // of the query are merged from per-partition runs instead of sorting all
+    // `limit` rows of every partition.
+    auto in_query_order = [this] (const result_row_type& r1, const result_row_type& r2) {
+        return _is_reversed ? _ordering_comparator(r2, r1) : _ordering_comparator(r1, r2);
+    };
+    top_n_rows_merger merger(in_query_order, cmd->get_row_limit());
+    cql3::selection::result_set_builder builder(*_selection, now, &options);
+    co_return co_await builder.with_thread_if_needed([&] {
+        uint64_t rows_read = 0;
+        for (auto& partition_result : results) {
+            cql3::selection::result_set_builder partition_builder(*_selection, now, &options);
+            if (_restrictions_need_filtering) {
+                partition_result->ensure_counts();
+                rows_read += *partition_result->row_count();
+                query::result_view::consume(*partition_result, cmd->slice,
+                        cql3::selection::result_set_builder::visitor(partition_builder, *_query_schema,
+                                *_selection, cql3::selection::result_set_builder::restrictions_filter(_restrictions, options, cmd->get_row_limit(), _query_schema, cmd->slice.partition_row_limit())));
+            } else {
+                query::result_view::consume(*partition_result, cmd->slice,
+                        cql3::selection::result_set_builder::visitor(partition_builder, *_query_schema,
+                                *_selection));
+            }
+            merger.add_run(partition_builder.build()->rows());
+        }
+
+        auto rs = builder.build();
+        for (auto& row : std::move(merger).get()) {
+            rs->add_row(std::move(row));
+        }
+        update_stats_rows_read(rs->size());
+        _stats.filtered_rows_read_total += rows_read;
+        _stats.filtered_rows_matched_total += _restrictions_need_filtering ? rs->size() : 0;
+        return shared_ptr<cql_transport::messages::result_message>(::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs))));
+    });
+}
+
 const ::shared_ptr<const restrictions::statement_restrictions> select_statement::get_restrictions() const {
     return _restrictions;
 }
@@ -1042,6 +1231,78 @@ indexed_table_select_statement::indexed_table_select_statement(schema_ptr schema
         _get_partition_ranges_for_posting_list = [this] (const query_options& options) { return get_partition_ranges_for_global_index_posting_list(options); };
         _get_partition_slice_for_posting_list = [this] (const query_options& options) { return get_partition_slice_for_global_index_posting_list(options); };
     }
+    _covering_view_columns = find_covering_view_columns();
+}
+
+std::vector<const column_definition*> indexed_table_select_statement::find_covering_view_columns() const {
+    if (_index.included_columns().empty() || _index.metadata().local()
+            || _index.target_type() != cql3::statements::index_target::target_type::regular_values) {
+        return {};
+    }
+    const column_definition* target_cdef = _schema->get_column_definition(to_bytes(_index.target_column()));
+    if (!target_cdef || !target_cdef->is_regular()) {
+        return {};
+    }
+    // The view holds a row for each base row with the indexed value, so it
+    // can only replace the base table if the index restriction is the only
+    // one, and rows are returned one by one, as they are.
+    if (_selection->is_aggregate() || has_group_by() || _parameters->is_distinct() || _parameters->is_json()
+            || _restrictions_need_filtering || needs_post_query_ordering() || _is_reversed || _per_partition_limit
+            || _opts.contains<query::partition_slice::option::send_timestamp>()
+            || _opts.contains<query::partition_slice::option::send_expiry>()) {
+        return {};
+    }
+    if (!_restrictions->partition_key_restrictions_is_empty() || _restrictions->has_clustering_columns_restriction()
+            || _restrictions->get_non_pk_restriction().size() != 1) {
+        return {};
+    }
+    std::vector<const column_definition*> view_columns;
+    for (const column_definition* cdef : _selection->get_columns()) {
+        const column_definition* view_cdef = _view_schema->get_column_definition(cdef->name());
+        if (cdef->is_static() || !view_cdef || view_cdef->is_view_virtual()) {
+            return {};
+        }
+        view_columns.push_back(view_cdef);
+    }
+    return view_columns;
+}
+
+future<shared_ptr<cql_transport::messages::result_message>>
+indexed_table_select_statement::execute_from_covering_index(query_processor& qp,
+        service::query_state& state,
+        const query_options& options,
+        gc_clock::time_point now) const {
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    auto partition_slice = _get_partition_slice_for_posting_list(options);
+    partition_slice.regular_columns.clear();
+    for (const column_definition* view_cdef : _covering_view_columns) {
+        if (view_cdef->is_regular()) {
+            partition_slice.regular_columns.push_back(view_cdef->id);
+        }
+    }
+    partition_slice.options.set_if<query::partition_slice::option::bypass_cache>(_parameters->bypass_cache());
+    auto view_selection = selection::selection::for_columns(_view_schema, _covering_view_columns);
+
+    auto view_rs = co_await read_index_view(qp, options, std::move(partition_slice), std::move(view_selection),
+            get_limit(options, _limit), state, now, timeout);
+    if (!view_rs) {
+        co_return failed_result_to_result_message(std::move(view_rs));
+    }
+
+    // The view rows hold the selected columns in the order of the base
+    // selection, so they are fed to its selectors as base rows.
+    cql3::selection::result_set_builder builder(*_selection, now, &options);
+    for (const auto& row : view_rs.value()->rows()) {
+        builder.start_new_row();
+        for (const auto& cell : row) {
+            builder.add(to_bytes_opt(cell));
+        }
+        builder.complete_row();
+    }
+    auto rs = builder.build();
+    rs->get_metadata().maybe_set_paging_state(view_rs.value()->get_metadata().paging_state());
+    update_stats_rows_read(rs->size());
+    co_return ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
 }
 
 template<typename KeyType>
@@ -1146,6 +1407,12 @@ indexed_table_select_statement::do_execute(query_processor& qp,
 
     _stats.unpaged_select_queries(_ks_sel) += options.get_page_size() <= 0;
 
+    if (!_covering_view_columns.empty()) {
+        tracing::trace(state.get_trace_state(), "Reading the selected columns from covering index {}", _index.metadata().name());
+        ++_stats.secondary_index_covered_reads;
+        co_return co_await execute_from_covering_index(qp, state, options, now);
+    }
+
     // Secondary index search has two steps: 1. use the index table to find a
     // list of primary keys matching the query. 2. read the rows matching
     // these primary keys from the base table and return the selected columns.
@@ -1340,8 +1607,44 @@ indexed_table_select_statement::read_posting_list(query_processor& qp,
                   db::timeout_clock::time_point timeout,
                   bool include_base_clustering_key) const
 {
-    dht::partition_range_vector partition_ranges = _get_partition_ranges_for_posting_list(options);
     auto partition_slice = _get_partition_slice_for_posting_list(options);
+    // The posting list only needs the keys, not the columns included in the index.
+    if (!_index.included_columns().empty()) {
+        std::erase_if(partition_slice.regular_columns, [this] (column_id id) {
+            return _index.includes(_view_schema->regular_column_at(id));
+        });
+    }
+
+    std::vector<const column_definition*> columns;
+    for (const column_definition& cdef : _schema->partition_key_columns()) {
+        columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
+    }
+    if (include_base_clustering_key) {
+        for (const column_definition& cdef : _schema->clustering_key_columns()) {
+            columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
+        }
+    }
+    auto selection = selection::selection::for_columns(_view_schema, columns);
+
+    return read_index_view(qp, options, std::move(partition_slice), std::move(selection), limit, state, now, timeout).then(utils::result_wrap(
+            [] (std::unique_ptr<cql3::result_set> rs) -> coordinator_result<::shared_ptr<cql_transport::messages::result_message::rows>> {
+        return ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+    }));
+}
+
+// Reads the given columns of the index view rows matching the index
+// restriction, a page at a time if the query is paged.
+future<coordinator_result<std::unique_ptr<cql3::result_set>>>
+indexed_table_select_statement::read_index_view(query_processor& qp,
+                  const query_options& options,
+                  query::partition_slice partition_slice,
+                  ::shared_ptr<selection::selection> selection,
+                  uint64_t limit,
+                  service::query_state& state,
+                  gc_clock::time_point now,
+                  db::timeout_clock::time_point timeout) const
+{
+    dht::partition_range_vector partition_ranges = _get_partition_ranges_for_posting_list(options);
 
     auto cmd = ::make_lw_shared<query::read_command>(
             _view_schema->id(),
@@ -1357,36 +1660,25 @@ indexed_table_select_statement::read_posting_list(query_processor& qp,
             query::is_first_page::no,
             options.get_timestamp(state));
 
-    std::vector<const column_definition*> columns;
-    for (const column_definition& cdef : _schema->partition_key_columns()) {
-        columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
-    }
-    if (include_base_clustering_key) {
-        for (const column_definition& cdef : _schema->clustering_key_columns()) {
-            columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
-        }
-    }
-    auto selection = selection::selection::for_columns(_view_schema, columns);
-
     int32_t page_size = options.get_page_size();
     if (page_size <= 0 || !service::pager::query_pagers::may_need_paging(*_view_schema, page_size, *cmd, partition_ranges)) {
         return qp.proxy().query_result(_view_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
         .then(utils::result_wrap([this, now, &options, selection = std::move(selection), partition_slice = std::move(partition_slice)] (service::storage_proxy::coordinator_query_result qr)
-                -> coordinator_result<::shared_ptr<cql_transport::messages::result_message::rows>> {
+                -> coordinator_result<std::unique_ptr<cql3::result_set>> {
             cql3::selection::result_set_builder builder(*selection, now, &options);
             query::result_view::consume(*qr.query_result,
                                         std::move(partition_slice),
                                         cql3::selection::result_set_builder::visitor(builder, *_view_schema, *selection));
-            return ::make_shared<cql_transport::messages::result_message::rows>(result(builder.build()));
+            return builder.build();
         }));
     }
 
     auto p = service::pager::query_pagers::pager(qp.proxy(), _view_schema, selection,
             state, options, cmd, std::move(partition_ranges), nullptr);
     return p->fetch_page_result(options.get_page_size(), now, timeout).then(utils::result_wrap([p = std::move(p)] (std::unique_ptr<cql3::result_set> rs)
-            -> coordinator_result<::shared_ptr<cql_transport::messages::result_message::rows>> {
+            -> coordinator_result<std::unique_ptr<cql3::result_set>> {
         rs->get_metadata().set_paging_state(p->state());
-        return ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+        return rs;
     }));
 }
 
@@ -1431,6 +1723,7 @@ indexed_table_select_statement::find_index_partition_ranges(query_processor& qp,
             if (last_dk && last_dk->equal(*_schema, dk)) {
                 // Another row of the same partition, no need to output the
                 // same partition key again.
+                ++_stats.secondary_index_base_fetch_merged_rows;
                 continue;
             }
             last_dk = dk;
@@ -1512,6 +1805,24 @@ indexed_table_select_statement::find_index_clustering_rows(query_processor& qp,
 
 class parallelized_select_statement : public select_statement {
 public:
+    // Describes how a GROUP BY query is computed by the mapreduce service.
+    struct grouping {
+        // The GROUP BY columns, a prefix of the primary key.
+        std::vector<sstring> columns;
+        // The reductions of the aggregates of the SELECT clause.
+        query::mapreduce_request::reductions_info reductions;
+        // Where each value of a result row comes from: a GROUP BY column or
+        // a reduction, by index.
+        struct output_column {
+            bool from_group_by;
+            size_t index;
+        };
+        std::vector<output_column> output;
+        // A rough estimate of the memory taken by a group, to bound the
+        // number of groups computed in one go by the result size limit.
+        uint64_t estimated_group_size;
+    };
+
     static ::shared_ptr<cql3::statements::select_statement> prepare(
         schema_ptr schema,
         uint32_t bound_terms,
@@ -1524,7 +1835,8 @@ class parallelized_select_statement : public select_statement {
         std::optional<expr::expression> limit,
         std::optional<expr::expression> per_partition_limit,
         cql_stats& stats,
-        std::unique_ptr<cql3::attributes> attrs
+        std::unique_ptr<cql3::attributes> attrs,
+        std::optional<grouping> grouping = std::nullopt
     );
 
     parallelized_select_statement(
@@ -1539,15 +1851,25 @@ class parallelized_select_statement : public select_statement {
         std::optional<expr::expression> limit,
         std::optional<expr::expression> per_partition_limit,
         cql_stats& stats,
-        std::unique_ptr<cql3::attributes> attrs
+        std::unique_ptr<cql3::attributes> attrs,
+        std::optional<grouping> grouping = std::nullopt
     );
 
 private:
+    std::optional<grouping> _grouping;
+
     virtual future<::shared_ptr<cql_transport::messages::result_message>> do_execute(
         query_processor& qp,
         service::query_state& state,
         const query_options& options
     ) const override;
+
+    future<::shared_ptr<cql_transport::messages::result_message>> execute_grouped(
+        query_processor& qp,
+        service::query_state& state,
+        const query_options& options,
+        query::mapreduce_request req
+    ) const;
 };
 
 ::shared_ptr<cql3::statements::select_statement> parallelized_select_statement::prepare(
@@ -1562,7 +1884,8 @@ ::shared_ptr<cql3::statements::select_statement> parallelized_select_statement::
     std::optional<expr::expression> limit,
     std::optional<expr::expression> per_partition_limit,
     cql_stats& stats,
-    std::unique_ptr<cql3::attributes> attrs
+    std::unique_ptr<cql3::attributes> attrs,
+    std::optional<grouping> grouping
 ) {
     return ::make_shared<cql3::statements::parallelized_select_statement>(
         schema,
@@ -1576,7 +1899,8 @@ ::shared_ptr<cql3::statements::select_statement> parallelized_select_statement::
         std::move(limit),
         std::move(per_partition_limit),
         stats,
-        std::move(attrs)
+        std::move(attrs),
+        std::move(grouping)
     );
 }
 
@@ -1592,7 +1916,8 @@ parallelized_select_statement::parallelized_select_statement(
     std::optional<expr::expression> limit,
     std::optional<expr::expression> per_partition_limit,
     cql_stats& stats,
-    std::unique_ptr<cql3::attributes> attrs
+    std::unique_ptr<cql3::attributes> attrs,
+    std::optional<grouping> grouping
 ) : select_statement(
     schema,
     bound_terms,
@@ -1606,7 +1931,8 @@ parallelized_select_statement::parallelized_select_statement(
     std::move(per_partition_limit),
     stats,
     std::move(attrs)
-) {
+)
+, _grouping(std::move(grouping)) {
 }
 
 future<::shared_ptr<cql_transport::messages::result_message>>
@@ -1615,6 +1941,11 @@ parallelized_select_statement::do_execute(
     service::query_state& state,
     const query_options& options
 ) const {
+    if (_grouping && options.get_paging_state()) {
+        // A previous page fell back to the regular path, keep using it.
+        return select_statement::do_execute(qp, state, options);
+    }
+
     tracing::add_table_name(state.get_trace_state(), keyspace(), column_family());
 
     auto cl = options.get_consistency();
@@ -1658,7 +1989,7 @@ parallelized_select_statement::do_execute(
     command->slice.options.set<query::partition_slice::option::allow_short_read>();
     auto timeout_duration = get_timeout(state.get_client_state(), options);
     auto timeout = lowres_system_clock::now() + timeout_duration;
-    auto reductions = _selection->get_reductions();
+    auto reductions = _grouping ? _grouping->reductions : _selection->get_reductions();
 
     query::mapreduce_request req = {
         .reduction_types = reductions.types,
@@ -1669,6 +2000,21 @@ parallelized_select_statement::do_execute(
         .aggregation_infos = reductions.infos,
     };
 
+    if (_grouping) {
+        // Groups are only computed in one go if they fit in a single page,
+        // and within the soft result size limit, so that unpaged queries
+        // can't accumulate an unbounded number of groups. Otherwise the
+        // replicas give up early and we fall back to the regular path, which
+        // pages, or enforces the result size limits of unpaged queries.
+        const auto page_size = options.get_page_size();
+        const auto max_groups_by_size = std::max<uint64_t>(1, command->max_result_size->soft_limit / _grouping->estimated_group_size);
+        req.grouping = query::mapreduce_request::grouping_info{
+            .column_names = _grouping->columns,
+            .max_groups = page_size > 0 ? std::min(uint64_t(page_size), max_groups_by_size) : max_groups_by_size,
+        };
+        return execute_grouped(qp, state, options, std::move(req));
+    }
+
     // dispatch execution of this statement to other nodes
     return qp.mapreduce(req, state.get_trace_state()).then([this] (query::mapreduce_result res) {
         auto meta = _selection->get_result_metadata();
@@ -1681,6 +2027,42 @@ parallelized_select_statement::do_execute(
     });
 }
 
+future<::shared_ptr<cql_transport::messages::result_message>>
+parallelized_select_statement::execute_grouped(
+    query_processor& qp,
+    service::query_state& state,
+    const query_options& options,
+    query::mapreduce_request req
+) const {
+    auto res = co_await qp.mapreduce(req, state.get_trace_state());
+    if (res.groups_overflow) {
+        tracing::trace(state.get_trace_state(), "Too many groups for a single page, falling back to a regular query");
+        co_return co_await select_statement::do_execute(qp, state, options);
+    }
+    tracing::trace(state.get_trace_state(), "Computed {} groups in parallel", res.grouped_query_results.size());
+
+    const auto parsed_limit = get_limit(options, _limit);
+    const uint64_t limit = parsed_limit.has_value() ? parsed_limit.value() : query::max_rows;
+    const auto offset = _grouping->columns.size();
+
+    auto rs = std::make_unique<result_set>(_selection->get_result_metadata());
+    for (auto& group : res.grouped_query_results) {
+        if (rs->size() >= limit) {
+            break;
+        }
+        std::vector<bytes_opt> row;
+        row.reserve(_grouping->output.size());
+        for (auto& col : _grouping->output) {
+            row.push_back(group[col.from_group_by ? col.index : offset + col.index]);
+        }
+        rs->add_row(std::move(row));
+    }
+    update_stats_rows_read(rs->size());
+    co_return shared_ptr<cql_transport::messages::result_message>(
+        make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)))
+    );
+}
+
 mutation_fragments_select_statement::mutation_fragments_select_statement(
             schema_ptr output_schema,
             schema_ptr underlying_schema,
@@ -2077,6 +2459,94 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
                 && restrictions->partition_key_restrictions_size() == schema->partition_key_size());
     };
 
+    // Used to determine if a GROUP BY query can be parallelized using
+    // `mapreduce_service`, and if so, how its result rows are assembled.
+    // Since GROUP BY includes the whole partition key, each group is
+    // computed by a single replica shard.
+    auto can_be_mapreduced_grouped = [&] () -> std::optional<parallelized_select_statement::grouping> {
+        if (group_by_cell_indices->empty()
+                || !db.features().parallelized_group_by
+                || !db.get_config().enable_parallelized_aggregation()
+                || restrictions->need_filtering()
+                || is_local_table()
+                || (restrictions->partition_key_restrictions_is_all_eq()
+                    && restrictions->partition_key_restrictions_size() == schema->partition_key_size())
+                || _parameters->is_distinct()
+                || !_parameters->orderings().empty()
+                || _per_partition_limit) {
+            return std::nullopt;
+        }
+
+        // GROUP BY may skip equality-restricted key columns, we only handle
+        // the plain case of a primary key prefix.
+        const auto all_columns = schema->all_columns_in_select_order();
+        std::vector<const column_definition*> group_by_columns;
+        for (size_t i = 0; i < _group_by_columns.size(); ++i) {
+            auto def = schema->get_column_definition(_group_by_columns[i]->prepare_column_identifier(*schema)->name());
+            if (*def != all_columns[i]) {
+                return std::nullopt;
+            }
+            group_by_columns.push_back(def);
+        }
+
+        // Every selector must either be a GROUP BY column or an aggregate.
+        parallelized_select_statement::grouping grouping;
+        std::vector<selection::prepared_selector> aggregates;
+        for (auto& ps : prepared_selectors) {
+            if (auto cv = expr::as_if<expr::column_value>(&ps.expr)) {
+                auto it = std::ranges::find(group_by_columns, cv->col);
+                if (it == group_by_columns.end()) {
+                    return std::nullopt;
+                }
+                grouping.output.push_back({true, size_t(it - group_by_columns.begin())});
+            } else if (all_aggregates({ps})) {
+                grouping.output.push_back({false, aggregates.size()});
+                aggregates.push_back(ps);
+            } else {
+                return std::nullopt;
+            }
+        }
+        if (aggregates.empty()) {
+            return std::nullopt;
+        }
+        auto aggregates_selection = selection::selection::from_selectors(db, schema, keyspace(), aggregates);
+        if (!(db.features().parallelized_aggregation && aggregates_selection->is_count())
+                && !(db.features().uda_native_parallelized_aggregation && aggregates_selection->is_reducible())) {
+            return std::nullopt;
+        }
+        grouping.reductions = aggregates_selection->get_reductions();
+
+        // GROUP BY columns not referenced by the SELECT clause were appended
+        // to the selection for post-processing, see prepare_group_by().
+        for (size_t i = 0; i < group_by_columns.size(); ++i) {
+            bool referenced = false;
+            for (auto& ps : prepared_selectors) {
+                expr::for_each_expression<expr::column_value>(ps.expr, [&] (const expr::column_value& cv) {
+                    referenced |= cv.col == group_by_columns[i];
+                });
+            }
+            if (!referenced) {
+                grouping.output.push_back({true, i});
+            }
+        }
+        if (grouping.output.size() != selection->get_result_metadata()->value_count()) {
+            return std::nullopt;
+        }
+
+        grouping.columns = group_by_columns
+                | std::views::transform(std::mem_fn(&column_definition::name_as_text))
+                | std::ranges::to<std::vector<sstring>>();
+        // Values of variable size are assumed to be small, as GROUP BY keys
+        // and aggregates usually are.
+        static constexpr uint64_t estimated_variable_value_size = 32;
+        grouping.estimated_group_size = 0;
+        for (auto& spec : selection->get_result_metadata()->get_names()) {
+            grouping.estimated_group_size += sizeof(bytes_opt) + spec->type->value_length_if_fixed().value_or(estimated_variable_value_size);
+        }
+        return grouping;
+    };
+    auto grouping = can_be_mapreduced_grouped();
+
     if (_parameters->is_prune_materialized_view()) {
         stmt = ::make_shared<cql3::statements::prune_materialized_view_statement>(
                 schema,
@@ -2121,7 +2591,7 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
                 prepare_limit(db, ctx, _per_partition_limit),
                 stats,
                 std::move(prepared_attrs));
-    } else if (can_be_mapreduced()) {
+    } else if (can_be_mapreduced() || grouping) {
         stmt = parallelized_select_statement::prepare(
             schema,
             ctx.bound_variables_size(),
@@ -2134,7 +2604,8 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
             prepare_limit(db, ctx, _limit),
             prepare_limit(db, ctx, _per_partition_limit),
             stats,
-            std::move(prepared_attrs)
+            std::move(prepared_attrs),
+            std::move(grouping)
         );
     } else if (service::broadcast_tables::is_broadcast_table_statement(keyspace(), column_family())) {
         stmt = ::make_shared<cql3::statements::strongly_consistent_select_statement>(
@@ -90,6 +90,11 @@ class select_statement : public cql_statement {
 private:
     future<shared_ptr<cql_transport::messages::result_message>> process_results_complex(foreign_ptr<lw_shared_ptr<query::result>> results,
         lw_shared_ptr<query::read_command> cmd, const query_options& options, gc_clock::time_point now) const;
+    // Selects the first rows, in the ORDER BY order, out of the results of a
+    // query with IN on the partition key, one result per partition.
+    future<shared_ptr<cql_transport::messages::result_message>> process_partition_results_top_n(
+        std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results,
+        lw_shared_ptr<query::read_command> cmd, const query_options& options, gc_clock::time_point now) const;
 protected :
     virtual future<::shared_ptr<cql_transport::messages::result_message>> do_execute(query_processor& qp,
         service::query_state& state, const query_options& options) const;
@@ -146,6 +151,10 @@ protected :
 
     query::partition_slice make_partition_slice(const query_options& options) const;
 
+    // The filtering restrictions which replicas can evaluate on their own,
+    // if any, see query::row_filter.
+    std::optional<query::row_filter> make_row_filter(query_processor& qp, const query_options& options) const;
+
     const ::shared_ptr<const restrictions::statement_restrictions> get_restrictions() const;
 
     bool has_group_by() const { return _group_by_cell_indices && !_group_by_cell_indices->empty(); }
@@ -185,9 +194,10 @@ class indexed_table_select_statement : public select_statement {
     schema_ptr _view_schema;
     noncopyable_function<dht::partition_range_vector(const query_options&)> _get_partition_ranges_for_posting_list;
     noncopyable_function<query::partition_slice(const query_options&)> _get_partition_slice_for_posting_list;
+    // The index view columns holding the selected columns, if the index
+    // includes all of them and the query can be answered from the view alone.
+    std::vector<const column_definition*> _covering_view_columns;
 public:
-    static constexpr size_t max_base_table_query_concurrency = 4096;
-
     static ::shared_ptr<cql3::statements::select_statement> prepare(data_dictionary::database db,
                                                                     schema_ptr schema,
                                                                     uint32_t bound_terms,
@@ -266,11 +276,12 @@ class indexed_table_select_statement : public select_statement {
     // Function for fetching the selected columns from a list of clustering rows.
     // It is currently used only in our Secondary Index implementation - ordinary
     // CQL SELECT statements do not have the syntax to request a list of rows.
-    // FIXME: The current implementation is very inefficient - it requests each
-    // row separately (and, incrementally, in parallel). Even multiple rows from a single
-    // partition are requested separately. This last case can be easily improved,
-    // but to implement the general case (multiple rows from multiple partitions)
-    // efficiently, we will need more support from other layers.
+    // The rows of each partition are requested together, and partitions are
+    // requested incrementally, in parallel (up to secondary_index_base_query_concurrency
+    // at once). When whole partitions are read, they are requested with a single
+    // command, so the partitions of a replica are read with a single request.
+    // FIXME: to read the general case (multiple rows from multiple partitions)
+    // with a request per replica, we will need more support from other layers.
     // Keys are ordered in token order (see #3423)
     future<coordinator_result<std::tuple<foreign_ptr<lw_shared_ptr<query::result>>, lw_shared_ptr<query::read_command>>>>
     do_execute_base_query(
@@ -303,6 +314,25 @@ class indexed_table_select_statement : public select_statement {
             db::timeout_clock::time_point timeout,
             bool include_base_clustering_key) const;
 
+    future<coordinator_result<std::unique_ptr<cql3::result_set>>> read_index_view(
+            query_processor& qp,
+            const query_options& options,
+            query::partition_slice partition_slice,
+            ::shared_ptr<selection::selection> selection,
+            uint64_t limit,
+            service::query_state& state,
+            gc_clock::time_point now,
+            db::timeout_clock::time_point timeout) const;
+
+    std::vector<const column_definition*> find_covering_view_columns() const;
+
+    // Answers the query from the index view, without reading the base table.
+    future<shared_ptr<cql_transport::messages::result_message>> execute_from_covering_index(
+            query_processor& qp,
+            service::query_state& state,
+            const query_options& options,
+            gc_clock::time_point now) const;
+
     dht::partition_range_vector get_partition_ranges_for_local_index_posting_list(const query_options& options) const;
     dht::partition_range_vector get_partition_ranges_for_global_index_posting_list(const query_options& options) const;
 
@@ -69,6 +69,15 @@ struct cql_stats {
     int64_t secondary_index_drops = 0;
     int64_t secondary_index_reads = 0;
     int64_t secondary_index_rows_read = 0;
+    // Reads answered from the index view alone, by an index including all
+    // the selected columns.
+    int64_t secondary_index_covered_reads = 0;
+    // Batches of base table partitions read in parallel by queries using
+    // secondary indexes, the partitions they read, and the index rows which
+    // were folded into the read of a partition already being read.
+    uint64_t secondary_index_base_fetch_batches = 0;
+    uint64_t secondary_index_base_fetch_partitions = 0;
+    uint64_t secondary_index_base_fetch_merged_rows = 0;
 
     int64_t filtered_reads = 0;
     int64_t filtered_rows_matched_total = 0;
@@ -80,6 +89,11 @@ struct cql_stats {
     int64_t select_partition_range_scan_no_bypass_cache = 0;
     int64_t select_parallelized = 0;
 
+    // Sum of the row limits of the pages of paged SELECT queries, and of the
+    // rows they returned. Their ratio is the page fill ratio.
+    uint64_t select_page_rows_limit = 0;
+    uint64_t select_page_rows_returned = 0;
+
     uint64_t minimum_replication_factor_fail_violations = 0;
     uint64_t minimum_replication_factor_warn_violations = 0;
     uint64_t maximum_replication_factor_warn_violations = 0;
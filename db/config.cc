@@ -28,6 +28,7 @@
 #include "cdc/cdc_extension.hh"
 #include "tombstone_gc_extension.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/sstable_value_index_extension.hh"
 #include "db/tags/extension.hh"
 #include "config.hh"
 #include "extensions.hh"
@@ -428,6 +429,16 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
+    , memtable_flush_controller_target_backlog(this, "memtable_flush_controller_target_backlog", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the memtable flush controller adjusts the flush shares with feedback to keep unspooled dirty memory at this portion of the hard limit, instead of deriving the shares from the dirty memory with a fixed curve.")
+    , compaction_controller_target_backlog(this, "compaction_controller_target_backlog", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the compaction controller adjusts the compaction shares with feedback to keep the normalized compaction backlog at this value, instead of deriving the shares from the backlog with a fixed curve. The backlog is normalized by the shard's memory, and the controller gives maximum shares at a backlog of 30.")
+    , backlog_controller_proportional_gain(this, "backlog_controller_proportional_gain", liveness::LiveUpdate, value_status::Used, 1.0,
+        "Proportional gain of the memtable flush and compaction controllers when they have a target backlog.")
+    , backlog_controller_integral_gain(this, "backlog_controller_integral_gain", liveness::LiveUpdate, value_status::Used, 0.1,
+        "Integral gain, per second, of the memtable flush and compaction controllers when they have a target backlog.")
+    , backlog_controller_derivative_gain(this, "backlog_controller_derivative_gain", liveness::LiveUpdate, value_status::Used, 0.05,
+        "Derivative gain, in seconds, of the memtable flush and compaction controllers when they have a target backlog.")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
         "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold.")
     , compaction_flush_all_tables_before_major_seconds(this, "compaction_flush_all_tables_before_major_seconds", value_status::Used, 86400,
@@ -535,6 +546,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Throttles compaction to the specified total throughput across the entire system. The faster you insert data, the faster you need to compact in order to keep the SSTable count down. The recommended Value is 16 to 32 times the rate of write throughput (in MBs/second). Setting the value to 0 disables compaction throttling.\n"
         "\n"
         "Related information: Configuring compaction")
+    , compaction_pipeline_depth(this, "compaction_pipeline_depth", liveness::LiveUpdate, value_status::Used, 0,
+        "Number of input buffers a compaction reads, decompresses and merges ahead of serializing, compressing and writing its output, so that the two sides overlap. Applies to compactions started after a change. Setting the value to 0 disables pipelining, which is the default.")
+    , compaction_checkpoint_major(this, "compaction_checkpoint_major", liveness::LiveUpdate, value_status::Used, true,
+        "Record the progress of major compactions which split their output into several sstables each time one of them is sealed, so that a major compaction interrupted by a restart or an abort resumes from where it stopped when it is requested again, instead of starting over.")
+    , compaction_maintenance_batch_threshold_in_mb(this, "compaction_maintenance_batch_threshold_in_mb", liveness::LiveUpdate, value_status::Used, 0,
+        "Tables whose data on a shard is smaller than this value have their cleanup and sstable upgrade run back to back in a single maintenance slot, instead of each of them being scheduled and queueing for a slot separately. Useful with many small tables. Setting the value to 0 disables batching.")
     , compaction_large_partition_warning_threshold_mb(this, "compaction_large_partition_warning_threshold_mb", liveness::LiveUpdate, value_status::Used, 1000,
         "Log a warning when writing partitions larger than this value.")
     , compaction_large_row_warning_threshold_mb(this, "compaction_large_row_warning_threshold_mb", liveness::LiveUpdate, value_status::Used, 10,
@@ -780,6 +797,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , query_page_size_in_bytes(this, "query_page_size_in_bytes", liveness::LiveUpdate, value_status::Used, 1 << 20,
         "The size of pages in bytes, after a page accumulates this much data, the page is cut and sent to the client."
         " Setting a too large value increases the risk of OOM.")
+    , enable_adaptive_paging(this, "enable_adaptive_paging", liveness::LiveUpdate, value_status::Used, false,
+        "Let the coordinator choose the number of rows in each page of a paged query, instead of using the page size requested by the client,"
+        " so that pages are close to query_page_size_in_bytes in size and to adaptive_paging_time_budget_in_ms in latency."
+        " Replicas also read ahead the next page of a query while the client consumes the current one.")
+    , adaptive_paging_time_budget_in_ms(this, "adaptive_paging_time_budget_in_ms", liveness::LiveUpdate, value_status::Used, 100,
+        "The latency targeted by each page with adaptive paging. 0 means pages are only sized by query_page_size_in_bytes.")
+    , adaptive_paging_min_rows(this, "adaptive_paging_min_rows", liveness::LiveUpdate, value_status::Used, 100,
+        "The minimum number of rows adaptive paging will ask for in a page, unless the client asked for fewer.")
     , group0_tombstone_gc_refresh_interval_in_ms(this, "group0_tombstone_gc_refresh_interval_in_ms", value_status::Used,
               std::chrono::duration_cast<std::chrono::milliseconds>(60min).count(),
               "The interval in milliseconds at which we update the time point for safe tombstone expiration in group0 tables.")
@@ -860,6 +885,21 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Specifies the minimum volume of RPC compression dictionary training.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
+    , enable_mutation_batching(this, "enable_mutation_batching", liveness::LiveUpdate, value_status::Used, false,
+        "When enabled, the coordinator coalesces writes heading for the same replica into a single batched RPC instead of sending one message per write. "
+        "Each write is still acknowledged (or failed) individually. Writes with forwarding (cross-DC) or tracing enabled are never batched.")
+    , mutation_batching_max_delay_in_us(this, "mutation_batching_max_delay_in_us", liveness::LiveUpdate, value_status::Used, 200,
+        "Hard cap on the time, in microseconds, a write may wait on the coordinator for other writes to join its batch.")
+    , mutation_batching_max_mutations(this, "mutation_batching_max_mutations", liveness::LiveUpdate, value_status::Used, 64,
+        "A batch is sent as soon as it holds this many writes, without waiting for mutation_batching_max_delay_in_us to elapse.")
+    , mutation_batching_max_bytes(this, "mutation_batching_max_bytes", liveness::LiveUpdate, value_status::Used, 128 * 1024,
+        "A batch is sent as soon as the total size of its writes reaches this many bytes. Writes larger than this are never batched.")
+    , enable_grouped_partition_reads(this, "enable_grouped_partition_reads", liveness::LiveUpdate, value_status::Used, true,
+        "When a query reads several partitions at a consistency level which needs a single replica (e.g. an IN restriction on the partition key at CL=ONE), "
+        "read all partitions owned by the same replica with a single request, instead of sending one request per partition.")
+    , paxos_state_cache_size(this, "paxos_state_cache_size", liveness::LiveUpdate, value_status::Used, 1000,
+        "The number of keys per shard whose Paxos state is cached in memory by LWT replicas, saving a read of system.paxos in each Paxos round. "
+        "Updates of the state are written through to system.paxos. Tables which use tablets are not cached. Set to 0 to disable the cache.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
         "Enable or disable socket timeout for streaming operations. When a timeout occurs during streaming, streaming is retried from the start of the current file. Avoid setting this value too low, as it can result in a significant amount of data re-streaming.")
     /**
@@ -1173,6 +1213,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Make the system.config table UPDATEable.")
     , enable_parallelized_aggregation(this, "enable_parallelized_aggregation", liveness::LiveUpdate, value_status::Used, true,
             "Use on a new, parallel algorithm for performing aggregate queries.")
+    , secondary_index_base_query_concurrency(this, "secondary_index_base_query_concurrency", liveness::LiveUpdate, value_status::Used, 4096,
+            "The maximum number of base table partitions read in parallel by a query which uses a secondary index. "
+            "The number of partitions read at once starts from 1 and doubles with every batch, until it reaches this limit "
+            "or the results of a batch fill a page.")
     , cql_duplicate_bind_variable_names_refer_to_same_variable(this, "cql_duplicate_bind_variable_names_refer_to_same_variable", liveness::LiveUpdate, value_status::Used, true,
             "A bind variable that appears twice in a CQL query refers to a single variable (if false, no name matching is performed).")
     , alternator_port(this, "alternator_port", value_status::Used, 0, "Alternator API port.")
@@ -1299,6 +1343,10 @@ void db::config::add_per_partition_rate_limit_extension() {
     _extensions->add_schema_extension<db::per_partition_rate_limit_extension>(db::per_partition_rate_limit_extension::NAME);
 }
 
+void db::config::add_sstable_value_index_extension() {
+    _extensions->add_schema_extension<db::sstable_value_index_extension>(db::sstable_value_index_extension::NAME);
+}
+
 void db::config::add_tags_extension() {
     _extensions->add_schema_extension<db::tags_extension>(db::tags_extension::NAME);
 }
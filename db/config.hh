@@ -139,6 +139,7 @@ class config final : public utils::config_file {
     // For testing only
     void add_cdc_extension();
     void add_per_partition_rate_limit_extension();
+    void add_sstable_value_index_extension();
     void add_tags_extension();
     void add_tombstone_gc_extension();
 
@@ -173,6 +174,11 @@ class config final : public utils::config_file {
     named_value<bool> auto_adjust_flush_quota;
     named_value<float> memtable_flush_static_shares;
     named_value<float> compaction_static_shares;
+    named_value<float> memtable_flush_controller_target_backlog;
+    named_value<float> compaction_controller_target_backlog;
+    named_value<float> backlog_controller_proportional_gain;
+    named_value<float> backlog_controller_integral_gain;
+    named_value<float> backlog_controller_derivative_gain;
     named_value<bool> compaction_enforce_min_threshold;
     named_value<uint32_t> compaction_flush_all_tables_before_major_seconds;
     named_value<sstring> cluster_name;
@@ -194,6 +200,9 @@ class config final : public utils::config_file {
     named_value<bool> rpc_interface_prefer_ipv6;
     named_value<seed_provider_type> seed_provider;
     named_value<uint32_t> compaction_throughput_mb_per_sec;
+    named_value<uint32_t> compaction_pipeline_depth;
+    named_value<bool> compaction_checkpoint_major;
+    named_value<uint32_t> compaction_maintenance_batch_threshold_in_mb;
     named_value<uint32_t> compaction_large_partition_warning_threshold_mb;
     named_value<uint32_t> compaction_large_row_warning_threshold_mb;
     named_value<uint32_t> compaction_large_cell_warning_threshold_mb;
@@ -269,6 +278,9 @@ class config final : public utils::config_file {
     named_value<uint32_t> tombstone_failure_threshold;
     named_value<uint64_t> query_tombstone_page_limit;
     named_value<uint64_t> query_page_size_in_bytes;
+    named_value<bool> enable_adaptive_paging;
+    named_value<uint32_t> adaptive_paging_time_budget_in_ms;
+    named_value<uint32_t> adaptive_paging_min_rows;
     named_value<uint32_t> group0_tombstone_gc_refresh_interval_in_ms;
     named_value<uint32_t> range_request_timeout_in_ms;
     named_value<uint32_t> read_request_timeout_in_ms;
@@ -294,6 +306,12 @@ class config final : public utils::config_file {
     named_value<uint32_t> rpc_dict_training_min_time_seconds;
     named_value<uint64_t> rpc_dict_training_min_bytes;
     named_value<bool> inter_dc_tcp_nodelay;
+    named_value<bool> enable_mutation_batching;
+    named_value<uint32_t> mutation_batching_max_delay_in_us;
+    named_value<uint32_t> mutation_batching_max_mutations;
+    named_value<uint32_t> mutation_batching_max_bytes;
+    named_value<bool> enable_grouped_partition_reads;
+    named_value<uint32_t> paxos_state_cache_size;
     named_value<uint32_t> streaming_socket_timeout_in_ms;
     named_value<bool> start_native_transport;
     named_value<uint16_t> native_transport_port;
@@ -421,6 +439,7 @@ class config final : public utils::config_file {
     named_value<tri_mode_restriction> strict_is_not_null_in_views;
     named_value<bool> enable_cql_config_updates;
     named_value<bool> enable_parallelized_aggregation;
+    named_value<uint32_t> secondary_index_base_query_concurrency;
     named_value<bool> cql_duplicate_bind_variable_names_refer_to_same_variable;
 
     named_value<uint16_t> alternator_port;
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2025-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include "exceptions/exceptions.hh"
+#include "schema/schema.hh"
+#include "serializer.hh"
+
+namespace db {
+
+// The sstable_value_index table option lists regular columns whose values
+// are indexed, per partition, in an additional component of each sstable
+// written for the table (see sstables::value_index). Replicas use it to read
+// only the rows which may match an equality restriction on such a column in
+// a single-partition filtering query, without maintaining a view table.
+//
+//     ALTER TABLE t WITH sstable_value_index = {'columns': 'v1, v2'};
+class sstable_value_index_extension : public schema_extension {
+    std::map<sstring, sstring> _options;
+    std::vector<sstring> _columns;
+public:
+    static constexpr auto NAME = "sstable_value_index";
+    static constexpr auto COLUMNS_KEY = "columns";
+
+    sstable_value_index_extension() = default;
+    explicit sstable_value_index_extension(const std::map<sstring, sstring>& options) : _options(options) {
+        for (auto& [key, value] : _options) {
+            if (key != COLUMNS_KEY) {
+                throw exceptions::configuration_exception(format("Unknown {} option '{}'", NAME, key));
+            }
+            std::vector<std::string> names;
+            boost::split(names, value, boost::is_any_of(","));
+            for (auto& name : names) {
+                boost::trim(name);
+                if (!name.empty()) {
+                    _columns.emplace_back(std::move(name));
+                }
+            }
+        }
+    }
+    explicit sstable_value_index_extension(const bytes& b) : sstable_value_index_extension(deserialize(b)) {}
+    explicit sstable_value_index_extension(const sstring& s) {
+        throw std::logic_error("Cannot create sstable value index info from string");
+    }
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(_options);
+    }
+    static std::map<sstring, sstring> deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, std::type_identity<std::map<sstring, sstring>>());
+    }
+
+    future<> validate(const schema& s) const override {
+        if (_columns.empty()) {
+            return make_exception_future<>(exceptions::configuration_exception(format("{} requires at least one column in '{}'", NAME, COLUMNS_KEY)));
+        }
+        if (!s.clustering_key_size()) {
+            return make_exception_future<>(exceptions::configuration_exception(format("{} requires a table with clustering columns", NAME)));
+        }
+        for (auto it = _columns.begin(); it != _columns.end(); ++it) {
+            auto def = s.get_column_definition(to_bytes(*it));
+            if (!def) {
+                return make_exception_future<>(exceptions::configuration_exception(format("{}: unknown column {}", NAME, *it)));
+            }
+            if (!def->is_regular() || def->is_multi_cell() || def->is_counter() || !def->type->is_byte_order_equal()) {
+                return make_exception_future<>(exceptions::configuration_exception(
+                        format("{}: column {} must be a regular, non-counter column of a type with a unique binary representation (e.g. not a collection or a decimal)", NAME, *it)));
+            }
+            if (std::find(_columns.begin(), it, *it) != it) {
+                return make_exception_future<>(exceptions::configuration_exception(format("{}: duplicate column {}", NAME, *it)));
+            }
+        }
+        return make_ready_future<>();
+    }
+
+    const std::vector<sstring>& columns() const {
+        return _columns;
+    }
+
+    // The indexed columns of `s` which exist in it, in the order of the option.
+    static std::vector<const column_definition*> indexed_columns(const schema& s) {
+        std::vector<const column_definition*> ret;
+        auto it = s.extensions().find(NAME);
+        if (it == s.extensions().end()) {
+            return ret;
+        }
+        auto ext = dynamic_pointer_cast<sstable_value_index_extension>(it->second);
+        if (!ext) {
+            return ret;
+        }
+        for (auto& name : ext->columns()) {
+            auto def = s.get_column_definition(to_bytes(name));
+            if (def && def->is_regular() && !def->is_multi_cell()) {
+                ret.push_back(def);
+            }
+        }
+        return ret;
+    }
+};
+
+}
@@ -411,6 +411,27 @@ schema_ptr system_keyspace::repair_history() {
     return schema;
 }
 
+schema_ptr system_keyspace::compaction_checkpoints() {
+    static thread_local auto schema = [] {
+        auto id = generate_legacy_id(NAME, COMPACTION_CHECKPOINTS);
+        return schema_builder(NAME, COMPACTION_CHECKPOINTS, std::optional(id))
+            .with_column("table_uuid", uuid_type, column_kind::partition_key)
+            .with_column("run_id", uuid_type, column_kind::clustering_key)
+            .with_column("keyspace_name", utf8_type, column_kind::static_column)
+            .with_column("table_name", utf8_type, column_kind::static_column)
+            .with_column("inputs", set_type_impl::get_instance(utf8_type, true))
+            .with_column("last_key", bytes_type)
+            .with_column("bytes_total", long_type)
+            .with_column("bytes_done", long_type)
+            .set_comment("Progress of unfinished major compactions")
+            // Checkpoints of compactions which are never resumed are eventually dropped.
+            .set_default_time_to_live(std::chrono::duration_cast<std::chrono::seconds>(days(7)))
+            .with_hash_version()
+            .build();
+    }();
+    return schema;
+}
+
 schema_ptr system_keyspace::built_indexes() {
     static thread_local auto built_indexes = [] {
         schema_builder builder(generate_legacy_id(NAME, BUILT_INDEXES), NAME, BUILT_INDEXES,
@@ -2306,7 +2327,7 @@ std::vector<schema_ptr> system_keyspace::all_tables(const db::config& cfg) {
                     compactions_in_progress(), compaction_history(),
                     sstable_activity(), size_estimates(), large_partitions(), large_rows(), large_cells(),
                     scylla_local(), db::schema_tables::scylla_table_schema_history(),
-                    repair_history(),
+                    repair_history(), compaction_checkpoints(),
                     v3::views_builds_in_progress(), v3::built_views(),
                     v3::scylla_views_builds_in_progress(),
                     v3::truncated(),
@@ -2470,6 +2491,43 @@ future<> system_keyspace::get_repair_history(::table_id table_id, repair_history
     });
 }
 
+future<> system_keyspace::save_compaction_checkpoint(compaction_checkpoint_entry entry) {
+    sstring req = format("INSERT INTO system.{} (table_uuid, run_id, keyspace_name, table_name, inputs, last_key, bytes_total, bytes_done) VALUES (?, ?, ?, ?, ?, ?, ?, ?)", COMPACTION_CHECKPOINTS);
+    auto set_type = set_type_impl::get_instance(utf8_type, true);
+    auto inputs = entry.inputs | std::views::transform([] (const sstring& gen) { return data_value(gen); }) | std::ranges::to<std::vector>();
+    co_await execute_cql(req, entry.table_uuid.uuid(), entry.run_id, entry.ks, entry.cf, make_set_value(set_type, std::move(inputs)),
+            std::move(entry.last_key), entry.bytes_total, entry.bytes_done).discard_result();
+}
+
+future<std::vector<compaction_checkpoint_entry>> system_keyspace::get_compaction_checkpoints(::table_id table_id) {
+    sstring req = format("SELECT * from system.{} WHERE table_uuid = {}", COMPACTION_CHECKPOINTS, table_id);
+    std::vector<compaction_checkpoint_entry> ret;
+    co_await _qp.query_internal(req, [&ret] (const cql3::untyped_result_set::row& row) mutable -> future<stop_iteration> {
+        if (!row.has("last_key")) {
+            co_return stop_iteration::no;
+        }
+        compaction_checkpoint_entry entry;
+        entry.table_uuid = ::table_id(row.get_as<utils::UUID>("table_uuid"));
+        entry.run_id = row.get_as<utils::UUID>("run_id");
+        entry.ks = row.get_as<sstring>("keyspace_name");
+        entry.cf = row.get_as<sstring>("table_name");
+        if (row.has("inputs")) {
+            entry.inputs = row.get_set<sstring>("inputs");
+        }
+        entry.last_key = row.get_blob("last_key");
+        entry.bytes_total = row.get_or<int64_t>("bytes_total", 0);
+        entry.bytes_done = row.get_or<int64_t>("bytes_done", 0);
+        ret.push_back(std::move(entry));
+        co_return stop_iteration::no;
+    });
+    co_return ret;
+}
+
+future<> system_keyspace::remove_compaction_checkpoint(::table_id table_id, utils::UUID run_id) {
+    sstring req = format("DELETE FROM system.{} WHERE table_uuid = ? AND run_id = ?", COMPACTION_CHECKPOINTS);
+    co_await execute_cql(req, table_id.uuid(), run_id).discard_result();
+}
+
 future<gms::generation_type> system_keyspace::increment_and_get_generation() {
     auto req = format("SELECT gossip_generation FROM system.{} WHERE key='{}'", LOCAL, LOCAL);
     auto rs = co_await _qp.execute_internal(req, cql3::query_processor::cache_internal::yes);
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include "gms/gossiper.hh"
@@ -123,6 +124,21 @@ struct compaction_history_entry {
     std::unordered_map<int32_t, int64_t> rows_merged;
 };
 
+// Progress of an unfinished compaction, recorded each time it seals an output sstable.
+struct compaction_checkpoint_entry {
+    table_id table_uuid;
+    // Run identifier of the output sstables.
+    utils::UUID run_id;
+    sstring ks;
+    sstring cf;
+    // Generations of the input sstables which weren't replaced by outputs yet.
+    std::unordered_set<sstring> inputs;
+    // All the data of the inputs up to and including this partition key is in sealed outputs.
+    bytes last_key;
+    int64_t bytes_total = 0;
+    int64_t bytes_done = 0;
+};
+
 class system_keyspace : public seastar::peering_sharded_service<system_keyspace>, public seastar::async_sharded_service<system_keyspace> {
     cql3::query_processor& _qp;
     replica::database& _db;
@@ -168,6 +184,7 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     static constexpr auto RANGE_XFERS = "range_xfers";
     static constexpr auto COMPACTIONS_IN_PROGRESS = "compactions_in_progress";
     static constexpr auto COMPACTION_HISTORY = "compaction_history";
+    static constexpr auto COMPACTION_CHECKPOINTS = "compaction_checkpoints";
     static constexpr auto SSTABLE_ACTIVITY = "sstable_activity";
     static constexpr auto SIZE_ESTIMATES = "size_estimates";
     static constexpr auto LARGE_PARTITIONS = "large_partitions";
@@ -273,6 +290,7 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     static schema_ptr raft();
     static schema_ptr raft_snapshots();
     static schema_ptr repair_history();
+    static schema_ptr compaction_checkpoints();
     static schema_ptr group0_history();
     static schema_ptr discovery();
     static schema_ptr broadcast_kv_store();
@@ -420,6 +438,10 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     using repair_history_consumer = noncopyable_function<future<>(const repair_history_entry&)>;
     future<> get_repair_history(table_id, repair_history_consumer f);
 
+    future<> save_compaction_checkpoint(compaction_checkpoint_entry);
+    future<std::vector<compaction_checkpoint_entry>> get_compaction_checkpoints(table_id);
+    future<> remove_compaction_checkpoint(table_id, utils::UUID run_id);
+
     future<> save_truncation_record(const replica::column_family&, db_clock::time_point truncated_at, db::replay_position);
     future<replay_positions> get_truncated_positions(table_id);
     future<> drop_truncation_rp_records();
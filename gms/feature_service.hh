@@ -159,6 +159,12 @@ class feature_service final : public peering_sharded_service<feature_service> {
 
     gms::feature workload_prioritization { *this, "WORKLOAD_PRIORITIZATION"sv };
     gms::feature compression_dicts { *this, "COMPRESSION_DICTS"sv };
+    gms::feature mutation_batch_verb { *this, "MUTATION_BATCH_VERB"sv };
+    gms::feature read_data_multi_verb { *this, "READ_DATA_MULTI_VERB"sv };
+    gms::feature parallelized_group_by { *this, "PARALLELIZED_GROUP_BY"sv };
+    gms::feature replica_side_filtering { *this, "REPLICA_SIDE_FILTERING"sv };
+    gms::feature covering_indexes { *this, "COVERING_INDEXES"sv };
+    gms::feature sstable_value_index { *this, "SSTABLE_VALUE_INDEX"sv };
 public:
 
     const std::unordered_map<sstring, std::reference_wrapper<feature>>& registered_features() const;
@@ -29,6 +29,10 @@ struct mapreduce_request {
         count,
         aggregate
     };
+    struct grouping_info {
+        std::vector<sstring> column_names;
+        uint64_t max_groups;
+    };
 
     std::vector<query::mapreduce_request::reduction_type> reduction_types;
 
@@ -39,10 +43,13 @@ struct mapreduce_request {
     lowres_system_clock::time_point timeout;
 
     std::optional<std::vector<query::mapreduce_request::aggregation_info>> aggregation_infos [[version 5.1]];
+    std::optional<query::mapreduce_request::grouping_info> grouping [[version 6.3.0]];
 };
 
 struct mapreduce_result {
     std::vector<bytes_opt> query_results;
+    std::vector<std::vector<bytes_opt>> grouped_query_results [[version 6.3.0]];
+    bool groups_overflow [[version 6.3.0]];
 };
 
 verb mapreduce_request(query::mapreduce_request req [[ref]], std::optional<tracing::trace_info> trace_info [[ref]]) -> query::mapreduce_result;
@@ -46,6 +46,25 @@ struct max_result_size {
     uint64_t page_size [[version 4.7]] = 0;
 }
 
+struct column_restriction {
+    enum class comparison : uint8_t {
+        eq,
+        neq,
+        lt,
+        lte,
+        gt,
+        gte,
+    };
+
+    uint32_t column;
+    query::column_restriction::comparison cmp;
+    bytes value;
+};
+
+struct row_filter {
+    std::vector<query::column_restriction> restrictions;
+};
+
 class read_command {
     table_id cf_id;
     table_schema_version schema_version;
@@ -59,6 +78,7 @@ class read_command {
     std::optional<query::max_result_size> max_result_size [[version 4.3]] = std::nullopt;
     uint32_t row_limit_high_bits [[version 4.3]] = 0;
     uint64_t tombstone_limit [[version 5.2]] = query::max_tombstones;
+    std::optional<query::row_filter> row_filter [[version 6.3.0]] = std::nullopt;
 };
 
 }
@@ -155,4 +155,28 @@ sstring target_parser::serialize_targets(const std::vector<::shared_ptr<cql3::st
     return rjson::print(json_map);
 }
 
+std::vector<sstring> target_parser::get_included_columns(const index_metadata& im) {
+    auto it = im.options().find(cql3::statements::index_target::included_columns_option_name);
+    if (it == im.options().end()) {
+        return {};
+    }
+    rjson::value json_value = rjson::parse(it->second);
+    if (!json_value.IsArray()) {
+        throw std::runtime_error(format("Included columns of index {} must be a JSON array: {}", im.name(), it->second));
+    }
+    std::vector<sstring> columns;
+    for (const rjson::value& v : json_value.GetArray()) {
+        columns.emplace_back(rjson::to_string_view(v));
+    }
+    return columns;
+}
+
+sstring target_parser::serialize_included_columns(const std::vector<::shared_ptr<cql3::column_identifier>>& columns) {
+    rjson::value json_array = rjson::empty_array();
+    for (const auto& column : columns) {
+        rjson::push_back(json_array, rjson::from_string(column->text()));
+    }
+    return rjson::print(json_array);
+}
+
 }
@@ -29,12 +29,17 @@ index::index(const sstring& target_column, const index_metadata& im)
     : _im{im}
     , _target_type{cql3::statements::index_target::from_target_string(target_column)}
     , _target_column{cql3::statements::index_target::column_name_from_target_string(target_column)}
+    , _included_columns{target_parser::get_included_columns(im)}
 {}
 
 bool index::depends_on(const column_definition& cdef) const {
     return cdef.name_as_text() == _target_column;
 }
 
+bool index::includes(const column_definition& cdef) const {
+    return std::ranges::find(_included_columns, cdef.name_as_text()) != _included_columns.end();
+}
+
 index::supports_expression_v index::supports_expression(const column_definition& cdef, const cql3::expr::oper_t op) const {
     using target_type = cql3::statements::index_target::target_type;
     auto collection_yes = supports_expression_v::from_bool_collection(true);
@@ -294,9 +299,25 @@ view_ptr secondary_index_manager::create_view_for_index(const index_metadata& im
         }
     }
 
+    // Columns of the INCLUDE clause are copied to the view, so queries which
+    // only select them (and key columns) do not need to read the base table.
+    auto included_columns = target_parser::get_included_columns(im);
+    auto is_included = [&] (const column_definition& def) {
+        return std::ranges::find(included_columns, def.name_as_text()) != included_columns.end();
+    };
+    for (auto& name : included_columns) {
+        const auto* def = schema->get_column_definition(to_bytes(name));
+        if (!def || !def->is_regular()) {
+            throw exceptions::invalid_request_exception(format("Included column {} is not a regular column of table {}", name, schema->cf_name()));
+        }
+        builder.with_column(def->name(), def->type, column_kind::regular_column);
+    }
+
     if (index_target->is_primary_key()) {
         for (auto& def : schema->regular_columns()) {
-            db::view::create_virtual_column(builder, def.name(), def.type);
+            if (!is_included(def)) {
+                db::view::create_virtual_column(builder, def.name(), def.type);
+            }
         }
     }
     // "WHERE col IS NOT NULL" is not needed (and doesn't work)
@@ -53,9 +53,13 @@ class index {
     index_metadata _im;
     cql3::statements::index_target::target_type _target_type;
     sstring _target_column;
+    std::vector<sstring> _included_columns;
 public:
     index(const sstring& target_column, const index_metadata& im);
     bool depends_on(const column_definition& cdef) const;
+    // Whether the index view stores a copy of the given base column, so
+    // queries selecting it can be answered without reading the base table.
+    bool includes(const column_definition& cdef) const;
     struct supports_expression_v {
         enum class value_type {
             UsualYes,
@@ -84,6 +88,9 @@ class index {
     cql3::statements::index_target::target_type target_type() const {
         return _target_type;
     }
+    const std::vector<sstring>& included_columns() const {
+        return _included_columns;
+    }
 };
 
 class secondary_index_manager {
@@ -30,6 +30,12 @@ struct target_parser {
     static sstring get_target_column_name_from_string(const sstring& targets);
 
     static sstring serialize_targets(const std::vector<::shared_ptr<cql3::statements::index_target>>& targets);
+
+    // Returns the names of the regular columns which the index view stores
+    // in addition to the keys (the INCLUDE clause of CREATE INDEX).
+    static std::vector<sstring> get_included_columns(const index_metadata& im);
+
+    static sstring serialize_included_columns(const std::vector<::shared_ptr<cql3::column_identifier>>& columns);
 };
 
 }
@@ -105,6 +105,7 @@
 #include "tools/entry_point.hh"
 #include "test/perf/entry_point.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/sstable_value_index_extension.hh"
 #include "lang/manager.hh"
 #include "sstables/sstables_manager.hh"
 #include "db/virtual_tables.hh"
@@ -729,6 +730,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
     ext->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
     ext->add_schema_extension<tombstone_gc_extension>(tombstone_gc_extension::NAME);
     ext->add_schema_extension<db::per_partition_rate_limit_extension>(db::per_partition_rate_limit_extension::NAME);
+    ext->add_schema_extension<db::sstable_value_index_extension>(db::sstable_value_index_extension::NAME);
 
     auto cfg = make_lw_shared<db::config>(ext);
     auto init = app.get_options_description().add_options();
@@ -1232,7 +1234,16 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .maintenance_sched_group = compaction_manager::scheduling_group{dbcfg.streaming_scheduling_group},
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
+                    .controller_feedback = {
+                        .target_backlog = cfg->compaction_controller_target_backlog,
+                        .kp = cfg->backlog_controller_proportional_gain,
+                        .ki = cfg->backlog_controller_integral_gain,
+                        .kd = cfg->backlog_controller_derivative_gain,
+                    },
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .pipeline_depth = cfg->compaction_pipeline_depth,
+                    .checkpoint_major = cfg->compaction_checkpoint_major,
+                    .maintenance_batch_threshold_in_mb = cfg->compaction_maintenance_batch_threshold_in_mb,
                     .flush_all_tables_before_major = cfg->compaction_flush_all_tables_before_major_seconds() * 1s,
                 };
             });
@@ -2441,6 +2452,7 @@ int main(int ac, char** av) {
         {"perf-load-balancing", perf::scylla_tablet_load_balancing_main, "run tablet load balancer tests"},
         {"perf-simple-query", perf::scylla_simple_query_main, "run performance tests by sending simple queries to this server"},
         {"perf-sstable", perf::scylla_sstable_main, "run performance tests by exercising sstable related operations on this server"},
+        {"perf-compaction-strategy", perf::scylla_compaction_strategy_main, "run simulations of compaction strategies under synthetic workloads and report their amplification"},
         {"perf-alternator", perf::alternator(scylla_main, &after_init_func), "run performance tests on full alternator stack"}
     };
 
@@ -689,7 +689,9 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
         return 1;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
+    case messaging_verb::READ_DATA_MULTI:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
     case messaging_verb::DEFINITIONS_UPDATE:
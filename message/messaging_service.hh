@@ -208,7 +208,9 @@ enum class messaging_verb : int32_t {
     TASKS_GET_CHILDREN = 74,
     TABLET_REPAIR = 75,
     TRUNCATE_WITH_TABLETS = 76,
-    LAST = 77,
+    MUTATION_BATCH = 77,
+    READ_DATA_MULTI = 78,
+    LAST = 79,
 };
 
 } // namespace netw
@@ -274,7 +274,8 @@ class read_context : public reader_lifecycle_policy_v2 {
             rm.rparts->permit.set_max_result_size(get_max_result_size());
             co_return rm.rparts->permit;
         }
-        auto permit = co_await _db.local().obtain_reader_permit(std::move(schema), description, timeout, std::move(trace_ptr));
+        auto& table = _db.local().find_column_family(schema);
+        auto permit = co_await _db.local().obtain_reader_permit(table, description, timeout, std::move(trace_ptr), table.estimate_read_cost_class(_ranges));
         permit.set_max_result_size(get_max_result_size());
         co_return permit;
     }
@@ -718,6 +719,7 @@ future<page_consume_result<ResultBuilder>> read_page(
         noncopyable_function<ResultBuilder()> result_builder_factory) {
     auto compaction_state = make_lw_shared<compact_for_query_state_v2>(*s, cmd.timestamp, cmd.slice, cmd.get_row_limit(),
             cmd.partition_limit);
+    ResultBuilder::maybe_set_row_filter(*compaction_state, cmd);
 
     auto reader = make_multishard_combining_reader_v2(ctx, s, ctx->erm(), ctx->permit(), ranges.front(), cmd.slice,
             trace_state, mutation_reader::forwarding(ranges.size() > 1));
@@ -910,6 +912,7 @@ class mutation_query_result_builder {
     }
 
     static void maybe_set_last_position(result_type& r, std::optional<full_position> full_position) { }
+    static void maybe_set_row_filter(compact_for_query_state_v2& compaction_state, const query::read_command& cmd) { }
     static uint32_t get_partition_count(result_type& r) { return r.partitions().size(); }
     static uint64_t get_row_count(result_type& r) { return r.row_count(); }
 };
@@ -970,6 +973,9 @@ class data_query_result_builder {
     static void maybe_set_last_position(result_type& r, std::optional<full_position> full_position) {
         r.set_last_position(std::move(full_position));
     }
+    static void maybe_set_row_filter(compact_for_query_state_v2& compaction_state, const query::read_command& cmd) {
+        compaction_state.set_row_filter(cmd.row_filter);
+    }
     static uint32_t get_partition_count(result_type& r) {
         r.ensure_counts();
         return *r.partition_count();
@@ -13,6 +13,7 @@
 #include "mutation_fragment_stream_validator.hh"
 #include "tombstone_gc.hh"
 #include "full_position.hh"
+#include "query-request.hh"
 #include <type_traits>
 #include "utils/log.hh"
 
@@ -136,6 +137,13 @@ struct compaction_stats {
         return static_rows.cell_stats.dead_cells + clustering_rows.cell_stats.dead_cells +
             static_rows.cell_stats.collection_tombstones + clustering_rows.cell_stats.collection_tombstones;
     }
+    uint64_t live_rows() const {
+        return static_rows.live + clustering_rows.live;
+    }
+    // Dead rows and range tombstones.
+    uint64_t dead_rows() const {
+        return static_rows.dead + clustering_rows.dead + range_tombstones;
+    }
 
     uint64_t partitions = 0;
     row_stats static_rows;
@@ -185,6 +193,9 @@ class compact_mutation_state {
 
     mutation_fragment_stream_validating_filter _validator;
 
+    // Live clustering rows not matching the filter are passed as dead, see set_row_filter().
+    std::optional<query::row_filter> _row_filter;
+
     // Remember if we requested to stop mid-partition.
     stop_iteration _stop = stop_iteration::no;
 private:
@@ -455,6 +466,14 @@ class compact_mutation_state {
             }
         }
 
+        if (!sstable_compaction() && is_live && _row_filter && !_row_filter->matches(_schema, cr.cells())) {
+            // Pass only the key, as a dead row, so that the consumer counts it
+            // like a tombstone and cuts the page when too many were scanned.
+            partition_is_not_empty(consumer);
+            _stop = consumer.consume(clustering_row(std::move(cr.key())), t, false);
+            return _stop;
+        }
+
         if (!cr.empty()) {
             partition_is_not_empty(consumer);
             _stop = consumer.consume(std::move(cr), t, is_live);
@@ -543,6 +562,16 @@ class compact_mutation_state {
         }
     }
 
+    /// Drop the live clustering rows which don't match `filter`, passing only
+    /// their key to the consumer, as dead rows. Dropped rows don't count towards
+    /// the row limits, but towards the tombstone limit of the page, so that a
+    /// page which matches few rows doesn't scan the whole range.
+    /// Only valid for data queries, see \ref query::row_filter.
+    void set_row_filter(std::optional<query::row_filter> filter) {
+        static_assert(!sstable_compaction(), "Row filters cannot be used for sstable compaction.");
+        _row_filter = std::move(filter);
+    }
+
     /// The decorated key of the partition the compaction is positioned in.
     /// Can be null if the compaction wasn't started yet.
     const dht::decorated_key* current_partition() const {
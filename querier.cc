@@ -313,6 +313,52 @@ void querier_cache::insert_data_querier(query_id key, querier&& q, tracing::trac
     insert_querier(key, _data_querier_index, _stats, std::move(q), _entry_ttl, std::move(trace_state));
 }
 
+future<> querier_cache::prefetch_and_insert_data_querier(query_id key, querier q, tracing::trace_state_ptr trace_state, utils::phased_barrier::operation read_op) {
+    std::exception_ptr ex;
+    try {
+        co_await q.fill_buffer();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        qlogger.debug("Failed to read ahead the next page of querier with key {}: {}", key, ex);
+        co_await q.close();
+    } else {
+        q.set_prefetched(true);
+        insert_data_querier(key, std::move(q), std::move(trace_state));
+    }
+    if (auto it = _prefetches.find(key); it != _prefetches.end()) {
+        it->second.set_value();
+        _prefetches.erase(it);
+    }
+}
+
+void querier_cache::insert_data_querier_with_prefetch(query_id key, querier&& q, tracing::trace_state_ptr trace_state, utils::phased_barrier::operation read_op) {
+    // Reversed queriers are not cached, see insert_querier(). Only one
+    // querier per key can be read ahead, which is all a data query saves.
+    if (q.is_reversed() || _prefetches.contains(key) || _closing_gate.is_closed()) {
+        insert_data_querier(key, std::move(q), std::move(trace_state));
+        return;
+    }
+
+    ++_stats.prefetches;
+    tracing::trace(trace_state, "Reading ahead the next page of querier with key {}", key);
+    _prefetches.emplace(key, shared_promise<>());
+
+    // It is safe to do this in the background, since _closing_gate is closed
+    // and waited on in querier_cache::stop()
+    (void)with_gate(_closing_gate, [this, key, q = std::move(q), trace_state = std::move(trace_state), read_op = std::move(read_op)] () mutable {
+        return prefetch_and_insert_data_querier(key, std::move(q), std::move(trace_state), std::move(read_op));
+    });
+}
+
+future<> querier_cache::wait_for_prefetch(query_id key) {
+    if (auto it = _prefetches.find(key); it != _prefetches.end()) {
+        return it->second.get_shared_future();
+    }
+    return make_ready_future<>();
+}
+
 void querier_cache::insert_mutation_querier(query_id key, querier&& q, tracing::trace_state_ptr trace_state) {
     insert_querier(key, _mutation_querier_index, _stats, std::move(q), _entry_ttl, std::move(trace_state));
 }
@@ -354,6 +400,10 @@ std::optional<Querier> querier_cache::lookup_querier(
 
     const auto can_be_used = can_be_used_for_page(_is_user_semaphore_func, q, s, ranges.front(), slice, current_sem);
     if (can_be_used == can_use::yes) {
+        if (q.prefetched()) {
+            ++stats.prefetch_hits;
+            q.set_prefetched(false);
+        }
         tracing::trace(trace_state, "Reusing querier");
         return std::optional<Querier>(std::move(q));
     }
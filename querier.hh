@@ -8,12 +8,14 @@
 
 #pragma once
 
+#include <seastar/core/shared_future.hh>
 #include <seastar/util/closeable.hh>
 
 #include "mutation/mutation_compactor.hh"
 #include "reader_concurrency_semaphore.hh"
 #include "readers/mutation_source.hh"
 #include "full_position.hh"
+#include "utils/phased_barrier.hh"
 
 #include <boost/intrusive/set.hpp>
 
@@ -69,6 +71,7 @@ class querier_base {
     std::variant<mutation_reader, reader_concurrency_semaphore::inactive_read_handle> _reader;
     dht::partition_ranges_view _query_ranges;
     querier_config _qr_config;
+    bool _prefetched = false;
 
 public:
     querier_base(reader_permit permit, lw_shared_ptr<const dht::partition_range> range,
@@ -120,6 +123,20 @@ class querier_base {
         return _permit.consumed_resources().memory;
     }
 
+    /// Read ahead the start of the next page into the buffer of the reader.
+    future<> fill_buffer() {
+        return std::get<mutation_reader>(_reader).fill_buffer();
+    }
+
+    /// Whether the buffer of the reader was filled ahead of the next page.
+    bool prefetched() const {
+        return _prefetched;
+    }
+
+    void set_prefetched(bool prefetched) {
+        _prefetched = prefetched;
+    }
+
     future<> close() noexcept;
 };
 
@@ -169,6 +186,16 @@ class querier : public querier_base {
         return  _compaction_state->are_limits_reached();
     }
 
+    // See compact_mutation_state::set_row_filter().
+    void set_row_filter(std::optional<query::row_filter> filter) {
+        _compaction_state->set_row_filter(std::move(filter));
+    }
+
+    // Statistics of the last page consumed.
+    const compaction_stats& page_stats() const {
+        return _compaction_state->stats();
+    }
+
     template <typename Consumer>
     requires CompactedFragmentsConsumerV2<Consumer>
     auto consume_page(Consumer&& consumer,
@@ -191,11 +218,7 @@ class querier : public querier_base {
                     cstats.live_cells() + cstats.dead_cells(),
                     cstats.live_cells(),
                     cstats.dead_cells());
-            maybe_log_tombstone_warning(
-                    "rows",
-                    cstats.static_rows.live + cstats.clustering_rows.live,
-                    cstats.static_rows.dead + cstats.clustering_rows.dead + cstats.range_tombstones,
-                    row_tombstone_warn_rate_limit);
+            maybe_log_tombstone_warning("rows", cstats.live_rows(), cstats.dead_rows(), row_tombstone_warn_rate_limit);
             maybe_log_tombstone_warning("cells", cstats.live_cells(), cstats.dead_cells(), cell_tombstone_warn_rate_limit);
             return std::move(fut);
         });
@@ -315,6 +338,12 @@ class querier_cache {
         // The number of queries dropped due to scheduling group mismatch
         // between semaphores
         uint64_t scheduling_group_mismatches = 0;
+        // The number of queriers which read ahead their next page before
+        // being inserted.
+        uint64_t prefetches = 0;
+        // The subset of lookups that hit a querier which read ahead its
+        // next page.
+        uint64_t prefetch_hits = 0;
     };
 
     using index = std::unordered_multimap<query_id, std::unique_ptr<querier_base>>;
@@ -328,6 +357,8 @@ class querier_cache {
     stats _stats;
     gate _closing_gate;
     is_user_semaphore_func _is_user_semaphore_func;
+    // Queriers reading ahead their next page, before being inserted.
+    std::unordered_map<query_id, shared_promise<>> _prefetches;
 
 private:
     template <typename Querier>
@@ -350,6 +381,8 @@ class querier_cache {
         tracing::trace_state_ptr trace_state,
         db::timeout_clock::time_point timeout);
 
+    future<> prefetch_and_insert_data_querier(query_id key, querier q, tracing::trace_state_ptr trace_state, utils::phased_barrier::operation read_op);
+
 public:
     querier_cache(is_user_semaphore_func is_user_semaphore_func, std::chrono::seconds entry_ttl = default_entry_ttl);
 
@@ -362,6 +395,19 @@ class querier_cache {
 
     void insert_data_querier(query_id key, querier&& q, tracing::trace_state_ptr trace_state);
 
+    /// Insert a data querier after reading ahead its next page.
+    ///
+    /// The reader of the querier fills its buffer in the background, while
+    /// the client consumes the current page, then the querier is inserted as
+    /// with insert_data_querier(). Lookups of the querier have to wait for
+    /// this to complete, see wait_for_prefetch(). `read_op` keeps the table
+    /// alive while reading ahead.
+    void insert_data_querier_with_prefetch(query_id key, querier&& q, tracing::trace_state_ptr trace_state, utils::phased_barrier::operation read_op);
+
+    /// Wait until the querier with the given key, if it is reading ahead its
+    /// next page, is inserted into the cache.
+    future<> wait_for_prefetch(query_id key);
+
     void insert_mutation_querier(query_id key, querier&& q, tracing::trace_state_ptr trace_state);
 
     void insert_shard_querier(query_id key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state);
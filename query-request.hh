@@ -30,6 +30,7 @@
 
 class position_in_partition_view;
 class position_in_partition;
+class row;
 class partition_slice_builder;
 
 namespace ser {
@@ -360,6 +361,40 @@ struct max_result_size {
     friend class ser::serializer<query::max_result_size>;
 };
 
+// A restriction on the value of a regular column, of the form
+// `column <cmp> value`.
+struct column_restriction {
+    enum class comparison : uint8_t {
+        eq,
+        neq,
+        lt,
+        lte,
+        gt,
+        gte,
+    };
+
+    column_id column;
+    comparison cmp;
+    bytes value;
+};
+
+// Restrictions of a filtering query which replicas can evaluate on their own,
+// so that they don't send rows which the coordinator would discard anyway.
+//
+// This is only a pre-filter: the coordinator still applies all the query's
+// restrictions to the rows it receives. It is applied to data (and digest)
+// reads only, never to mutation reads, as filtering out rows before
+// reconciliation could resurrect stale values.
+struct row_filter {
+    std::vector<column_restriction> restrictions;
+
+    // True if the regular row `cells` satisfies all restrictions. A column
+    // which is missing, or dead, doesn't satisfy any restriction, like null
+    // doesn't in CQL. Restrictions which can't be evaluated on a single cell
+    // (collections, counters) are ignored.
+    bool matches(const schema& s, const row& cells) const;
+};
+
 // Full specification of a query to the database.
 // Intended for passing across replicas.
 // Can be accessed across cores.
@@ -392,6 +427,9 @@ class read_command {
     uint32_t row_limit_high_bits;
     // Cut the page after processing this many tombstones (even if the page is empty).
     uint64_t tombstone_limit;
+    // Applied by replicas to data reads, see row_filter. Row limits count the
+    // rows which pass it.
+    std::optional<query::row_filter> row_filter;
     api::timestamp_type read_timestamp; // not serialized
     db::allow_per_partition_rate_limit allow_limit; // not serialized
 public:
@@ -407,7 +445,8 @@ class read_command {
                  query::is_first_page is_first_page,
                  std::optional<query::max_result_size> max_result_size,
                  uint32_t row_limit_high_bits,
-                 uint64_t tombstone_limit)
+                 uint64_t tombstone_limit,
+                 std::optional<query::row_filter> row_filter = std::nullopt)
         : cf_id(std::move(cf_id))
         , schema_version(std::move(schema_version))
         , slice(std::move(slice))
@@ -420,6 +459,7 @@ class read_command {
         , max_result_size(max_result_size)
         , row_limit_high_bits(row_limit_high_bits)
         , tombstone_limit(tombstone_limit)
+        , row_filter(std::move(row_filter))
         , read_timestamp(api::new_timestamp())
         , allow_limit(db::allow_per_partition_rate_limit::no)
     { }
@@ -483,6 +523,13 @@ struct mapreduce_request {
         std::vector<reduction_type> types;
         std::vector<aggregation_info> infos;
     };
+    // Groups the rows by a prefix of the primary key (which includes the
+    // whole partition key), reducing each group separately.
+    struct grouping_info {
+        std::vector<sstring> column_names;
+        // A replica gives up on the request once it has more groups than this.
+        uint64_t max_groups;
+    };
 
     std::vector<reduction_type> reduction_types;
 
@@ -492,15 +539,23 @@ struct mapreduce_request {
     db::consistency_level cl;
     lowres_system_clock::time_point timeout;
     std::optional<std::vector<aggregation_info>> aggregation_infos;
+    std::optional<grouping_info> grouping;
 };
 
 std::ostream& operator<<(std::ostream& out, const mapreduce_request& r);
 std::ostream& operator<<(std::ostream& out, const mapreduce_request::reduction_type& r);
 std::ostream& operator<<(std::ostream& out, const mapreduce_request::aggregation_info& a);
+std::ostream& operator<<(std::ostream& out, const mapreduce_request::grouping_info& g);
 
 struct mapreduce_result {
     // vector storing query result for each selected column
     std::vector<bytes_opt> query_results;
+    // For a grouped request: the values of the grouping columns followed by
+    // the query results, for each group.
+    std::vector<std::vector<bytes_opt>> grouped_query_results;
+    // Set if a grouped request had more groups than allowed, in which case
+    // grouped_query_results are incomplete and must not be used.
+    bool groups_overflow = false;
 
     struct printer {
         const std::vector<::shared_ptr<db::functions::aggregate_function>> functions;
@@ -518,4 +573,5 @@ template <> struct fmt::formatter<query::read_command> : fmt::ostream_formatter
 template <> struct fmt::formatter<query::mapreduce_request> : fmt::ostream_formatter {};
 template <> struct fmt::formatter<query::mapreduce_request::reduction_type> : fmt::ostream_formatter {};
 template <> struct fmt::formatter<query::mapreduce_request::aggregation_info> : fmt::ostream_formatter {};
+template <> struct fmt::formatter<query::mapreduce_request::grouping_info> : fmt::ostream_formatter {};
 template <> struct fmt::formatter<query::mapreduce_result::printer> : fmt::ostream_formatter {};
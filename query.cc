@@ -17,6 +17,7 @@
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/thread.hh>
 #include "bytes.hh"
+#include "mutation/mutation_partition.hh"
 #include "mutation/mutation_partition_serializer.hh"
 #include "query-result-reader.hh"
 #include "query_result_merger.hh"
@@ -56,11 +57,59 @@ std::ostream& operator<<(std::ostream& out, const partition_slice& ps) {
 }
 
 std::ostream& operator<<(std::ostream& out, const read_command& r) {
-    fmt::print(out, "read_command{{cf_id={}, version={}, slice={}, limit={}, timestamp={}, partition_limit={}, query_uuid={}, is_first_page={}, read_timestamp={}}}",
-               r.cf_id, r.schema_version, r.slice, r.get_row_limit(), r.timestamp.time_since_epoch().count(), r.partition_limit, r.query_uuid, r.is_first_page, r.read_timestamp);
+    fmt::print(out, "read_command{{cf_id={}, version={}, slice={}, limit={}, timestamp={}, partition_limit={}, query_uuid={}, is_first_page={}, read_timestamp={}, row_filter={}}}",
+               r.cf_id, r.schema_version, r.slice, r.get_row_limit(), r.timestamp.time_since_epoch().count(), r.partition_limit, r.query_uuid, r.is_first_page, r.read_timestamp,
+               r.row_filter ? r.row_filter->restrictions.size() : 0);
     return out;
 }
 
+bool row_filter::matches(const schema& s, const row& cells) const {
+    for (const auto& r : restrictions) {
+        if (r.column >= s.regular_columns_count()) {
+            continue;
+        }
+        const auto& def = s.regular_column_at(r.column);
+        if (def.is_multi_cell() || def.is_counter()) {
+            continue;
+        }
+        const auto* cell = cells.find_cell(r.column);
+        if (!cell) {
+            return false;
+        }
+        auto ac = cell->as_atomic_cell(def);
+        if (!ac.is_live()) {
+            return false;
+        }
+        auto value = ac.value();
+        const auto& type = *def.type;
+        bool match = false;
+        switch (r.cmp) {
+        case column_restriction::comparison::eq:
+            match = type.equal(value, bytes_view(r.value));
+            break;
+        case column_restriction::comparison::neq:
+            match = !type.equal(value, bytes_view(r.value));
+            break;
+        case column_restriction::comparison::lt:
+            match = type.compare(value, bytes_view(r.value)) < 0;
+            break;
+        case column_restriction::comparison::lte:
+            match = type.compare(value, bytes_view(r.value)) <= 0;
+            break;
+        case column_restriction::comparison::gt:
+            match = type.compare(value, bytes_view(r.value)) > 0;
+            break;
+        case column_restriction::comparison::gte:
+            match = type.compare(value, bytes_view(r.value)) >= 0;
+            break;
+        }
+        if (!match) {
+            return false;
+        }
+    }
+    return true;
+}
+
 lw_shared_ptr<query::read_command> reversed(lw_shared_ptr<query::read_command>&& cmd)
 {
     auto schema = local_schema_registry().get(cmd->schema_version)->get_reversed();
@@ -89,6 +138,12 @@ std::ostream& operator<<(std::ostream& out, const mapreduce_request::aggregation
     return out;
 }
 
+std::ostream& operator<<(std::ostream& out, const mapreduce_request::grouping_info& g) {
+    fmt::print(out, "grouping_info{{column_names=[{}], max_groups={}}}",
+               fmt::join(g.column_names, ","), g.max_groups);
+    return out;
+}
+
 std::ostream& operator<<(std::ostream& out, const mapreduce_request& r) {
     auto ms = std::chrono::time_point_cast<std::chrono::milliseconds>(r.timeout).time_since_epoch().count();
     fmt::print(out, "mapreduce_request{{reductions=[{}]",
@@ -97,6 +152,9 @@ std::ostream& operator<<(std::ostream& out, const mapreduce_request& r) {
         fmt::print(out, ", aggregation_infos=[{}]",
                    fmt::join(r.aggregation_infos.value(), ","));
     }
+    if (r.grouping) {
+        fmt::print(out, ", grouping={}", *r.grouping);
+    }
     fmt::print(out, "cmd={}, pr={}, cl={}, timeout(ms)={}}}",
                r.cmd, r.pr, r.cl, ms);
     return out;
@@ -392,6 +450,12 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
 }
 
 std::ostream& operator<<(std::ostream& out, const query::mapreduce_result::printer& p) {
+    if (p.res.groups_overflow) {
+        return out << "[groups overflow]";
+    }
+    if (!p.res.grouped_query_results.empty()) {
+        return out << "[" << p.res.grouped_query_results.size() << " groups]";
+    }
     if (p.functions.size() != p.res.query_results.size()) {
         return out << "[malformed mapreduce_result (" << p.res.query_results.size()
             << " results, " << p.functions.size() << " aggregates)]";
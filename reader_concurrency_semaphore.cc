@@ -164,6 +164,7 @@ class reader_permit::impl
     bool _base_resources_consumed = false;
     reader_resources _resources;
     reader_permit::state _state = reader_permit::state::active;
+    reader_permit::cost_class _cost_class = reader_permit::cost_class::normal;
     uint64_t _need_cpu_branches = 0;
     bool _marked_as_need_cpu = false;
     uint64_t _awaits_branches = 0;
@@ -332,6 +333,14 @@ class reader_permit::impl
         return _state;
     }
 
+    reader_permit::cost_class get_cost_class() const {
+        return _cost_class;
+    }
+
+    void set_cost_class(reader_permit::cost_class cost) {
+        _cost_class = cost;
+    }
+
     auxiliary_data& aux_data() {
         return _aux_data;
     }
@@ -573,6 +582,10 @@ reader_permit::state reader_permit::get_state() const {
     return _impl->get_state();
 }
 
+reader_permit::cost_class reader_permit::get_cost_class() const {
+    return _impl->get_cost_class();
+}
+
 bool reader_permit::needs_readmission() const {
     return _impl->needs_readmission();
 }
@@ -701,6 +714,23 @@ auto fmt::formatter<reader_permit::state>::format(reader_permit::state s, fmt::f
     return formatter<string_view>::format(name, ctx);
 }
 
+auto fmt::formatter<reader_permit::cost_class>::format(reader_permit::cost_class c, fmt::format_context& ctx) const
+        -> decltype(ctx.out()) {
+    std::string_view name;
+    switch (c) {
+        case reader_permit::cost_class::cheap:
+            name = "cheap";
+            break;
+        case reader_permit::cost_class::normal:
+            name = "normal";
+            break;
+        case reader_permit::cost_class::expensive:
+            name = "expensive";
+            break;
+    }
+    return formatter<string_view>::format(name, ctx);
+}
+
 namespace {
 
 struct permit_stats {
@@ -930,9 +960,27 @@ reader_concurrency_semaphore::inactive_read_handle::operator=(inactive_read_hand
     return *this;
 }
 
+bool reader_concurrency_semaphore::wait_queue::empty() const {
+    return _memory_queue.empty() && std::ranges::all_of(_admission_queues, std::mem_fn(&permit_list_type::empty));
+}
+
 void reader_concurrency_semaphore::wait_queue::push_to_admission_queue(reader_permit::impl& p) {
+    const auto c = static_cast<size_t>(p.get_cost_class());
+    if (_admission_queues[c].empty()) {
+        // Don't let a class which was idle accumulate credit: start it from
+        // the pass of the classes currently competing for admission.
+        std::optional<uint64_t> min_pass;
+        for (size_t i = 0; i < reader_permit::cost_class_count; ++i) {
+            if (!_admission_queues[i].empty()) {
+                min_pass = std::min(min_pass.value_or(_pass[i]), _pass[i]);
+            }
+        }
+        if (min_pass) {
+            _pass[c] = std::max(_pass[c], *min_pass);
+        }
+    }
     p.unlink();
-    _admission_queue.push_back(p);
+    _admission_queues[c].push_back(p);
 }
 
 void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permit::impl& p) {
@@ -940,14 +988,29 @@ void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permi
     _memory_queue.push_back(p);
 }
 
+reader_concurrency_semaphore::permit_list_type& reader_concurrency_semaphore::wait_queue::next_admission_queue() {
+    size_t next = reader_permit::cost_class_count;
+    for (size_t i = 0; i < reader_permit::cost_class_count; ++i) {
+        if (!_admission_queues[i].empty() && (next == reader_permit::cost_class_count || _pass[i] < _pass[next])) {
+            next = i;
+        }
+    }
+    return _admission_queues[next];
+}
+
 reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() {
     if (_memory_queue.empty()) {
-        return _admission_queue.front();
+        return next_admission_queue().front();
     } else {
         return _memory_queue.front();
     }
 }
 
+void reader_concurrency_semaphore::wait_queue::on_admitted(const reader_permit::impl& p) {
+    const auto c = static_cast<size_t>(p.get_cost_class());
+    _pass[c] += stride[c];
+}
+
 const reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() const {
     return const_cast<wait_queue&>(*this).front();
 }
@@ -1030,6 +1093,7 @@ void reader_concurrency_semaphore::signal(const resources& r) noexcept {
 
 namespace sm = seastar::metrics;
 static const sm::label class_label("class");
+static const sm::label cost_class_label("cost_class");
 
 reader_concurrency_semaphore::reader_concurrency_semaphore(
         utils::updateable_value<int> count,
@@ -1101,6 +1165,18 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(
                                                "Add the total_reads to this value to get the total amount of reads issued on this shard."),
                                {class_label(_name)}),
                 });
+        for (size_t i = 0; i < reader_permit::cost_class_count; ++i) {
+            const auto cost = fmt::to_string(static_cast<reader_permit::cost_class>(i));
+            _metrics->add_group("database", {
+                    sm::make_counter("reads_admitted_by_cost", _stats.reads_admitted_by_cost_class[i],
+                                   sm::description("Counts the number of admitted reads, by their estimated cost class."),
+                                   {class_label(_name), cost_class_label(cost)}),
+
+                    sm::make_gauge("queued_reads_by_cost", _stats.reads_waiting_for_admission_by_cost_class[i],
+                                   sm::description("Holds the number of reads currently waiting for admission, by their estimated cost class."),
+                                   {class_label(_name), cost_class_label(cost)}),
+                    });
+        }
     }
 }
 
@@ -1346,6 +1422,7 @@ future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit::impl& permi
         permit.on_waiting_for_admission();
         _wait_list.push_to_admission_queue(permit);
         ++_stats.reads_enqueued_for_admission;
+        ++_stats.reads_waiting_for_admission_by_cost_class[static_cast<size_t>(permit.get_cost_class())];
     } else {
         permit.on_waiting_for_memory();
         ad.fut.emplace(std::move(fut));
@@ -1475,6 +1552,7 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit::impl& pe
 
     permit.on_admission();
     ++_stats.reads_admitted;
+    ++_stats.reads_admitted_by_cost_class[static_cast<size_t>(permit.get_cost_class())];
     if (permit.aux_data().func) {
         return with_ready_permit(permit);
     }
@@ -1491,8 +1569,10 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
                 _blessed_permit = &permit;
                 permit.on_granted_memory();
             } else {
+                _wait_list.on_admitted(permit);
                 permit.on_admission();
                 ++_stats.reads_admitted;
+                ++_stats.reads_admitted_by_cost_class[static_cast<size_t>(permit.get_cost_class())];
             }
             if (permit.aux_data().func) {
                 permit.unlink();
@@ -1545,6 +1625,8 @@ future<> reader_concurrency_semaphore::request_memory(reader_permit::impl& permi
 void reader_concurrency_semaphore::dequeue_permit(reader_permit::impl& permit) {
     switch (permit.get_state()) {
         case reader_permit::state::waiting_for_admission:
+            --_stats.reads_waiting_for_admission_by_cost_class[static_cast<size_t>(permit.get_cost_class())];
+            [[fallthrough]];
         case reader_permit::state::waiting_for_memory:
         case reader_permit::state::waiting_for_execution:
             --_stats.waiters;
@@ -1602,16 +1684,18 @@ void reader_concurrency_semaphore::on_permit_not_awaits() noexcept {
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, reader_permit::cost_class cost) {
     auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_cost_class(cost);
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, reader_permit::cost_class cost) {
     auto permit = reader_permit(*this, std::move(schema), std::move(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_cost_class(cost);
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
@@ -1628,8 +1712,9 @@ reader_permit reader_concurrency_semaphore::make_tracking_only_permit(schema_ptr
 }
 
 future<> reader_concurrency_semaphore::with_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func, reader_permit::cost_class cost) {
     auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_cost_class(cost);
     permit->aux_data().func = std::move(func);
     permit->aux_data().permit_keepalive = permit;
     return do_wait_admission(*permit);
@@ -1681,7 +1766,9 @@ std::string reader_concurrency_semaphore::dump_diagnostics(unsigned max_lines) c
 
 void reader_concurrency_semaphore::foreach_permit(noncopyable_function<void(const reader_permit::impl&)> func) const {
     boost::for_each(_permit_list, std::ref(func));
-    boost::for_each(_wait_list._admission_queue, std::ref(func));
+    for (const auto& queue : _wait_list._admission_queues) {
+        boost::for_each(queue, std::ref(func));
+    }
     boost::for_each(_wait_list._memory_queue, std::ref(func));
     boost::for_each(_ready_list, std::ref(func));
 }
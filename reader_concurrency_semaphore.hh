@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/intrusive/list.hpp>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
@@ -124,6 +125,10 @@ class reader_concurrency_semaphore {
         uint64_t sstables_read = 0;
         // Permits waiting on something: admission, memory or execution
         uint64_t waiters = 0;
+        // Total number of reads admitted, by cost class.
+        std::array<uint64_t, reader_permit::cost_class_count> reads_admitted_by_cost_class = {};
+        // Current number of reads waiting for admission, by cost class.
+        std::array<uint64_t, reader_permit::cost_class_count> reads_waiting_for_admission_by_cost_class = {};
 
         friend auto operator<=>(const stats&, const stats&) = default;
     };
@@ -165,19 +170,34 @@ class reader_concurrency_semaphore {
     resources _resources;
     utils::observer<int> _count_observer;
 
+    // Permits waiting for admission are queued by their cost class, and the
+    // classes are scheduled with stride scheduling: each admission advances
+    // the pass of the admitted permit's class by the class's stride and the
+    // next permit is taken from the waiting class with the lowest pass.
+    // Cheaper classes have a shorter stride, so they are admitted more often,
+    // while all waiting classes keep advancing and none of them can starve.
+    // Within a class, permits are admitted in FIFO order.
+    // Permits waiting for memory always go first.
     struct wait_queue {
-        // Stores entries for permits waiting to be admitted.
-        permit_list_type _admission_queue;
+        static constexpr std::array<uint64_t, reader_permit::cost_class_count> stride = {1, 2, 4};
+
+        // Stores entries for permits waiting to be admitted, by cost class.
+        std::array<permit_list_type, reader_permit::cost_class_count> _admission_queues;
+        // The scheduling pass of each cost class.
+        std::array<uint64_t, reader_permit::cost_class_count> _pass = {};
         // Stores entries for serialized permits waiting to obtain memory.
         permit_list_type _memory_queue;
+    private:
+        // Must not be called when all admission queues are empty.
+        permit_list_type& next_admission_queue();
     public:
-        bool empty() const {
-            return _admission_queue.empty() && _memory_queue.empty();
-        }
+        bool empty() const;
         void push_to_admission_queue(reader_permit::impl& p);
         void push_to_memory_queue(reader_permit::impl& p);
         reader_permit::impl& front();
         const reader_permit::impl& front() const;
+        // Charge the class of the permit for its admission.
+        void on_admitted(const reader_permit::impl& p);
     };
 
     wait_queue _wait_list;
@@ -422,8 +442,13 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
-    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
+    ///
+    /// The cost class is used to order the permit among the other permits
+    /// waiting for admission, see \ref wait_queue.
+    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            reader_permit::cost_class cost = reader_permit::cost_class::normal);
+    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            reader_permit::cost_class cost = reader_permit::cost_class::normal);
 
     /// Make a tracking only permit
     ///
@@ -460,7 +485,8 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func);
+    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func,
+            reader_permit::cost_class cost = reader_permit::cost_class::normal);
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
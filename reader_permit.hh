@@ -94,6 +94,16 @@ class reader_permit {
         evicted,
     };
 
+    // Coarse estimate of how expensive a read is, used to order the reads
+    // waiting for admission: cheaper reads are preferred, but expensive ones
+    // still get their share of admissions and are never starved.
+    enum class cost_class : uint8_t {
+        cheap,
+        normal,
+        expensive,
+    };
+    static constexpr size_t cost_class_count = 3;
+
     class impl;
 
 private:
@@ -144,6 +154,7 @@ class reader_permit {
     const schema_ptr& get_schema() const;
     std::string_view get_op_name() const;
     state get_state() const;
+    cost_class get_cost_class() const;
 
     bool needs_readmission() const;
 
@@ -325,6 +336,9 @@ bool operator==(const tracking_allocator<T>& a, const tracking_allocator<T>& b)
 template <> struct fmt::formatter<reader_permit::state> : fmt::formatter<string_view> {
     auto format(reader_permit::state, fmt::format_context& ctx) const -> decltype(ctx.out());
 };
+template <> struct fmt::formatter<reader_permit::cost_class> : fmt::formatter<string_view> {
+    auto format(reader_permit::cost_class, fmt::format_context& ctx) const -> decltype(ctx.out());
+};
 template <> struct fmt::formatter<reader_resources> : fmt::formatter<string_view> {
     auto format(const reader_resources&, fmt::format_context& ctx) const -> decltype(ctx.out());
 };
@@ -25,10 +25,12 @@
 #include "readers/multi_range.hh"
 #include "readers/mutation_source.hh"
 #include "readers/nonforwardable.hh"
+#include "readers/pipelined.hh"
 #include "readers/queue.hh"
 #include "readers/reversing_v2.hh"
 #include "readers/upgrading_consumer.hh"
 #include "tombstone_gc.hh"
+#include <seastar/core/condition-variable.hh>
 #include <seastar/core/coroutine.hh>
 #include <stack>
 
@@ -1181,6 +1183,99 @@ mutation_reader make_next_partition_adaptor(mutation_reader&& rd) {
     return make_mutation_reader<adaptor>(std::move(rd));
 }
 
+mutation_reader make_pipelined_reader(mutation_reader rd, size_t depth) {
+    class pipelined_reader : public mutation_reader::impl {
+        mutation_reader _underlying;
+        const size_t _depth;
+        // Buffers produced by the background fiber, not yet consumed.
+        std::deque<mutation_reader::tracked_buffer> _ready;
+        // Signalled when a buffer was produced, or the producer finished.
+        condition_variable _produced;
+        // Signalled when a buffer was consumed, or the reader is closing.
+        condition_variable _consumed;
+        std::optional<future<>> _producer;
+        std::exception_ptr _ex;
+        bool _underlying_eos = false;
+        bool _stopped = false;
+        bool _skip_to_partition_start = false;
+    private:
+        future<> produce() {
+            try {
+                while (!_underlying_eos) {
+                    co_await _consumed.wait([this] { return _stopped || _ready.size() < _depth; });
+                    if (_stopped) {
+                        break;
+                    }
+                    co_await _underlying.fill_buffer();
+                    if (!_underlying.is_buffer_empty()) {
+                        _ready.push_back(_underlying.detach_buffer());
+                    }
+                    _underlying_eos = _underlying.is_end_of_stream();
+                    _produced.signal();
+                }
+            } catch (...) {
+                _ex = std::current_exception();
+                _produced.signal();
+            }
+        }
+    public:
+        pipelined_reader(mutation_reader underlying, size_t depth)
+            : impl(underlying.schema(), underlying.permit())
+            , _underlying(std::move(underlying))
+            , _depth(std::max(depth, size_t(1)))
+        { }
+        virtual future<> fill_buffer() override {
+            if (!_producer) {
+                _producer = produce();
+            }
+            while (is_buffer_empty() && !is_end_of_stream()) {
+                co_await _produced.wait([this] { return !_ready.empty() || _underlying_eos || _ex; });
+                if (_ready.empty()) {
+                    if (_ex) {
+                        std::rethrow_exception(_ex);
+                    }
+                    _end_of_stream = true;
+                    co_return;
+                }
+                auto buffer = std::move(_ready.front());
+                _ready.pop_front();
+                _consumed.signal();
+                for (auto&& mf : buffer) {
+                    if (_skip_to_partition_start) {
+                        if (!mf.is_partition_start()) {
+                            continue;
+                        }
+                        _skip_to_partition_start = false;
+                    }
+                    push_mutation_fragment(std::move(mf));
+                }
+            }
+        }
+        virtual future<> next_partition() override {
+            clear_buffer_to_next_partition();
+            if (is_buffer_empty()) {
+                _skip_to_partition_start = true;
+            }
+            return make_ready_future<>();
+        }
+        virtual future<> fast_forward_to(const dht::partition_range&) override {
+            return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
+        }
+        virtual future<> fast_forward_to(position_range) override {
+            return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
+        }
+        virtual future<> close() noexcept override {
+            _stopped = true;
+            _consumed.signal();
+            if (_producer) {
+                co_await std::move(*_producer);
+            }
+            co_await _underlying.close();
+        }
+    };
+    return make_mutation_reader<pipelined_reader>(std::move(rd), depth);
+}
+
 snapshot_source make_empty_snapshot_source() {
     return snapshot_source([] {
         return make_empty_mutation_source();
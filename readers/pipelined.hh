@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+
+class mutation_reader;
+
+// Create a reader which fills the buffers of `rd` in a background fiber,
+// up to `depth` buffers ahead of the consumer.
+//
+// This decouples the producer stages of `rd` (disk reads, decompression,
+// merging) from the consumer, so that the consumer processing a buffer
+// overlaps with the production of the next ones instead of alternating
+// with it. Memory usage is bounded by `depth` buffers of `rd`.
+//
+// The returned reader doesn't support fast-forwarding. next_partition()
+// is supported, but it only skips fragments which were already produced,
+// it doesn't save the work of producing them.
+mutation_reader make_pipelined_reader(mutation_reader rd, size_t depth);
@@ -91,7 +91,13 @@ thread_local dirty_memory_manager default_dirty_memory_manager;
 inline
 flush_controller
 make_flush_controller(const db::config& cfg, backlog_controller::scheduling_group& sg, std::function<double()> fn) {
-    return flush_controller(sg, cfg.memtable_flush_static_shares(), 50ms, cfg.unspooled_dirty_soft_limit(), std::move(fn));
+    return flush_controller(sg, cfg.memtable_flush_static_shares(), 50ms, cfg.unspooled_dirty_soft_limit(), std::move(fn),
+            backlog_controller::feedback_config{
+                .target_backlog = cfg.memtable_flush_controller_target_backlog,
+                .kp = cfg.backlog_controller_proportional_gain,
+                .ki = cfg.backlog_controller_integral_gain,
+                .kd = cfg.backlog_controller_derivative_gain,
+            });
 }
 
 keyspace::keyspace(lw_shared_ptr<keyspace_metadata> metadata, config cfg, locator::effective_replication_map_factory& erm_factory)
@@ -474,6 +480,13 @@ void backlog_controller::adjust() {
 
     auto backlog = _current_backlog();
 
+    if (auto target = _feedback.target_backlog(); target > 0) {
+        update_controller(adjust_with_feedback(backlog, target));
+        return;
+    }
+    // Start afresh if the feedback mode is turned on again.
+    _pid.reset();
+
     if (backlog >= _control_points.back().input) {
         update_controller(_control_points.back().output);
         return;
@@ -492,6 +505,15 @@ void backlog_controller::adjust() {
     update_controller(result);
 }
 
+float backlog_controller::adjust_with_feedback(float backlog, float target) {
+    auto scale = _control_points.back().input;
+    auto min_output = _control_points.front().output;
+    auto max_output = _control_points.back().output;
+    auto gains = pid_gains{_feedback.kp(), _feedback.ki(), _feedback.kd()};
+    auto output = _pid.update(backlog / scale, target / scale, _interval.count(), gains);
+    return min_output + output * (max_output - min_output);
+}
+
 float backlog_controller::backlog_of_shares(float shares) const {
     size_t idx = 1;
     if (controller_disabled() || _control_points.size() == 0) {
@@ -512,9 +534,56 @@ float backlog_controller::backlog_of_shares(float shares) const {
 }
 
 void backlog_controller::update_controller(float shares) {
+    _shares = shares;
     _scheduling_group.set_shares(shares);
 }
 
+void backlog_controller::register_metrics(seastar::metrics::metric_groups& metrics, const sstring& group) {
+    namespace sm = seastar::metrics;
+
+    metrics.add_group(group, {
+        sm::make_gauge("controller_shares", [this] { return _shares; },
+                       sm::description("Holds the shares last set by the backlog controller.")),
+        sm::make_gauge("controller_error", [this] { return _pid.error(); },
+                       sm::description("Holds the normalized difference between the backlog and its target, when the controller is in feedback mode.")),
+        sm::make_gauge("controller_proportional", [this] { return _pid.proportional(); },
+                       sm::description("Holds the proportional term of the controller output, when the controller is in feedback mode.")),
+        sm::make_gauge("controller_integral", [this] { return _pid.integral(); },
+                       sm::description("Holds the integral term of the controller output, when the controller is in feedback mode.")),
+        sm::make_gauge("controller_derivative", [this] { return _pid.derivative(); },
+                       sm::description("Holds the derivative term of the controller output, when the controller is in feedback mode.")),
+    });
+}
+
+float pid_controller::update(float measurement, float target, float dt, const pid_gains& gains) noexcept {
+    // The derivative term only damps fast changes, it is smoothed so that a single burst doesn't
+    // make the output jump.
+    static constexpr float derivative_smoothing = 0.2;
+
+    _error = measurement - target;
+    _proportional = gains.kp * _error;
+    // The derivative is taken on the measurement rather than on the error, so changing the
+    // target doesn't make the output jump either.
+    if (_last_measurement && dt > 0) {
+        auto derivative = gains.kd * (measurement - *_last_measurement) / dt;
+        _derivative += derivative_smoothing * (derivative - _derivative);
+    }
+    _last_measurement = measurement;
+
+    auto integral = std::clamp(_integral + gains.ki * _error * dt, 0.0f, 1.0f);
+    auto output = _proportional + integral + _derivative;
+    bool saturated = (output > 1 && _error > 0) || (output < 0 && _error < 0);
+    if (!saturated) {
+        _integral = integral;
+    }
+    _output = std::clamp(_proportional + _integral + _derivative, 0.0f, 1.0f);
+    return _output;
+}
+
+void pid_controller::reset() noexcept {
+    *this = pid_controller();
+}
+
 
 namespace replica {
 
@@ -555,6 +624,7 @@ database::setup_metrics() {
                        sm::description("Holds the number of failed memtable flushes. "
                                        "High value in this metric may indicate a permanent failure to flush a memtable.")),
     });
+    _memtable_controller.register_metrics(_metrics, "memtables");
 
     _metrics.add_group("database", {
         sm::make_gauge("requests_blocked_memory_current", [this] { return _dirty_memory_manager.region_group().blocked_requests(); },
@@ -625,6 +695,12 @@ database::setup_metrics() {
                        sm::description("Counts querier cache entries that were evicted to free up resources "
                                        "(limited by reader concurrency limits) necessary to create new readers.")),
 
+        sm::make_counter("querier_cache_prefetches", _querier_cache.get_stats().prefetches,
+                       sm::description("Counts querier cache inserts of queriers which read ahead their next page first.")),
+
+        sm::make_counter("querier_cache_prefetch_hits", _querier_cache.get_stats().prefetch_hits,
+                       sm::description("Counts querier cache lookups which found a querier that read ahead its next page.")),
+
         sm::make_gauge("querier_cache_population", _querier_cache.get_stats().population,
                        sm::description("The number of entries currently in the querier cache.")),
 
@@ -1520,6 +1596,7 @@ database::query(schema_ptr query_schema, const query::read_command& cmd, query::
     std::exception_ptr ex;
 
     if (cmd.query_uuid && !cmd.is_first_page) {
+        co_await _querier_cache.wait_for_prefetch(cmd.query_uuid);
         querier_opt = _querier_cache.lookup_data_querier(cmd.query_uuid, *query_schema, ranges.front(), cmd.slice, semaphore, trace_state, timeout);
     }
 
@@ -1540,12 +1617,17 @@ database::query(schema_ptr query_schema, const query::read_command& cmd, query::
             querier_opt->permit().set_trace_state(trace_state);
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func));
+            f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func,
+                    cf.estimate_read_cost_class(ranges)));
         }
 
         if (!f.failed()) {
             if (cmd.query_uuid && querier_opt) {
-                _querier_cache.insert_data_querier(cmd.query_uuid, std::move(*querier_opt), std::move(trace_state));
+                if (_cfg.enable_adaptive_paging()) {
+                    _querier_cache.insert_data_querier_with_prefetch(cmd.query_uuid, std::move(*querier_opt), std::move(trace_state), cf.read_in_progress());
+                } else {
+                    _querier_cache.insert_data_querier(cmd.query_uuid, std::move(*querier_opt), std::move(trace_state));
+                }
             }
         } else {
             ex = f.get_exception();
@@ -1602,7 +1684,8 @@ database::query_mutations(schema_ptr query_schema, const query::read_command& cm
             querier_opt->permit().set_trace_state(trace_state);
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "mutation-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func));
+            f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "mutation-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func,
+                    cf.estimate_read_cost_class({range})));
         }
 
         if (!f.failed()) {
@@ -1653,12 +1736,14 @@ reader_concurrency_semaphore& database::get_reader_concurrency_semaphore() {
     std::abort();
 }
 
-future<reader_permit> database::obtain_reader_permit(table& tbl, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
-    return get_reader_concurrency_semaphore().obtain_permit(tbl.schema(), op_name, tbl.estimate_read_memory_cost(), timeout, std::move(trace_ptr));
+future<reader_permit> database::obtain_reader_permit(table& tbl, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+        reader_permit::cost_class cost) {
+    return get_reader_concurrency_semaphore().obtain_permit(tbl.schema(), op_name, tbl.estimate_read_memory_cost(), timeout, std::move(trace_ptr), cost);
 }
 
-future<reader_permit> database::obtain_reader_permit(schema_ptr schema, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
-    return obtain_reader_permit(find_column_family(std::move(schema)), op_name, timeout, std::move(trace_ptr));
+future<reader_permit> database::obtain_reader_permit(schema_ptr schema, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+        reader_permit::cost_class cost) {
+    return obtain_reader_permit(find_column_family(std::move(schema)), op_name, timeout, std::move(trace_ptr), cost);
 }
 
 bool database::is_user_semaphore(const reader_concurrency_semaphore& semaphore) const {
@@ -367,6 +367,14 @@ struct table_stats {
     utils::estimated_histogram estimated_sstable_per_read{35};
     utils::timed_rate_moving_average_and_histogram tombstone_scanned;
     utils::timed_rate_moving_average_and_histogram live_scanned;
+    // Rate of the dead rows and range tombstones scanned, tombstone_scanned only
+    // keeps the rate of the queries which scanned them.
+    utils::timed_rate_moving_average tombstones_scanned_rate;
+    // Rates of the single-partition reads from sstables and of the sstables
+    // they read, estimated_sstable_per_read keeps the distribution since
+    // startup.
+    utils::timed_rate_moving_average sstable_reads_rate;
+    utils::timed_rate_moving_average sstables_read_rate;
     utils::estimated_histogram estimated_coordinator_read;
 };
 
@@ -936,6 +944,18 @@ class table : public enable_lw_shared_from_this<table>
             query::result_memory_accounter accounter,
             db::timeout_clock::time_point timeout,
             std::optional<query::querier>* saved_querier = { });
+private:
+    // Records the rows scanned by a query in live_scanned and tombstone_scanned.
+    void update_scanned_stats(uint64_t live_rows, uint64_t dead_rows);
+    // Narrows the slice of a single-partition data query filtering on a column
+    // of the sstable_value_index option to the rows which may match, see
+    // sstables::value_index. Returns std::nullopt if it can't be narrowed.
+    future<std::optional<query::partition_slice>> narrow_slice_with_value_index(schema_ptr query_schema,
+            reader_permit permit,
+            const query::read_command& cmd,
+            const dht::partition_range_vector& ranges,
+            tracing::trace_state_ptr trace_state);
+public:
 
     void start();
     future<> stop();
@@ -1025,7 +1045,8 @@ class table : public enable_lw_shared_from_this<table>
     future<bool> perform_offstrategy_compaction(tasks::task_info info);
     future<> perform_cleanup_compaction(owned_ranges_ptr sorted_owned_ranges,
                                         tasks::task_info info,
-                                        do_flush = do_flush::yes);
+                                        do_flush = do_flush::yes,
+                                        compaction::maintenance_batch_ptr batch = {});
     unsigned estimate_pending_compactions() const;
 
     void set_compaction_strategy(sstables::compaction_strategy_type strategy);
@@ -1049,6 +1070,14 @@ class table : public enable_lw_shared_from_this<table>
         return _stats;
     }
 
+    // Average number of dead rows and range tombstones scanned by the queries
+    // of the last minute or so, see utils::moving_average.
+    double tombstones_scanned_per_read() const noexcept;
+
+    // Average number of sstables read by the single-partition reads of the
+    // last minute or so, see utils::moving_average.
+    double sstables_per_read() const noexcept;
+
     // The tablet filter is used to not double account migrating tablets, so it's important that
     // only one of pending or leaving replica is accounted based on current migration stage.
     locator::table_load_stats table_load_stats(std::function<bool(const locator::tablet_map&, locator::global_tablet_id)> tablet_filter) const noexcept;
@@ -1188,6 +1217,12 @@ class table : public enable_lw_shared_from_this<table>
 
     size_t estimate_read_memory_cost() const;
 
+    // Estimates the cost class of a read of the given ranges, used to
+    // prioritize the read among the reads waiting for admission.
+    // Single-partition reads served from the cache or touching at most one
+    // sstable are cheap, range scans are expensive.
+    reader_permit::cost_class estimate_read_cost_class(const dht::partition_range_vector& ranges) const;
+
 private:
     future<row_locker::lock_holder> do_push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
             tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts) const;
@@ -1909,8 +1944,10 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     reader_concurrency_semaphore& get_reader_concurrency_semaphore();
 
     // Convenience method to obtain an admitted permit. See reader_concurrency_semaphore::obtain_permit().
-    future<reader_permit> obtain_reader_permit(table& tbl, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
-    future<reader_permit> obtain_reader_permit(schema_ptr schema, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
+    future<reader_permit> obtain_reader_permit(table& tbl, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            reader_permit::cost_class cost = reader_permit::cost_class::normal);
+    future<reader_permit> obtain_reader_permit(schema_ptr schema, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            reader_permit::cost_class cost = reader_permit::cost_class::normal);
 
     bool is_internal_query() const;
     bool is_user_semaphore(const reader_concurrency_semaphore& semaphore) const;
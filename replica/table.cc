@@ -38,6 +38,7 @@
 #include "sstables/sstable_directory.hh"
 #include "db/system_keyspace.hh"
 #include "db/extensions.hh"
+#include "db/sstable_value_index_extension.hh"
 #include "query-result-writer.hh"
 #include "db/view/view_update_generator.hh"
 #include "utils/error_injection.hh"
@@ -62,6 +63,7 @@
 #include "readers/multi_range.hh"
 #include "readers/combined.hh"
 #include "readers/compacting.hh"
+#include "partition_slice_builder.hh"
 #include "replica/schema_describe_helper.hh"
 
 namespace replica {
@@ -1717,6 +1719,8 @@ void table::set_metrics() {
                 ms::make_counter("memtable_rows_compacted_with_tombstones", _stats.memtable_app_stats.rows_compacted_with_tombstones, ms::description("Number of rows scanned during write of a tombstone for the purpose of compaction in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_tombstone_reads", _stats.memtable_row_tombstone_reads, ms::description("Number of row tombstones read from memtables"))(cf)(ks),
+                ms::make_counter("tombstones_scanned", [this] { return _stats.tombstone_scanned.hist.sum; }, ms::description("Number of dead rows and range tombstones scanned by queries"))(cf)(ks).set_skip_when_empty(),
+                ms::make_gauge("tombstones_scanned_per_read", ms::description("Average number of dead rows and range tombstones scanned by the queries of the last minute"), [this] { return tombstones_scanned_per_read(); })(cf)(ks),
                 ms::make_gauge("pending_tasks", ms::description("Estimated number of tasks pending for this column family"), _stats.pending_flushes)(cf)(ks),
                 ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks),
                 ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks),
@@ -2099,7 +2103,8 @@ future<bool> table::perform_offstrategy_compaction(tasks::task_info info) {
 
 future<> table::perform_cleanup_compaction(compaction::owned_ranges_ptr sorted_owned_ranges,
                                            tasks::task_info info,
-                                           do_flush do_flush) {
+                                           do_flush do_flush,
+                                           compaction::maintenance_batch_ptr batch) {
     auto* cg = try_get_compaction_group_with_static_sharding();
     if (!cg) {
         co_return;
@@ -2109,7 +2114,7 @@ future<> table::perform_cleanup_compaction(compaction::owned_ranges_ptr sorted_o
         co_await flush();
     }
 
-    co_return co_await get_compaction_manager().perform_cleanup(std::move(sorted_owned_ranges), cg->as_table_state(), info);
+    co_return co_await get_compaction_manager().perform_cleanup(std::move(sorted_owned_ranges), cg->as_table_state(), info, std::move(batch));
 }
 
 unsigned table::estimate_pending_compactions() const {
@@ -2376,6 +2381,15 @@ class compaction_group::table_state : public compaction::table_state {
     dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override {
         return _t.get_token_range_after_split(t);
     }
+    double sstables_per_read() const noexcept override {
+        return _t.sstables_per_read();
+    }
+    double read_rate() const noexcept override {
+        return _t.get_stats().reads().rate().rates[0];
+    }
+    double tombstones_per_read() const noexcept override {
+        return _t.tombstones_scanned_per_read();
+    }
 };
 
 compaction_group::compaction_group(table& t, size_t group_id, dht::token_range token_range)
@@ -3342,6 +3356,17 @@ size_t table::estimate_read_memory_cost() const {
     return new_reader_base_cost;
 }
 
+reader_permit::cost_class table::estimate_read_cost_class(const dht::partition_range_vector& ranges) const {
+    if (ranges.size() != 1 || !ranges.front().is_singular() || !ranges.front().start()->value().has_key()) {
+        return reader_permit::cost_class::expensive;
+    }
+    const auto& range = ranges.front();
+    if (cache_enabled() && _cache.contains(range.start()->value().as_decorated_key())) {
+        return reader_permit::cost_class::cheap;
+    }
+    return _sstables->select(range).size() <= 1 ? reader_permit::cost_class::cheap : reader_permit::cost_class::normal;
+}
+
 void table::set_hit_rate(locator::host_id addr, cache_temperature rate) {
     auto& e = _cluster_cache_hit_rates[addr];
     e.rate = rate;
@@ -3478,6 +3503,161 @@ write_memtable_to_sstable(memtable& mt, sstables::shared_sstable sst) {
     }
 }
 
+void table::update_scanned_stats(uint64_t live_rows, uint64_t dead_rows) {
+    // The histograms count rows, not time.
+    _stats.live_scanned.mark(std::chrono::microseconds(live_rows));
+    _stats.tombstone_scanned.mark(std::chrono::microseconds(dead_rows));
+    _stats.tombstones_scanned_rate.mark(dead_rows);
+}
+
+double table::tombstones_scanned_per_read() const noexcept {
+    auto read_rate = _stats.tombstone_scanned.met.rate().rates[0];
+    return read_rate > 0 ? _stats.tombstones_scanned_rate.rate().rates[0] / read_rate : 0;
+}
+
+double table::sstables_per_read() const noexcept {
+    auto read_rate = _stats.sstable_reads_rate.rate().rates[0];
+    return read_rate > 0 ? _stats.sstables_read_rate.rate().rates[0] / read_rate : 0;
+}
+
+// The rows whose merged cell matches the value have a matching live cell in
+// at least one memtable or sstable, so the union of the rows found in each of
+// them is a superset of the rows which pass the row filter, which still drops
+// the others. Memtables are scanned, sstables consult their ValueIndex
+// component, and the read isn't narrowed if any sstable lacks it.
+future<std::optional<query::partition_slice>>
+table::narrow_slice_with_value_index(schema_ptr s,
+        reader_permit permit,
+        const query::read_command& cmd,
+        const dht::partition_range_vector& ranges,
+        tracing::trace_state_ptr trace_state) {
+    // Reading many singular ranges is no cheaper than reading the partition.
+    static constexpr size_t max_narrowed_rows = 10000;
+
+    if (_virtual_reader || !cmd.row_filter || ranges.size() != 1 || !ranges.front().is_singular()
+            || !ranges.front().start()->value().has_key() || cmd.slice.is_reversed()) {
+        co_return std::nullopt;
+    }
+    const auto indexed_columns = db::sstable_value_index_extension::indexed_columns(*_schema);
+    if (indexed_columns.empty()) {
+        co_return std::nullopt;
+    }
+    const column_definition* column = nullptr;
+    const bytes* value = nullptr;
+    for (const auto& r : cmd.row_filter->restrictions) {
+        if (r.cmp != query::column_restriction::comparison::eq || r.column >= s->regular_columns_count()) {
+            continue;
+        }
+        const auto& def = s->regular_column_at(r.column);
+        if (std::ranges::any_of(indexed_columns, [&] (const column_definition* c) { return c->name() == def.name(); })) {
+            column = &def;
+            value = &r.value;
+            break;
+        }
+    }
+    if (!column) {
+        co_return std::nullopt;
+    }
+
+    const auto& range = ranges.front();
+    const auto dk = range.start()->value().as_decorated_key();
+    const auto slice = partition_slice_builder(*s).with_no_static_columns().with_regular_column(column->name()).build();
+    // Snapshot the partition in the memtables and take the sstables without
+    // deferring, so that data of a memtable flushed in the meantime is seen in
+    // the snapshot: the flush moves it to the cache and the new sstable, which
+    // are not consulted.
+    std::vector<mutation_reader> memtable_readers;
+    storage_group_for_token(dk.token()).for_each_compaction_group([&] (const compaction_group_ptr& cg) {
+        for (auto& mt : *cg->memtables()) {
+            if (auto reader_opt = mt->make_flat_reader_opt(s, permit, range, slice, trace_state)) {
+                memtable_readers.push_back(std::move(*reader_opt));
+            }
+        }
+    });
+    const auto sstables = _sstables->select(range);
+
+    // Only the rows in the ranges of the query are kept, and narrowing is
+    // given up as soon as there are too many of them.
+    const auto& row_ranges = cmd.slice.row_ranges(*s, dk.key());
+    const auto cmp = clustering_key_prefix::prefix_equal_tri_compare(*s);
+    std::set<clustering_key_prefix, clustering_key_prefix::less_compare> rows{clustering_key_prefix::less_compare(*s)};
+    auto add_row = [&] (clustering_key_prefix ck) {
+        if (std::ranges::any_of(row_ranges, [&] (const query::clustering_range& r) { return r.contains(ck, cmp); })) {
+            rows.insert(std::move(ck));
+        }
+        return rows.size() <= max_narrowed_rows;
+    };
+    bool indexed = true;
+    bool too_many_rows = false;
+    std::exception_ptr ex;
+    try {
+        co_await utils::get_local_injector().inject("narrow_slice_with_value_index_flush", [this] (auto& handler) {
+            return flush();
+        });
+        for (const auto& sst : sstables) {
+            auto sst_rows = co_await sst->find_value_index_rows(dk, *column, managed_bytes_view(bytes_view(*value)));
+            if (!sst_rows) {
+                indexed = false;
+                break;
+            }
+            for (auto& ck : *sst_rows) {
+                if (!add_row(std::move(ck))) {
+                    too_many_rows = true;
+                    break;
+                }
+            }
+            if (too_many_rows) {
+                break;
+            }
+        }
+        // The memtable readers are consumed fragment by fragment, so that
+        // only their buffers, accounted to the permit, are kept in memory.
+        for (auto& reader : memtable_readers) {
+            while (indexed && !too_many_rows) {
+                auto mf = co_await reader();
+                if (!mf) {
+                    break;
+                }
+                if (!mf->is_clustering_row()) {
+                    continue;
+                }
+                const auto& cr = mf->as_clustering_row();
+                const auto* cell = cr.cells().find_cell(column->id);
+                if (!cell) {
+                    continue;
+                }
+                auto ac = cell->as_atomic_cell(*column);
+                if (ac.is_live() && column->type->equal(ac.value(), bytes_view(*value))) {
+                    too_many_rows = !add_row(cr.key());
+                }
+            }
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    for (auto& reader : memtable_readers) {
+        co_await reader.close();
+    }
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    if (!indexed || too_many_rows) {
+        co_return std::nullopt;
+    }
+
+    query::clustering_row_ranges narrowed_ranges;
+    narrowed_ranges.reserve(rows.size());
+    while (!rows.empty()) {
+        narrowed_ranges.push_back(query::clustering_range::make_singular(std::move(rows.extract(rows.begin()).value())));
+    }
+    tracing::trace(trace_state, "Narrowed the read to {} rows using the sstable value index of column {}",
+            narrowed_ranges.size(), column->name_as_text());
+
+    auto narrowed = cmd.slice;
+    narrowed.set_range(*s, dk.key(), std::move(narrowed_ranges));
+    co_return narrowed;
+}
+
 future<lw_shared_ptr<query::result>>
 table::query(schema_ptr query_schema,
         reader_permit permit,
@@ -3511,19 +3691,33 @@ table::query(schema_ptr query_schema,
     if (saved_querier) {
         querier_opt = std::move(*saved_querier);
     }
+    // A narrowed slice misses the rows written after it was computed, so
+    // the querier reading it is not saved for the next page.
+    std::optional<query::partition_slice> narrowed_slice;
+    if (!querier_opt) {
+        narrowed_slice = co_await narrow_slice_with_value_index(query_schema, permit, cmd, partition_ranges, trace_state);
+        if (narrowed_slice) {
+            saved_querier = nullptr;
+        }
+    }
+    uint64_t live_rows_scanned = 0;
+    uint64_t dead_rows_scanned = 0;
 
     while (!qs.done()) {
         auto&& range = *qs.current_partition_range++;
 
         if (!querier_opt) {
             query::querier_base::querier_config conf(_config.tombstone_warn_threshold);
-            querier_opt = query::querier(as_mutation_source(), query_schema, permit, range, qs.cmd.slice, trace_state, conf);
+            querier_opt = query::querier(as_mutation_source(), query_schema, permit, range, narrowed_slice ? *narrowed_slice : qs.cmd.slice, trace_state, conf);
+            querier_opt->set_row_filter(qs.cmd.row_filter);
         }
         auto& q = *querier_opt;
 
         std::exception_ptr ex;
       try {
         co_await q.consume_page(query_result_builder(*query_schema, qs.builder), qs.remaining_rows(), qs.remaining_partitions(), qs.cmd.timestamp, trace_state);
+        live_rows_scanned += q.page_stats().live_rows();
+        dead_rows_scanned += q.page_stats().dead_rows();
       } catch (...) {
         ex = std::current_exception();
       }
@@ -3536,6 +3730,8 @@ table::query(schema_ptr query_schema,
         }
     }
 
+    update_scanned_stats(live_rows_scanned, dead_rows_scanned);
+
     std::optional<full_position> last_pos;
     if (querier_opt && querier_opt->current_position()) {
         last_pos.emplace(*querier_opt->current_position());
@@ -3581,6 +3777,7 @@ table::mutation_query(schema_ptr query_schema,
   try {
     auto rrb = reconcilable_result_builder(*query_schema, cmd.slice, std::move(accounter));
     auto r = co_await q.consume_page(std::move(rrb), cmd.get_row_limit(), cmd.partition_limit, cmd.timestamp, trace_state);
+    update_scanned_stats(q.page_stats().live_rows(), q.page_stats().dead_rows());
 
     if (!saved_querier || (!q.are_limits_reached() && !r.is_short_read())) {
         co_await q.close();
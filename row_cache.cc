@@ -1177,6 +1177,13 @@ void row_cache::touch(const dht::decorated_key& dk) {
  });
 }
 
+bool row_cache::contains(const dht::decorated_key& dk) {
+    return _read_section(_tracker.region(), [&] {
+        auto i = _partitions.find(dk, dht::ring_position_comparator(*_schema));
+        return i != _partitions.end() && !i->is_dummy_entry();
+    });
+}
+
 void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
     _read_section(_tracker.region(), [&] {
         auto i = _partitions.find(dk, dht::ring_position_comparator(*_schema));
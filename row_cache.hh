@@ -438,6 +438,11 @@ class row_cache final {
     // Moves given partition to the front of LRU if present in cache.
     void touch(const dht::decorated_key&);
 
+    // Returns true if given partition has an entry in cache.
+    // The entry may hold only some of the partition's rows, so this is only
+    // a hint that a read of the partition is likely to be served from memory.
+    bool contains(const dht::decorated_key&);
+
     // Detaches current contents of given partition from LRU, so
     // that they are not evicted by memory reclaimer.
     void unlink_from_lru(const dht::decorated_key&);
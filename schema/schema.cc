@@ -964,6 +964,11 @@ static void describe_index_columns(std::ostream& os, bool is_local, const schema
     }
 
     os << ")";
+
+    auto included_columns = secondary_index::target_parser::get_included_columns(index_metadata);
+    if (!included_columns.empty()) {
+        os << " INCLUDE (" << fmt::to_string(fmt::join(included_columns | std::views::transform(cql3::util::maybe_quote), ", ")) << ")";
+    }
 }
 
 sstring schema::get_create_statement(const schema_describe_helper& helper, bool with_internals) const {
@@ -19,6 +19,7 @@
 #include "utils/small_vector.hh"
 #include <absl/container/btree_set.h>
 #include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sharded.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/core/on_internal_error.hh>
 #include "utils/log.hh"
@@ -653,6 +654,27 @@ struct serializer<seastar::lw_shared_ptr<T>> {
     }
 };
 
+// Serializes the pointee, which may live on another shard, in place.
+// Warning: assumes that pointer is never null
+template<typename T>
+struct serializer<seastar::foreign_ptr<T>> {
+    template<typename Input>
+    static seastar::foreign_ptr<T> read(Input& in) {
+        return seastar::make_foreign(deserialize(in, std::type_identity<T>()));
+    }
+    template<typename Output>
+    static void write(Output& out, const seastar::foreign_ptr<T>& v) {
+        if (!v) {
+            on_internal_error(serlog, "Unexpected nullptr while serializing a pointer");
+        }
+        serialize(out, *v);
+    }
+    template<typename Input>
+    static void skip(Input& in) {
+        serializer<T>::skip(in);
+    }
+};
+
 template<>
 struct serializer<sstring> {
     template<typename Input>
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include "mutation/frozen_mutation.hh"
+#include "db/per_partition_rate_limit_info.hh"
+#include "service/topology_state_machine.hh"
+
+namespace service {
+
+// A single replica write carried by the MUTATION_BATCH verb.
+//
+// The coordinator coalesces writes which are headed for the same replica
+// within a short window into one RPC. Each write keeps the response_id of
+// its write response handler, so that the replica's per-mutation result
+// can be acknowledged to the right handler.
+//
+// The mutation is shared with the write response handler (and with the
+// batches headed for the other replicas), so batching doesn't copy it.
+struct batched_mutation {
+    lw_shared_ptr<const frozen_mutation> fm;
+    uint64_t response_id;
+    db::per_partition_rate_limit::info rate_limit_info;
+    fencing_token fence;
+};
+
+} // namespace service
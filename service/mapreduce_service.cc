@@ -45,6 +45,7 @@
 #include "cql3/selection/selection.hh"
 #include "cql3/functions/functions.hh"
 #include "cql3/functions/aggregate_fcts.hh"
+#include "cql3/functions/first_function.hh"
 #include "cql3/expr/expr-utils.hh"
 
 namespace service {
@@ -53,11 +54,19 @@ static constexpr int DEFAULT_INTERNAL_PAGING_SIZE = 10000;
 static logging::logger flogger("forward_service"); // not "mapreduce", for compatibility with dtest
 
 static std::vector<::shared_ptr<db::functions::aggregate_function>> get_functions(const query::mapreduce_request& request);
+static std::vector<const column_definition*> get_grouping_columns(const schema& schema, const query::mapreduce_request& request);
 
 class mapreduce_aggregates {
 private:
     std::vector<::shared_ptr<db::functions::aggregate_function>> _funcs;
     std::vector<db::functions::stateless_aggregate_function> _aggrs;
+    // Engaged for a grouped request.
+    schema_ptr _schema;
+    std::vector<const column_definition*> _grouping_columns;
+    uint64_t _max_groups = 0;
+
+    void reduce(std::vector<bytes_opt>& states, std::vector<bytes_opt>&& other, size_t offset);
+    void sort_and_reduce_groups(std::vector<std::vector<bytes_opt>>& groups);
 public:
     mapreduce_aggregates(const query::mapreduce_request& request);
     void merge(query::mapreduce_result& result, query::mapreduce_result&& other);
@@ -87,9 +96,90 @@ mapreduce_aggregates::mapreduce_aggregates(const query::mapreduce_request& reque
         aggrs.push_back(func->get_aggregate());
     }
     _aggrs = std::move(aggrs);
+
+    if (request.grouping) {
+        _schema = local_schema_registry().get(request.cmd.schema_version);
+        _grouping_columns = get_grouping_columns(*_schema, request);
+        _max_groups = request.grouping->max_groups;
+    }
+}
+
+// Reduces `other` into `states`, both holding the states of all aggregates
+// starting at `offset`.
+void mapreduce_aggregates::reduce(std::vector<bytes_opt>& states, std::vector<bytes_opt>&& other, size_t offset) {
+    if (states.size() != other.size() || states.size() != offset + _aggrs.size()) {
+        on_internal_error(
+            flogger,
+            format("mapreduce_aggregates::reduce(): operation cannot be completed due to invalid argument sizes. "
+                    "this.aggrs.size(): {} "
+                    "offset: {} "
+                    "states.size(): {} "
+                    "other.size(): {} ",
+                    _aggrs.size(), offset, states.size(), other.size())
+        );
+    }
+
+    for (size_t i = 0; i < _aggrs.size(); i++) {
+        states[offset + i] = _aggrs[i].state_reduction_function->execute(std::vector({std::move(states[offset + i]), std::move(other[offset + i])}));
+    }
+}
+
+// Sorts groups into the order in which a regular query would return them,
+// i.e. by partition and then by clustering order, reducing the groups with
+// equal keys. The groups of a partition are all computed by the same shard,
+// so equal keys can only come from the same group being sent twice.
+void mapreduce_aggregates::sort_and_reduce_groups(std::vector<std::vector<bytes_opt>>& groups) {
+    struct keyed_group {
+        dht::decorated_key dk;
+        clustering_key_prefix ck;
+        std::vector<bytes_opt> values;
+    };
+    std::vector<keyed_group> keyed;
+    keyed.reserve(groups.size());
+    for (auto& group : groups) {
+        std::vector<bytes> pk_values;
+        std::vector<bytes> ck_values;
+        for (size_t i = 0; i < _grouping_columns.size(); i++) {
+            if (!group[i]) {
+                // A partition with no rows has no clustering values.
+                break;
+            }
+            (_grouping_columns[i]->is_partition_key() ? pk_values : ck_values).push_back(*group[i]);
+        }
+        auto dk = dht::decorate_key(*_schema, partition_key::from_exploded(*_schema, pk_values));
+        keyed.push_back(keyed_group{std::move(dk), clustering_key_prefix(std::move(ck_values)), std::move(group)});
+    }
+
+    auto ck_cmp = clustering_key_prefix::tri_compare(*_schema);
+    auto cmp = [&] (const keyed_group& a, const keyed_group& b) {
+        auto r = a.dk.tri_compare(*_schema, b.dk);
+        return r != 0 ? r : ck_cmp(a.ck, b.ck);
+    };
+    std::ranges::sort(keyed, [&] (const keyed_group& a, const keyed_group& b) {
+        return cmp(a, b) < 0;
+    });
+
+    groups.clear();
+    for (size_t i = 0; i < keyed.size(); i++) {
+        if (i > 0 && cmp(keyed[i - 1], keyed[i]) == 0) {
+            reduce(groups.back(), std::move(keyed[i].values), _grouping_columns.size());
+        } else {
+            groups.push_back(std::move(keyed[i].values));
+        }
+    }
 }
 
 void mapreduce_aggregates::merge(query::mapreduce_result &result, query::mapreduce_result&& other) {
+    if (!_grouping_columns.empty()) {
+        result.groups_overflow |= other.groups_overflow;
+        if (result.groups_overflow) {
+            result.grouped_query_results.clear();
+            return;
+        }
+        std::ranges::move(other.grouped_query_results, std::back_inserter(result.grouped_query_results));
+        return;
+    }
+
     if (result.query_results.empty()) {
         result.query_results = std::move(other.query_results);
         return;
@@ -114,6 +204,28 @@ void mapreduce_aggregates::merge(query::mapreduce_result &result, query::mapredu
 }
 
 void mapreduce_aggregates::finalize(query::mapreduce_result &result) {
+    if (!_grouping_columns.empty()) {
+        if (result.groups_overflow) {
+            return;
+        }
+        auto& groups = result.grouped_query_results;
+        sort_and_reduce_groups(groups);
+        if (groups.size() > _max_groups) {
+            result.groups_overflow = true;
+            groups.clear();
+            return;
+        }
+        const auto offset = _grouping_columns.size();
+        for (auto& group : groups) {
+            for (size_t i = 0; i < _aggrs.size(); i++) {
+                if (_aggrs[i].state_to_result_function) {
+                    group[offset + i] = _aggrs[i].state_to_result_function->execute(std::vector({std::move(group[offset + i])}));
+                }
+            }
+        }
+        return;
+    }
+
     if (result.query_results.empty()) {
         // An empty result means that we didn't send the aggregation request
         // to any node. I.e., it was a query that matched no partition, such
@@ -191,6 +303,21 @@ static std::vector<::shared_ptr<db::functions::aggregate_function>> get_function
     return aggrs;
 }
 
+static std::vector<const column_definition*> get_grouping_columns(const schema& schema, const query::mapreduce_request& request) {
+    std::vector<const column_definition*> columns;
+    if (!request.grouping) {
+        return columns;
+    }
+    for (auto& name : request.grouping->column_names) {
+        auto def = schema.get_column_definition(to_bytes(name));
+        if (!def || !def->is_primary_key()) {
+            throw std::runtime_error(format("Cannot group by column {}", name));
+        }
+        columns.push_back(def);
+    }
+    return columns;
+}
+
 static const dht::token& end_token(const dht::partition_range& r) {
     static const dht::token max_token = dht::maximum_token();
     return r.end() ? r.end()->value().token() : max_token;
@@ -352,6 +479,18 @@ static shared_ptr<cql3::selection::selection> mock_selection(
         return cql3::selection::prepared_selector{std::move(prepared_expr), column_identifier};
     };
 
+    // For a grouped request, the grouping columns come first, so that each
+    // output row starts with its group's key.
+    for (auto def : get_grouping_columns(*schema, request)) {
+        auto first_expr = cql3::expr::function_call{
+            .func = cql3::functions::aggregate_fcts::make_first_function(def->type),
+            .args = {cql3::expr::column_value(def)},
+        };
+        auto column_identifier = make_shared<cql3::column_identifier>(def->name_as_text(), true);
+        auto prepared_expr = cql3::expr::prepare_expression(first_expr, db.as_data_dictionary(), "", schema.get(), nullptr);
+        prepared_selectors.emplace_back(cql3::selection::prepared_selector{std::move(prepared_expr), column_identifier});
+    }
+
     for (size_t i = 0; i < request.reduction_types.size(); i++) {
         auto info = (request.aggregation_infos) ? std::optional(request.aggregation_infos->at(i)) : std::nullopt;
         prepared_selectors.emplace_back(mock_singular_selection(functions[i], request.reduction_types[i], info));
@@ -440,11 +579,18 @@ future<query::mapreduce_result> mapreduce_service::execute_on_this_shard(
         cql3::query_options::specific_options::DEFAULT
     );
 
+    std::vector<size_t> group_by_cell_indices;
+    for (auto def : get_grouping_columns(*schema, req)) {
+        group_by_cell_indices.push_back(selection->index_of(*def));
+    }
+    const uint64_t max_groups = req.grouping ? req.grouping->max_groups : 0;
+    bool groups_overflow = false;
+
     auto rs_builder = cql3::selection::result_set_builder(
         *selection,
         now,
         nullptr,
-        std::vector<size_t>() // Represents empty GROUP BY indices.
+        std::move(group_by_cell_indices)
     );
 
     // We serve up to 256 ranges at a time to avoid allocating a huge vector for ranges
@@ -490,14 +636,42 @@ future<query::mapreduce_result> mapreduce_service::execute_on_this_shard(
             }
 
             co_await pager->fetch_page(rs_builder, DEFAULT_INTERNAL_PAGING_SIZE, now, timeout);
+
+            // Don't bother computing the remaining groups of a grouped request
+            // which already has too many of them, the coordinator falls back
+            // to a regular query.
+            if (req.grouping && rs_builder.result_set_size() > max_groups) {
+                groups_overflow = true;
+                break;
+            }
         }
 
         ranges_owned_by_this_shard.clear();
-    } while (current_range);
+    } while (current_range && !groups_overflow);
+
+    if (groups_overflow) {
+        tracing::trace(tr_state, "Grouped request has more than {} groups on this shard", max_groups);
+        flogger.debug("grouped request has more than {} groups on this shard", max_groups);
+        co_return query::mapreduce_result{ .groups_overflow = true };
+    }
 
     co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, reductions = req.reduction_types, tr_state = std::move(tr_state)] {
         auto rs = rs_builder.build();
         auto& rows = rs->rows();
+        if (req.grouping) {
+            query::mapreduce_result res;
+            const auto row_size = req.grouping->column_names.size() + reductions.size();
+            for (auto& row : rows) {
+                if (row.size() != row_size) {
+                    flogger.error("grouped aggregation result column count does not match requested column count");
+                    throw std::runtime_error("grouped aggregation result column count does not match requested column count");
+                }
+                res.grouped_query_results.push_back(row | std::views::transform([] (const managed_bytes_opt& x) { return to_bytes_opt(x); }) | std::ranges::to<std::vector<bytes_opt>>());
+            }
+            tracing::trace(tr_state, "On shard execution result is {} groups", res.grouped_query_results.size());
+            flogger.debug("on shard execution result is {} groups", res.grouped_query_results.size());
+            return res;
+        }
         if (rows.size() != 1) {
             flogger.error("aggregation result row count != 1");
             throw std::runtime_error("aggregation result row count != 1");
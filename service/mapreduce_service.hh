@@ -118,6 +118,15 @@ class storage_proxy;
 //           timeout(ms)=4865767688
 //       } for 127.0.0.3
 //
+// A request with `grouping` set computes the aggregates for each group of
+// rows sharing a prefix of the primary key. Since the prefix includes the
+// whole partition key, a group is never split between shards, so shards
+// return complete groups and merging them amounts to concatenation, followed
+// by sorting in the query's order in `dispatch`. The number of groups is
+// bounded by `grouping_info::max_groups`: once a shard or the
+// super-coordinator exceeds it, the result is marked with `groups_overflow`
+// and carries no groups, so the caller has to use a regular query instead.
+//
 class mapreduce_service : public seastar::peering_sharded_service<mapreduce_service> {
     netw::messaging_service& _messaging;
     service::storage_proxy& _proxy;
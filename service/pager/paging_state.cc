@@ -28,7 +28,8 @@ service::pager::paging_state::paging_state(partition_key pk,
         uint32_t rem_high_bits,
         uint32_t rows_fetched_for_last_partition_high_bits,
         bound_weight ck_weight,
-        partition_region region)
+        partition_region region,
+        uint32_t next_page_size)
     : _partition_key(std::move(pk))
     , _clustering_key(std::move(ck))
     , _remaining_low_bits(rem_low_bits)
@@ -40,6 +41,7 @@ service::pager::paging_state::paging_state(partition_key pk,
     , _rows_fetched_for_last_partition_high_bits(rows_fetched_for_last_partition_high_bits)
     , _ck_weight(ck_weight)
     , _region(region)
+    , _next_page_size(next_page_size)
 { }
 
 service::pager::paging_state::paging_state(partition_key pk,
@@ -48,12 +50,14 @@ service::pager::paging_state::paging_state(partition_key pk,
         query_id query_uuid,
         replicas_per_token_range last_replicas,
         std::optional<db::read_repair_decision> query_read_repair_decision,
-        uint64_t rows_fetched_for_last_partition)
+        uint64_t rows_fetched_for_last_partition,
+        uint32_t next_page_size)
     : paging_state(std::move(pk), pos.has_key() ? std::optional(pos.key()) : std::nullopt, static_cast<uint32_t>(rem), query_uuid, std::move(last_replicas), query_read_repair_decision,
             static_cast<uint32_t>(rows_fetched_for_last_partition), static_cast<uint32_t>(rem >> 32),
             static_cast<uint32_t>(rows_fetched_for_last_partition >> 32),
             pos.get_bound_weight(),
-            pos.region())
+            pos.region(),
+            next_page_size)
 { }
 
 lw_shared_ptr<service::pager::paging_state> service::pager::paging_state::deserialize(
@@ -39,6 +39,7 @@ class paging_state final {
     uint32_t _rows_fetched_for_last_partition_high_bits;
     bound_weight _ck_weight = bound_weight::equal;
     partition_region _region = partition_region::partition_start;
+    uint32_t _next_page_size = 0;
 
 public:
     // IDL ctor
@@ -52,7 +53,8 @@ class paging_state final {
             uint32_t remaining_ext,
             uint32_t rows_fetched_for_last_partition_high_bits,
             bound_weight ck_weight,
-            partition_region region);
+            partition_region region,
+            uint32_t next_page_size);
 
     paging_state(partition_key pk,
             position_in_partition_view pos,
@@ -60,7 +62,8 @@ class paging_state final {
             query_id reader_recall_uuid,
             replicas_per_token_range last_replicas,
             std::optional<db::read_repair_decision> query_read_repair_decision,
-            uint64_t rows_fetched_for_last_partition);
+            uint64_t rows_fetched_for_last_partition,
+            uint32_t next_page_size = 0);
 
     void set_partition_key(partition_key pk) {
         _partition_key = std::move(pk);
@@ -179,6 +182,16 @@ class paging_state final {
         return _query_read_repair_decision;
     }
 
+    /**
+     * The number of rows adaptive paging chose for the next page, based on
+     * the size and latency of the pages served so far. 0 if adaptive paging
+     * wasn't used, in which case the page size requested by the client is
+     * used.
+     */
+    uint32_t get_next_page_size() const {
+        return _next_page_size;
+    }
+
     static lw_shared_ptr<paging_state> deserialize(bytes_opt bytes);
     bytes_opt serialize() const;
 };
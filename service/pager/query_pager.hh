@@ -59,8 +59,14 @@ class query_pager {
     struct stats {
         // Total number of rows read by this pager, based on all pages it fetched
         size_t rows_read_total = 0;
+        // Number of rows in the last page fetched by this pager
+        uint64_t last_page_rows = 0;
     };
 
+    // Adaptive paging grows pages to at most this many times the page size
+    // requested by the client.
+    static constexpr uint32_t max_page_size_growth = 16;
+
 protected:
     // remember if we use clustering. if not, each partition == one row
     const bool _has_clustering_keys;
@@ -83,6 +89,8 @@ class query_pager {
     std::optional<db::read_repair_decision> _query_read_repair_decision;
     uint64_t _rows_fetched_for_last_partition = 0;
     stats _stats;
+    std::chrono::steady_clock::time_point _page_fetch_start;
+    uint32_t _next_page_size = 0;
 
     query_function _query_function;
 
@@ -133,6 +141,17 @@ class query_pager {
         return _max;
     }
 
+    /**
+     * The number of rows to fetch in the next page, given the page size
+     * requested by the client.
+     *
+     * With adaptive paging enabled, this is the page size chosen after the
+     * previous page of the query (carried in the paging state), so that
+     * pages approach the configured size and latency budgets. Otherwise it
+     * is the requested page size.
+     */
+    uint32_t adaptive_page_size(uint32_t requested_page_size) const;
+
     /**
      * Get the current state (snapshot) of the pager. The state can allow to restart the
      * paging on another host from where we are at this point.
@@ -159,6 +178,8 @@ class query_pager {
                       const foreign_ptr<lw_shared_ptr<query::result>>& results,
                       uint32_t page_size, gc_clock::time_point now);
 
+    void update_next_page_size(uint32_t page_size, uint64_t row_count, size_t result_size);
+
     virtual uint64_t max_rows_to_fetch(uint32_t page_size) {
         return std::min(_max, static_cast<uint64_t>(page_size));
     }
@@ -17,6 +17,7 @@
 #include "service/storage_proxy.hh"
 #include "utils/result_combinators.hh"
 #include "db/view/delete_ghost_rows_visitor.hh"
+#include "db/config.hh"
 
 #include <fmt/ranges.h>
 
@@ -102,6 +103,8 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
 
     qlogger.trace("fetch_page query id {}", _cmd->query_uuid);
 
+    _page_fetch_start = std::chrono::steady_clock::now();
+
     if (_last_pkey) {
         auto dpk = dht::decorate_key(*_query_schema, *_last_pkey);
         dht::ring_position lo(dpk);
@@ -430,6 +433,8 @@ void query_pager::handle_result(
 
     qlogger.debug("Fetched {} rows, max_remain={} {}", row_count, _max, _exhausted ? "(exh)" : "");
 
+    update_next_page_size(page_size, row_count, results->buf().size());
+
     if (_last_pkey) {
         qlogger.debug("Last partition key: {}", *_last_pkey);
     }
@@ -438,8 +443,60 @@ void query_pager::handle_result(
     }
 }
 
+uint32_t query_pager::adaptive_page_size(uint32_t requested_page_size) const {
+    if (!_proxy->local_db().get_config().enable_adaptive_paging()) {
+        return requested_page_size;
+    }
+    auto state = _options.get_paging_state();
+    if (!state || !state->get_next_page_size()) {
+        return requested_page_size;
+    }
+    // The paging state comes from the client, don't trust it to stay within bounds.
+    return std::min<uint64_t>({state->get_next_page_size(), uint64_t(requested_page_size) * max_page_size_growth, std::numeric_limits<int32_t>::max()});
+}
+
+void query_pager::update_next_page_size(uint32_t page_size, uint64_t row_count, size_t result_size) {
+    _stats.last_page_rows = row_count;
+
+    const auto& cfg = _proxy->local_db().get_config();
+    if (!cfg.enable_adaptive_paging() || _exhausted) {
+        _next_page_size = 0;
+        return;
+    }
+    if (!row_count) {
+        // The page was cut before any live row was found (e.g. on
+        // tombstones), it tells nothing about the size of rows.
+        _next_page_size = page_size;
+        return;
+    }
+
+    // Scale the row count of this page by how far it was from the size and
+    // latency budgets. The page size changes at most by a factor of 2 from
+    // one page to the next, so a single slow or large page doesn't make the
+    // following ones collapse.
+    double scale = 2.0;
+    if (result_size) {
+        scale = std::min(scale, double(cfg.query_page_size_in_bytes()) / result_size);
+    }
+    if (const auto budget = std::chrono::milliseconds(cfg.adaptive_paging_time_budget_in_ms()); budget.count()) {
+        const auto latency = std::chrono::steady_clock::now() - _page_fetch_start;
+        if (latency.count() > 0) {
+            scale = std::min(scale, std::chrono::duration<double>(budget) / latency);
+        }
+    }
+    scale = std::max(scale, 0.5);
+
+    const uint64_t requested_page_size = _options.get_page_size() > 0 ? uint64_t(_options.get_page_size()) : page_size;
+    const uint64_t min_rows = std::max<uint64_t>(1, std::min<uint64_t>(cfg.adaptive_paging_min_rows(), requested_page_size));
+    const uint64_t max_rows = std::min<uint64_t>(requested_page_size * max_page_size_growth, std::numeric_limits<int32_t>::max());
+    _next_page_size = std::clamp(uint64_t(row_count * scale), min_rows, max_rows);
+
+    qlogger.trace("Adaptive paging: {} rows, {} bytes in page, next page size={}", row_count, result_size, _next_page_size);
+}
+
 lw_shared_ptr<const paging_state> query_pager::state() const {
-    return make_lw_shared<paging_state>(_last_pkey.value_or(partition_key::make_empty()), _last_pos, _exhausted ? 0 : _max, _cmd->query_uuid, _last_replicas, _query_read_repair_decision, _rows_fetched_for_last_partition);
+    return make_lw_shared<paging_state>(_last_pkey.value_or(partition_key::make_empty()), _last_pos, _exhausted ? 0 : _max, _cmd->query_uuid, _last_replicas, _query_read_repair_decision, _rows_fetched_for_last_partition,
+            _exhausted ? 0 : _next_page_size);
 }
 
 }
@@ -16,6 +16,8 @@
 #include "service/paxos/paxos_state.hh"
 #include "db/system_keyspace.hh"
 #include "replica/database.hh"
+#include "db/config.hh"
+#include "schema/schema_registry.hh"
 
 #include "utils/error_injection.hh"
 
@@ -27,6 +29,7 @@ namespace service::paxos {
 logging::logger paxos_state::logger("paxos");
 thread_local paxos_state::key_lock_map paxos_state::_paxos_table_lock;
 thread_local paxos_state::key_lock_map paxos_state::_coordinator_lock;
+thread_local paxos_state_cache paxos_state::_state_cache;
 
 paxos_state::key_lock_map::semaphore& paxos_state::key_lock_map::get_semaphore_for_key(const dht::token& key) {
     return _locks.try_emplace(key, 1).first->second;
@@ -51,6 +54,195 @@ future<paxos_state::guard> paxos_state::get_cas_lock(const dht::token& key, cloc
     co_return m;
 }
 
+// The write timestamp of the paxos table cells which store the given ballot.
+static api::timestamp_type cell_timestamp(const utils::UUID& ballot) {
+    return utils::UUID_gen::micros_timestamp(ballot);
+}
+
+paxos_state_cache::lru_list::iterator paxos_state_cache::find(const schema& s, const dht::token& token, partition_key_view key) {
+    auto [begin, end] = _index.equal_range(token);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second->table == s.id() && it->second->key.equal(s, key)) {
+            return it->second;
+        }
+    }
+    return _lru.end();
+}
+
+void paxos_state_cache::erase(lru_list::iterator it) {
+    auto [begin, end] = _index.equal_range(it->token);
+    for (auto i = begin; i != end; ++i) {
+        if (i->second == it) {
+            _index.erase(i);
+            break;
+        }
+    }
+    _lru.erase(it);
+}
+
+void paxos_state_cache::set_capacity(size_t capacity) {
+    _capacity = capacity;
+    while (_lru.size() > _capacity) {
+        erase(std::prev(_lru.end()));
+    }
+}
+
+std::optional<paxos_state> paxos_state_cache::get(const schema& s, const dht::token& token, partition_key_view key) {
+    auto it = find(s, token, key);
+    if (it == _lru.end()) {
+        return std::nullopt;
+    }
+    // The cells of the paxos table expire paxos_grace_seconds after they are written.
+    // Forget the state well before any of its cells could have expired on disk,
+    // leaving a wide margin for the clock skew between this node and the
+    // coordinators which generated the ballots.
+    const auto& state = it->state;
+    if (auto grace = s.paxos_grace_seconds(); grace.count() > 0) {
+        auto oldest = std::chrono::seconds::max();
+        auto update_oldest = [&] (const utils::UUID& ballot) {
+            oldest = std::min(oldest, utils::UUID_gen::unix_timestamp_in_sec(ballot));
+        };
+        if (state._promised_ballot != utils::UUID_gen::min_time_UUID()) {
+            update_oldest(state._promised_ballot);
+        }
+        if (state._accepted_proposal) {
+            update_oldest(state._accepted_proposal->ballot);
+        }
+        if (state._most_recent_commit) {
+            update_oldest(state._most_recent_commit->ballot);
+        }
+        if (oldest != std::chrono::seconds::max() && gc_clock::now().time_since_epoch() >= oldest + grace / 2) {
+            erase(it);
+            return std::nullopt;
+        }
+    }
+    _lru.splice(_lru.begin(), _lru, it);
+    return state;
+}
+
+void paxos_state_cache::put(const schema& s, const dht::token& token, const partition_key& key, const paxos_state& state) {
+    if (!_capacity) {
+        return;
+    }
+    if (auto it = find(s, token, key); it != _lru.end()) {
+        erase(it);
+    }
+    _lru.push_front(entry{s.id(), token, key, state});
+    _index.emplace(token, _lru.begin());
+    if (_lru.size() > _capacity) {
+        erase(std::prev(_lru.end()));
+    }
+}
+
+void paxos_state_cache::invalidate(const schema& s, const dht::token& token, partition_key_view key) {
+    if (auto it = find(s, token, key); it != _lru.end()) {
+        erase(it);
+    }
+}
+
+// The updates below mirror the writes of system_keyspace::save_paxos_*(). A newer
+// cell wins and a deletion wins over a live cell with the same timestamp. Two live
+// cells with the same timestamp are reconciled by their values, which the cache
+// does not try to reproduce: it forgets the state instead.
+//
+// Every decision deletes the accepted proposal with the timestamp of the decision,
+// so the newest such deletion is at the timestamp of the most recent commit.
+
+void paxos_state_cache::on_promise(const schema& s, const dht::token& token, partition_key_view key, const utils::UUID& ballot) {
+    auto it = find(s, token, key);
+    if (it == _lru.end()) {
+        return;
+    }
+    auto& promised = it->state._promised_ballot;
+    if (promised == utils::UUID_gen::min_time_UUID() || cell_timestamp(ballot) > cell_timestamp(promised)) {
+        promised = ballot;
+    } else if (cell_timestamp(ballot) == cell_timestamp(promised) && ballot != promised) {
+        erase(it);
+    }
+}
+
+void paxos_state_cache::on_proposal(const schema& s, const dht::token& token, const proposal& proposal) {
+    auto key = proposal.update.key();
+    on_promise(s, token, key, proposal.ballot);
+    auto it = find(s, token, key);
+    if (it == _lru.end()) {
+        return;
+    }
+    auto& state = it->state;
+    const auto ts = cell_timestamp(proposal.ballot);
+    if (state._most_recent_commit && ts <= cell_timestamp(state._most_recent_commit->ballot)) {
+        return;
+    }
+    if (!state._accepted_proposal || ts > cell_timestamp(state._accepted_proposal->ballot)) {
+        state._accepted_proposal.emplace(proposal);
+    } else if (ts == cell_timestamp(state._accepted_proposal->ballot) && proposal.ballot != state._accepted_proposal->ballot) {
+        erase(it);
+    }
+}
+
+void paxos_state_cache::on_decision(const schema& s, const dht::token& token, const proposal& decision) {
+    auto it = find(s, token, decision.update.key());
+    if (it == _lru.end()) {
+        return;
+    }
+    auto& state = it->state;
+    const auto ts = cell_timestamp(decision.ballot);
+    if (state._accepted_proposal && cell_timestamp(state._accepted_proposal->ballot) <= ts) {
+        state._accepted_proposal.reset();
+    }
+    // A prune deletes the mutation of a decision which was already learned, so it
+    // never shadows the mutation of a decision newer than the most recent one.
+    if (!state._most_recent_commit || ts > cell_timestamp(state._most_recent_commit->ballot)) {
+        state._most_recent_commit.emplace(decision);
+    } else if (ts == cell_timestamp(state._most_recent_commit->ballot) && decision.ballot != state._most_recent_commit->ballot) {
+        erase(it);
+    }
+}
+
+void paxos_state_cache::on_prune(schema_ptr s, const dht::token& token, const partition_key& key, const utils::UUID& ballot) {
+    auto it = find(*s, token, key);
+    if (it == _lru.end()) {
+        return;
+    }
+    auto& commit = it->state._most_recent_commit;
+    if (commit && cell_timestamp(commit->ballot) <= cell_timestamp(ballot)) {
+        // Same as what load_paxos_state() returns for a pruned commit
+        auto commit_ballot = commit->ballot;
+        commit.emplace(commit_ballot, freeze(mutation(s, key)));
+    }
+}
+
+paxos_state_cache* paxos_state::get_state_cache(const schema& s) {
+    // With tablets a key may move to another shard or node and back, and the
+    // state cached before it moved away would be stale.
+    if (!_state_cache.capacity() || s.table().uses_tablets()) {
+        return nullptr;
+    }
+    return &_state_cache;
+}
+
+paxos_state_cache* paxos_state::get_state_cache(storage_proxy& sp, const schema& s) {
+    _state_cache.set_capacity(sp.get_db().local().get_config().paxos_state_cache_size());
+    return get_state_cache(s);
+}
+
+future<paxos_state> paxos_state::load(storage_proxy& sp, db::system_keyspace& sys_ks, const dht::token& token, const partition_key& key, schema_ptr s,
+        gc_clock::time_point now, clock_type::time_point timeout) {
+    auto cache = get_state_cache(sp, *s);
+    if (cache) {
+        if (auto state = cache->get(*s, token, key)) {
+            sp.get_stats().cas_replica_state_cache_hits++;
+            co_return std::move(*state);
+        }
+        sp.get_stats().cas_replica_state_cache_misses++;
+    }
+    auto state = co_await sys_ks.load_paxos_state(key, s, now, timeout);
+    if (cache) {
+        cache->put(*s, token, key, state);
+    }
+    co_return state;
+}
+
 future<prepare_response> paxos_state::prepare(storage_proxy& sp, db::system_keyspace& sys_ks, tracing::trace_state_ptr tr_state, schema_ptr schema,
         const query::read_command& cmd, const partition_key& key, utils::UUID ballot,
         bool only_digest, query::digest_algorithm da, clock_type::time_point timeout) {
@@ -77,7 +269,7 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, db::system_keys
     // tombstone that hides any re-submit). See CASSANDRA-12043 for details.
     auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(ballot);
 
-    paxos_state state = co_await sys_ks.load_paxos_state(key, schema, gc_clock::time_point(now_in_sec), timeout);
+    paxos_state state = co_await load(sp, sys_ks, token, key, schema, gc_clock::time_point(now_in_sec), timeout);
     // If received ballot is newer that the one we already accepted it has to be accepted as well,
     // but we will return the previously accepted proposal so that the new coordinator will use it instead of
     // its own.
@@ -88,6 +280,14 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, db::system_keys
             co_await coroutine::return_exception(utils::injected_error("injected_error_before_save_promise"));
         }
 
+        // If saving the promise fails, it is not known whether it was written.
+        auto cache = get_state_cache(*schema);
+        auto invalidate_cache = defer([&] () noexcept {
+            if (cache) {
+                cache->invalidate(*schema, token, key);
+            }
+        });
+
         // The all() below throws only if save_paxos_promise fails.
         // If querying the result fails we continue without read round optimization
         auto [data_or_digest] = co_await coroutine::all(
@@ -111,6 +311,11 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, db::system_keys
             }
         );
 
+        invalidate_cache.cancel();
+        if (cache) {
+            cache->on_promise(*schema, token, key, ballot);
+        }
+
         if (utils::get_local_injector().enter("paxos_error_after_save_promise")) {
             co_await coroutine::return_exception(utils::injected_error("injected_error_after_save_promise"));
         }
@@ -163,7 +368,7 @@ future<bool> paxos_state::accept(storage_proxy& sp, db::system_keyspace& sys_ks,
     auto guard = co_await get_replica_lock(token, timeout);
 
     auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(proposal.ballot);
-    paxos_state state = co_await sys_ks.load_paxos_state(proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout);
+    paxos_state state = co_await load(sp, sys_ks, token, proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout);
 
     // Accept the proposal if we promised to accept it or the proposal is newer than the one we promised.
     // Otherwise the proposal was cutoff by another Paxos proposer and has to be rejected.
@@ -175,7 +380,17 @@ future<bool> paxos_state::accept(storage_proxy& sp, db::system_keyspace& sys_ks,
             co_await coroutine::return_exception(utils::injected_error("injected_error_before_save_proposal"));
         }
 
+        auto cache = get_state_cache(*schema);
+        auto invalidate_cache = defer([&] () noexcept {
+            if (cache) {
+                cache->invalidate(*schema, token, proposal.update.key());
+            }
+        });
         co_await sys_ks.save_paxos_proposal(*schema, proposal, timeout);
+        invalidate_cache.cancel();
+        if (cache) {
+            cache->on_proposal(*schema, token, proposal);
+        }
 
         if (utils::get_local_injector().enter("paxos_error_after_save_proposal")) {
             co_await coroutine::return_exception(utils::injected_error("injected_error_after_save_proposal"));
@@ -242,14 +457,54 @@ future<> paxos_state::learn(storage_proxy& sp, db::system_keyspace& sys_ks, sche
     // We don't need to lock the partition key if there is no gap between loading paxos
     // state and saving it, and here we're just blindly updating.
     co_await utils::get_local_injector().inject("paxos_timeout_after_save_decision", timeout);
-    co_return co_await sys_ks.save_paxos_decision(*schema, decision, timeout);
+    co_return co_await save_decision(sp, sys_ks, std::move(schema), decision, timeout);
+}
+
+future<> paxos_state::save_decision(storage_proxy& sp, db::system_keyspace& sys_ks, schema_ptr schema, const proposal& decision, clock_type::time_point timeout) {
+    if (!get_state_cache(sp, *schema)) {
+        co_return co_await sys_ks.save_paxos_decision(*schema, decision, timeout);
+    }
+
+    // A learn is not necessarily handled on the shard which owns the key. The cached
+    // state is only updated on the owning shard, under the replica lock, so that a
+    // concurrent prepare or accept does not cache a state loaded before the decision
+    // was saved.
+    auto token = decision.update.decorated_key(*schema).token();
+    auto shard = schema->table().shard_for_reads(token);
+    if (shard != this_shard_id()) {
+        co_return co_await sp.container().invoke_on(shard, [&sys_ks = sys_ks.container(), gs = global_schema_ptr(schema), &decision, timeout] (storage_proxy& sp) {
+            return save_decision(sp, sys_ks.local(), gs, decision, timeout);
+        });
+    }
+
+    auto guard = co_await get_replica_lock(token, timeout);
+    auto cache = get_state_cache(*schema);
+    auto invalidate_cache = defer([&] () noexcept {
+        if (cache) {
+            cache->invalidate(*schema, token, decision.update.key());
+        }
+    });
+    co_await sys_ks.save_paxos_decision(*schema, decision, timeout);
+    invalidate_cache.cancel();
+    if (cache) {
+        cache->on_decision(*schema, token, decision);
+    }
 }
 
 future<> paxos_state::prune(db::system_keyspace& sys_ks, schema_ptr schema, const partition_key& key, utils::UUID ballot, clock_type::time_point timeout,
         tracing::trace_state_ptr tr_state) {
     logger.debug("Delete paxos state for ballot {}", ballot);
     tracing::trace(tr_state, "Delete paxos state for ballot {}", ballot);
-    return sys_ks.delete_paxos_decision(*schema, key, ballot, timeout);
+    auto cache = get_state_cache(*schema);
+    if (!cache) {
+        co_return co_await sys_ks.delete_paxos_decision(*schema, key, ballot, timeout);
+    }
+    // Only drops the mutation of a learned decision, so if the key is not owned
+    // by this shard it is harmless for the owner to keep returning it.
+    auto token = dht::get_token(*schema, key);
+    auto guard = co_await get_replica_lock(token, timeout);
+    co_await sys_ks.delete_paxos_decision(*schema, key, ballot, timeout);
+    cache->on_prune(schema, token, key, ballot);
 }
 
 } // end of namespace "service::paxos"
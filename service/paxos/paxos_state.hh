@@ -13,8 +13,10 @@
 #include "utils/digest_algorithm.hh"
 #include "db/timeout_clock.hh"
 #include <unordered_map>
+#include <list>
 #include "utils/UUID_gen.hh"
 #include "service/paxos/prepare_response.hh"
+#include "schema/schema_fwd.hh"
 
 namespace service {
 class storage_proxy;
@@ -25,6 +27,8 @@ namespace service::paxos {
 
 using clock_type = db::timeout_clock;
 
+class paxos_state_cache;
+
 // The state of a CAS update of a given primary key as persisted in the paxos table.
 class paxos_state {
 private:
@@ -73,10 +77,21 @@ class paxos_state {
 
     static future<guard> get_replica_lock(const dht::token& key, clock_type::time_point timeout);
 
+    // Caches the paxos state of the keys owned by this shard.
+    static thread_local paxos_state_cache _state_cache;
+
+    // Returns the cache to use for the given table, if any.
+    static paxos_state_cache* get_state_cache(const schema& s);
+    static paxos_state_cache* get_state_cache(storage_proxy& sp, const schema& s);
+    static future<paxos_state> load(storage_proxy& sp, db::system_keyspace& sys_ks, const dht::token& token, const partition_key& key, schema_ptr s,
+            gc_clock::time_point now, clock_type::time_point timeout);
+    static future<> save_decision(storage_proxy& sp, db::system_keyspace& sys_ks, schema_ptr schema, const proposal& decision, clock_type::time_point timeout);
+
     utils::UUID _promised_ballot = utils::UUID_gen::min_time_UUID();
     std::optional<proposal> _accepted_proposal;
     std::optional<proposal> _most_recent_commit;
 
+    friend class paxos_state_cache;
 public:
 
     static future<guard> get_cas_lock(const dht::token& key, clock_type::time_point timeout);
@@ -103,5 +118,39 @@ class paxos_state {
             tracing::trace_state_ptr tr_state);
 };
 
+// A write-through cache of the paxos state of recently used keys, which
+// spares a read of system.paxos in each round. Every write of the paxos
+// table is applied to the cached copy following the timestamp rules of the
+// table, so a cached state is the same as what load_paxos_state() would
+// return. Entries are only accessed with the replica lock of their key held.
+class paxos_state_cache {
+    struct entry {
+        table_id table;
+        dht::token token;
+        partition_key key;
+        paxos_state state;
+    };
+    using lru_list = std::list<entry>;
+
+    lru_list _lru;
+    std::unordered_multimap<dht::token, lru_list::iterator> _index;
+    size_t _capacity = 0;
+
+    lru_list::iterator find(const schema& s, const dht::token& token, partition_key_view key);
+    void erase(lru_list::iterator it);
+public:
+    size_t capacity() const noexcept {
+        return _capacity;
+    }
+    void set_capacity(size_t capacity);
+    std::optional<paxos_state> get(const schema& s, const dht::token& token, partition_key_view key);
+    void put(const schema& s, const dht::token& token, const partition_key& key, const paxos_state& state);
+    void invalidate(const schema& s, const dht::token& token, partition_key_view key);
+    void on_promise(const schema& s, const dht::token& token, partition_key_view key, const utils::UUID& ballot);
+    void on_proposal(const schema& s, const dht::token& token, const proposal& proposal);
+    void on_decision(const schema& s, const dht::token& token, const proposal& decision);
+    void on_prune(schema_ptr s, const dht::token& token, const partition_key& key, const utils::UUID& ballot);
+};
+
 } // end of namespace "service::paxos"
 
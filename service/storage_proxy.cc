@@ -29,6 +29,9 @@
 #include "mutation/async_utils.hh"
 #include "query_result_merger.hh"
 #include <seastar/core/do_with.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/with_timeout.hh>
 #include "message/messaging_service.hh"
 #include "gms/gossiper.hh"
 #include <seastar/core/future-util.hh>
@@ -248,6 +251,24 @@ class storage_proxy::remote {
     netw::connection_drop_slot_t _connection_dropped;
     netw::connection_drop_registration_t _condrop_registration;
 
+    // Writes waiting on this shard to be sent to a replica in a single
+    // MUTATION_BATCH message. Batches are kept per destination and per
+    // scheduling group, since the scheduling group selects both the RPC
+    // connection (tenant) and the stats the writes are accounted to.
+    struct mutation_batch {
+        locator::host_id addr;
+        scheduling_group sg;
+        std::vector<batched_mutation> mutations;
+        storage_proxy::clock_type::time_point timeout = storage_proxy::clock_type::time_point::min();
+        size_t bytes = 0;
+        shared_promise<> sent;
+        timer<> flush_timer;
+
+        mutation_batch(locator::host_id addr, scheduling_group sg) : addr(addr), sg(sg) {}
+    };
+    std::unordered_map<locator::host_id, std::vector<lw_shared_ptr<mutation_batch>>> _mutation_batches;
+    gate _mutation_batches_gate;
+
     bool _stopped{false};
 
 public:
@@ -261,9 +282,11 @@ class storage_proxy::remote {
         ser::storage_proxy_rpc_verbs::register_mutation(&_ms, std::bind_front(&remote::receive_mutation_handler, this, _sp._write_smp_service_group));
         ser::storage_proxy_rpc_verbs::register_hint_mutation(&_ms, std::bind_front(&remote::receive_hint_mutation_handler, this));
         ser::storage_proxy_rpc_verbs::register_paxos_learn(&_ms, std::bind_front(&remote::handle_paxos_learn, this));
+        ser::storage_proxy_rpc_verbs::register_mutation_batch(&_ms, std::bind_front(&remote::handle_mutation_batch, this));
         ser::storage_proxy_rpc_verbs::register_mutation_done(&_ms, std::bind_front(&remote::handle_mutation_done, this));
         ser::storage_proxy_rpc_verbs::register_mutation_failed(&_ms, std::bind_front(&remote::handle_mutation_failed, this));
         ser::storage_proxy_rpc_verbs::register_read_data(&_ms, std::bind_front(&remote::handle_read_data, this));
+        ser::storage_proxy_rpc_verbs::register_read_data_multi(&_ms, std::bind_front(&remote::handle_read_data_multi, this));
         ser::storage_proxy_rpc_verbs::register_read_mutation_data(&_ms, std::bind_front(&remote::handle_read_mutation_data, this));
         ser::storage_proxy_rpc_verbs::register_read_digest(&_ms, std::bind_front(&remote::handle_read_digest, this));
         ser::storage_proxy_rpc_verbs::register_truncate(&_ms, std::bind_front(&remote::handle_truncate, this));
@@ -282,6 +305,8 @@ class storage_proxy::remote {
     future<> stop() {
         _group0_as.request_abort();
         co_await std::move(_truncate_table_fiber);
+        flush_mutation_batches();
+        co_await _mutation_batches_gate.close();
         co_await ser::storage_proxy_rpc_verbs::unregister(&_ms);
         _stopped = true;
     }
@@ -329,6 +354,96 @@ class storage_proxy::remote {
                 response_id, trace_info, rate_limit_info, fence, forward, reply_to);
     }
 
+    // Like send_mutation(), but may delay the write by up to mutation_batching_max_delay_in_us
+    // to send it to the replica together with other writes, in a single MUTATION_BATCH message.
+    // The replica acknowledges each write in the batch separately, with MUTATION_DONE or
+    // MUTATION_FAILED as soon as it is applied, so a slow write doesn't hold back the others.
+    //
+    // The batch shares the frozen mutation with the write response handler instead of copying it.
+    //
+    // Must only be used by the coordinator of the write (forwarded writes are
+    // acknowledged to their original coordinator, not to us).
+    future<> send_mutation_maybe_batched(
+            locator::host_id addr, storage_proxy::clock_type::time_point timeout, const std::optional<tracing::trace_info>& trace_info,
+            lw_shared_ptr<const frozen_mutation> m, const host_id_vector_replica_set& forward, storage_proxy::response_id_type response_id,
+            db::per_partition_rate_limit::info rate_limit_info, fencing_token fence) {
+        const auto& cfg = _sp._db.local().get_config();
+        const auto size = m->representation().size();
+        if (!cfg.enable_mutation_batching() || !_sp.features().mutation_batch_verb || !forward.empty() || trace_info
+                || size >= cfg.mutation_batching_max_bytes() || _mutation_batches_gate.is_closed()) {
+            return send_mutation(addr, timeout, trace_info, *m, forward, _sp.my_address(), _sp.get_token_metadata_ptr()->get_my_id(), this_shard_id(),
+                    response_id, rate_limit_info, fence);
+        }
+
+        auto& batch = get_mutation_batch(addr);
+        batch.mutations.push_back(batched_mutation{std::move(m), response_id, rate_limit_info, fence});
+        batch.bytes += size;
+        batch.timeout = std::max(batch.timeout, timeout);
+        auto f = batch.sent.get_shared_future();
+        if (batch.mutations.size() >= cfg.mutation_batching_max_mutations() || batch.bytes >= cfg.mutation_batching_max_bytes()) {
+            flush_mutation_batch(batch);
+        } else if (!batch.flush_timer.armed()) {
+            batch.flush_timer.arm(std::chrono::microseconds(cfg.mutation_batching_max_delay_in_us()));
+        }
+        return f;
+    }
+
+    mutation_batch& get_mutation_batch(locator::host_id addr) {
+        auto sg = current_scheduling_group();
+        auto& batches = _mutation_batches[addr];
+        auto it = std::ranges::find_if(batches, [sg] (const lw_shared_ptr<mutation_batch>& b) { return b->sg == sg; });
+        if (it != batches.end()) {
+            return **it;
+        }
+        auto batch = make_lw_shared<mutation_batch>(addr, sg);
+        batch->flush_timer.set_callback([this, &b = *batch] { flush_mutation_batch(b); });
+        batches.push_back(batch);
+        return *batch;
+    }
+
+    // Detaches the batch from _mutation_batches and sends it in the background.
+    void flush_mutation_batch(mutation_batch& batch) {
+        batch.flush_timer.cancel();
+        auto& batches = _mutation_batches[batch.addr];
+        auto it = std::ranges::find_if(batches, [&batch] (const lw_shared_ptr<mutation_batch>& b) { return b.get() == &batch; });
+        auto b = std::move(*it);
+        batches.erase(it);
+        if (batches.empty()) {
+            _mutation_batches.erase(batch.addr);
+        }
+        auto sg = b->sg;
+        // Waited on indirectly, via _mutation_batches_gate.
+        (void)with_gate(_mutation_batches_gate, [this, sg, b = std::move(b)] () mutable {
+            return with_scheduling_group(sg, [this, b = std::move(b)] () mutable {
+                return send_mutation_batch(std::move(b));
+            });
+        });
+    }
+
+    void flush_mutation_batches() {
+        while (!_mutation_batches.empty()) {
+            flush_mutation_batch(*_mutation_batches.begin()->second.front());
+        }
+    }
+
+    // Like MUTATION, MUTATION_BATCH is one-way: the outcome of sending the batch is
+    // the outcome of send_mutation_maybe_batched() for every write in it, and the
+    // replica acknowledges the writes one by one.
+    future<> send_mutation_batch(lw_shared_ptr<mutation_batch> batch) {
+        auto& stats = _sp.get_stats();
+        ++stats.mutation_batches_sent;
+        stats.batched_mutations_sent += batch->mutations.size();
+        stats.mutation_batch_size.add(batch->mutations.size());
+
+        auto f = co_await coroutine::as_future(ser::storage_proxy_rpc_verbs::send_mutation_batch(&_ms, batch->addr, batch->timeout,
+                batch->mutations, this_shard_id()));
+        if (f.failed()) {
+            batch->sent.set_exception(f.get_exception());
+        } else {
+            batch->sent.set_value();
+        }
+    }
+
     future<> send_hint_mutation(
             locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             const frozen_mutation& m, const host_id_vector_replica_set& forward, gms::inet_address reply_to_ip, locator::host_id reply_to, unsigned shard,
@@ -403,6 +518,32 @@ class storage_proxy::remote {
         co_return rpc::tuple{make_foreign(::make_lw_shared<query::result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())};
     }
 
+    // Reads several singular partition ranges from a single replica with one
+    // READ_DATA_MULTI request. The results are returned in the order of `ranges`.
+    //
+    // The arguments are only used until the request is sent, so the caller
+    // may stop waiting for the response (and destroy them) before it arrives.
+    future<rpc::tuple<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>, cache_temperature>>
+    send_read_data_multi(
+            locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
+            const query::read_command& cmd, const std::vector<::compat::wrapping_partition_range>& ranges,
+            const std::vector<db::per_partition_rate_limit::info>& rate_limit_info,
+            fencing_token fence) {
+        const auto range_count = ranges.size();
+        tracing::trace(tr_state, "read_data_multi: sending a message for {} partitions to /{}", range_count, addr);
+        auto&& [results, hit_rate, exception] =
+            co_await ser::storage_proxy_rpc_verbs::send_read_data_multi(&_ms, addr, timeout, cmd, ranges, rate_limit_info, fence);
+        if (exception) {
+            co_await coroutine::return_exception_ptr(std::move(exception).into_exception_ptr());
+        }
+        if (results.size() != range_count) {
+            co_await coroutine::return_exception(std::runtime_error(format("READ_DATA_MULTI returned {} results for {} partition ranges", results.size(), range_count)));
+        }
+
+        tracing::trace(tr_state, "read_data_multi: got response from /{}", addr);
+        co_return rpc::tuple{std::move(results), hit_rate};
+    }
+
     future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>>
     send_read_digest(
             locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
@@ -762,25 +903,101 @@ class storage_proxy::remote {
             error err = error::FAILURE;
             std::optional<sstring> msg;
             if (exception) {
-                err = std::visit([&] <typename Ex> (Ex& e) {
-                    if constexpr (std::is_same_v<Ex, replica::rate_limit_exception>) {
-                        return error::RATE_LIMIT;
-                    } else if constexpr (std::is_same_v<Ex, replica::unknown_exception> || std::is_same_v<Ex, replica::no_exception>) {
-                        return error::FAILURE;
-                    } else if constexpr(std::is_same_v<Ex, replica::stale_topology_exception>) {
-                        msg = e.what();
-                        return error::FAILURE;
-                    } else if constexpr (std::is_same_v<Ex, replica::abort_requested_exception>) {
-                        msg = e.what();
-                        return error::FAILURE;
-                    }
-                }, exception->reason);
+                std::tie(err, msg) = decode_write_failure(*exception);
             }
             sp.got_failure_response(response_id, from, num_failed, std::move(backlog), err, std::move(msg));
             return netw::messaging_service::no_wait();
         });
     }
 
+    static std::pair<error, std::optional<sstring>> decode_write_failure(replica::exception_variant& exception) {
+        std::optional<sstring> msg;
+        error err = std::visit([&] <typename Ex> (Ex& e) {
+            if constexpr (std::is_same_v<Ex, replica::rate_limit_exception>) {
+                return error::RATE_LIMIT;
+            } else if constexpr (std::is_same_v<Ex, replica::unknown_exception> || std::is_same_v<Ex, replica::no_exception>) {
+                return error::FAILURE;
+            } else if constexpr(std::is_same_v<Ex, replica::stale_topology_exception>) {
+                msg = e.what();
+                return error::FAILURE;
+            } else if constexpr (std::is_same_v<Ex, replica::abort_requested_exception>) {
+                msg = e.what();
+                return error::FAILURE;
+            }
+        }, exception.reason);
+        return {err, std::move(msg)};
+    }
+
+    // Applies the writes of a MUTATION_BATCH and acknowledges each of them to the
+    // coordinator as soon as it is applied, same as handle_write() does for MUTATION.
+    future<rpc::no_wait_type> handle_mutation_batch(
+            const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<batched_mutation> mutations, unsigned shard) {
+        auto src_addr = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+
+        storage_proxy::clock_type::time_point timeout;
+        if (!t) {
+            auto timeout_in_ms = _sp._db.local().get_config().write_request_timeout_in_ms();
+            timeout = clock_type::now() + std::chrono::milliseconds(timeout_in_ms);
+        } else {
+            timeout = *t;
+        }
+
+        shared_ptr<storage_proxy> p = _sp.shared_from_this();
+        ++p->get_stats().received_mutation_batches;
+        p->get_stats().received_mutations += mutations.size();
+
+        co_await coroutine::parallel_for_each(mutations, [&] (batched_mutation& m) -> future<> {
+            replica::exception_variant error;
+            if (auto stale = _sp.apply_fence(m.fence, src_addr)) {
+                error = std::move(*stale);
+            } else {
+                try {
+                    auto op = _sp.start_write();
+                    // FIXME: get_schema_for_write() doesn't timeout
+                    schema_ptr s = co_await get_schema_for_write(m.fm->schema_version(), src_addr, shard, timeout);
+                    co_await utils::get_local_injector().inject("storage_proxy::handle_mutation_batch", [s] (auto& handler) -> future<> {
+                        const auto cf_name = handler.get("cf_name");
+                        SCYLLA_ASSERT(cf_name);
+                        if (s->cf_name() != cf_name) {
+                            co_return;
+                        }
+                        if (handler.get("fail")) {
+                            throw std::runtime_error("storage_proxy::handle_mutation_batch injected failure");
+                        }
+                        slogger.info("storage_proxy::handle_mutation_batch injection hit");
+                        co_await handler.wait_for_message(std::chrono::steady_clock::now() + std::chrono::minutes{1});
+                        slogger.info("storage_proxy::handle_mutation_batch injection done");
+                    });
+                    co_await p->apply_fence(p->mutate_locally(std::move(s), *m.fm, tracing::trace_state_ptr(), db::commitlog::force_sync::no, timeout,
+                            _sp._write_smp_service_group, m.rate_limit_info), m.fence, src_addr);
+                } catch (...) {
+                    std::exception_ptr eptr = std::current_exception();
+                    error = replica::try_encode_replica_exception(eptr);
+                    seastar::log_level l = seastar::log_level::warn;
+                    if (is_timeout_exception(eptr)
+                            || std::holds_alternative<replica::rate_limit_exception>(error.reason)
+                            || std::holds_alternative<abort_requested_exception>(error.reason)) {
+                        // ignore timeouts, abort requests and rate limit exceptions so that logs are not flooded.
+                        l = seastar::log_level::debug;
+                    }
+                    slogger.log(l, "Failed to apply batched mutation from {}#{}: {}", src_addr, shard, eptr);
+                    // no_exception would be taken for the absence of an error, so errors
+                    // which can't be encoded are reported as unknown_exception.
+                    if (!error) {
+                        error = replica::exception_variant(replica::unknown_exception{});
+                    }
+                }
+            }
+            // As in handle_write(), wait for the acknowledgement to be sent, so that
+            // unsent responses don't accumulate if the coordinator is busy.
+            auto f = co_await coroutine::as_future(!error
+                    ? send_mutation_done(src_addr, tracing::trace_state_ptr(), shard, m.response_id, p->get_view_update_backlog())
+                    : send_mutation_failed(src_addr, tracing::trace_state_ptr(), shard, m.response_id, 1, p->get_view_update_backlog(), std::move(error)));
+            f.ignore_ready_future();
+        });
+        co_return netw::messaging_service::no_wait();
+    }
+
     using read_verb = storage_proxy_remote_read_verb;
 
     template<typename Result, read_verb verb>
@@ -928,6 +1145,81 @@ class storage_proxy::remote {
             std::move(pr), oda, rate_limit_info_opt, fence);
     }
 
+    using read_data_multi_result_t = rpc::tuple<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>, cache_temperature, replica::exception_variant>;
+    future<read_data_multi_result_t> handle_read_data_multi(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            query::read_command cmd1, std::vector<::compat::wrapping_partition_range> ranges,
+            std::vector<db::per_partition_rate_limit::info> rate_limit_info,
+            service::fencing_token fence) {
+        tracing::trace_state_ptr trace_state_ptr;
+        auto src_addr = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        auto src_shard = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+
+        if (cmd1.trace_info) {
+            trace_state_ptr = tracing::tracing::get_local_tracing_instance().create_session(*cmd1.trace_info);
+            tracing::begin(trace_state_ptr);
+            tracing::trace(trace_state_ptr, "read_data_multi: message received from /{} for {} partitions", src_addr, ranges.size());
+        }
+        if (!cmd1.max_result_size) {
+            auto& cfg = _sp.local_db().get_config();
+            cmd1.max_result_size.emplace(cfg.max_memory_for_unlimited_query_soft_limit(), cfg.max_memory_for_unlimited_query_hard_limit());
+        }
+        shared_ptr<storage_proxy> p = _sp.shared_from_this();
+        auto cmd = make_lw_shared<query::read_command>(std::move(cmd1));
+        auto timeout = t ? *t : db::no_timeout;
+
+        // The coordinator only groups reads when native reversed queries are
+        // enabled cluster-wide, so the command never needs a format conversion.
+        auto f_s = co_await coroutine::as_future(get_schema_for_read(cmd->schema_version, src_addr, src_shard, timeout));
+        if (f_s.failed()) {
+            co_return co_await encode_replica_exception_for_rpc<read_data_multi_result_t>(p->features(), f_s.get_exception());
+        }
+        schema_ptr s = f_s.get();
+
+        if (auto stale = _sp.apply_fence(fence, src_addr)) {
+            co_return co_await encode_replica_exception_for_rpc<read_data_multi_result_t>(p->features(), std::make_exception_ptr(std::move(*stale)));
+        }
+
+        auto erm = s->table().get_effective_replication_map();
+        query::result_options opts{query::result_request::only_result, query::digest_algorithm::none};
+        std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results(ranges.size());
+        auto hit_rate = cache_temperature::invalid();
+        auto f = co_await coroutine::as_future(futurize_invoke([&] () -> future<> {
+            co_await utils::get_local_injector().inject("storage_proxy::handle_read_data_multi", [] (auto& handler) -> future<> {
+                if (handler.get("fail")) {
+                    throw std::runtime_error("storage_proxy::handle_read_data_multi injected failure");
+                }
+                slogger.info("storage_proxy::handle_read_data_multi injection hit");
+                co_await handler.wait_for_message(std::chrono::steady_clock::now() + std::chrono::minutes{1});
+                slogger.info("storage_proxy::handle_read_data_multi injection done");
+            });
+            if (rate_limit_info.size() != ranges.size()) {
+                throw std::runtime_error(format("READ_DATA_MULTI called with {} rate limit entries for {} partition ranges", rate_limit_info.size(), ranges.size()));
+            }
+            co_await coroutine::parallel_for_each(std::views::iota(size_t(0), ranges.size()), [&] (size_t i) -> future<> {
+                auto pr = ::compat::unwrap(std::move(ranges[i]), *s);
+                if (pr.second) {
+                    // this function assumes singular queries but doesn't validate
+                    throw std::runtime_error("READ_DATA_MULTI called with wrapping range");
+                }
+                p->get_stats().replica_data_reads++;
+                auto [r, ht] = co_await p->query_result_local(erm, s, cmd, pr.first, opts, trace_state_ptr, timeout, rate_limit_info[i]);
+                // The result may live on another shard, it is serialized from there, as with READ_DATA.
+                results[i] = std::move(r);
+                hit_rate = ht;
+            });
+        }));
+        tracing::trace(trace_state_ptr, "read_data_multi handling is done, sending a response to /{}", src_addr);
+
+        if (auto stale = _sp.apply_fence(fence, src_addr)) {
+            co_return co_await encode_replica_exception_for_rpc<read_data_multi_result_t>(p->features(), std::make_exception_ptr(std::move(*stale)));
+        }
+        if (f.failed()) {
+            co_return co_await encode_replica_exception_for_rpc<read_data_multi_result_t>(p->features(), f.get_exception());
+        }
+        co_return read_data_multi_result_t{std::move(results), hit_rate, replica::exception_variant{}};
+    }
+
     using read_mutation_data_result_t = rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature, replica::exception_variant>;
     future<read_mutation_data_result_t> handle_read_mutation_data(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
@@ -1269,9 +1561,8 @@ class per_destination_mutation : public mutation_holder {
         auto m = _mutations[ep];
         if (m) {
             tracing::trace(tr_state, "Sending a mutation to /{}", ep);
-            return sp.remote().send_mutation(ep, timeout, tracing::make_trace_info(tr_state),
-                    *m, forward, sp.my_address(), sp.get_token_metadata_ptr()->get_my_id(), this_shard_id(),
-                    response_id, rate_limit_info, fence);
+            return sp.remote().send_mutation_maybe_batched(ep, timeout, tracing::make_trace_info(tr_state),
+                    std::move(m), forward, response_id, rate_limit_info, fence);
         }
         sp.got_response(response_id, ep, std::nullopt);
         return make_ready_future<>();
@@ -1319,9 +1610,8 @@ class shared_mutation : public mutation_holder {
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) override {
         tracing::trace(tr_state, "Sending a mutation to /{}", ep);
-        return sp.remote().send_mutation(ep, timeout, tracing::make_trace_info(tr_state),
-                *_mutation, forward, sp.my_address(), sp.get_token_metadata_ptr()->get_my_id(), this_shard_id(),
-                response_id, rate_limit_info, fence);
+        return sp.remote().send_mutation_maybe_batched(ep, timeout, tracing::make_trace_info(tr_state),
+                _mutation, forward, response_id, rate_limit_info, fence);
     }
     virtual bool is_shared() override {
         return true;
@@ -2856,6 +3146,26 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of range read operations failed due to an \"unavailable\" error"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("mutation_batches", mutation_batches_sent,
+                       sm::description("number of MUTATION_BATCH messages sent to replicas"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("batched_mutations", batched_mutations_sent,
+                       sm::description("number of writes sent to replicas as a part of a MUTATION_BATCH message"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_histogram("mutation_batch_size", sm::description("how many writes were coalesced into a single MUTATION_BATCH message"),
+                       {storage_proxy_stats::current_scheduling_group_label()},
+                       [this]{ return mutation_batch_size.get_histogram(1, 8);}).set_skip_when_empty(),
+
+        sm::make_total_operations("grouped_read_requests", grouped_read_requests,
+                       sm::description("number of requests which read several partitions from a single replica at once"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("grouped_partition_reads", grouped_partition_reads,
+                       sm::description("number of partitions read as a part of a request for several partitions from a single replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("speculative_digest_reads", speculative_digest_reads,
                        sm::description("number of speculative digest read requests that were sent"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2974,10 +3284,22 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("received_mutation_batches", received_mutation_batches,
+                       sm::description("number of MUTATION_BATCH messages received by a replica Node"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("cas_dropped_prune", cas_replica_dropped_prune,
                        sm::description("how many times a coordinator did not perform prune after cas"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("cas_state_cache_hits", cas_replica_state_cache_hits,
+                       sm::description("number of times the paxos state of a key was found in the cache of a replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("cas_state_cache_misses", cas_replica_state_cache_misses,
+                       sm::description("number of times the paxos state of a key was read from system.paxos by a replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_counter("received_hints_total", received_hints_total,
                         sm::description("number of hints and MV hints received by this node"),
                         {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -5185,6 +5507,29 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         return _used_targets;
     }
 
+    /// The replica the data is read from, if the read needs the response
+    /// of a single replica (and so no digest requests or read repair).
+    std::optional<locator::host_id> single_data_target() const {
+        if (_block_for != 1 || _targets.empty()) {
+            return std::nullopt;
+        }
+        return _targets.front();
+    }
+
+    const dht::partition_range& partition_range() const noexcept {
+        return _partition_range;
+    }
+
+    db::per_partition_rate_limit::info rate_limit_info() const noexcept {
+        return _rate_limit_info;
+    }
+
+    /// How long the read waits for the replicas before it sends a speculative
+    /// request to another one, if it speculates.
+    virtual std::optional<storage_proxy::clock_type::duration> speculative_retry_delay() const {
+        return std::nullopt;
+    }
+
 protected:
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> make_mutation_data_request(lw_shared_ptr<query::read_command> cmd, locator::host_id ep, clock_type::time_point timeout) {
         ++_proxy->get_stats().mutation_data_read_attempts.get_ep_stat(get_topology(), ep);
@@ -5605,6 +5950,9 @@ class always_speculating_read_executor : public abstract_read_executor {
         make_data_requests(resolver, _targets.begin(), _targets.begin() + 2, timeout, want_digest);
         make_digest_requests(resolver, _targets.begin() + 2, _targets.end(), timeout);
     }
+    virtual std::optional<storage_proxy::clock_type::duration> speculative_retry_delay() const override {
+        return storage_proxy::clock_type::duration::zero();
+    }
 };
 
 // this executor sends request to an additional replica after some time below timeout
@@ -5637,11 +5985,7 @@ class speculating_read_executor : public abstract_read_executor {
                 send_request(resolver->has_data());
             }
         });
-        auto& sr = _schema->speculative_retry();
-        auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
-            std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
-            std::chrono::milliseconds(unsigned(sr.get_value()));
-        _speculate_timer.arm(t);
+        _speculate_timer.arm(*speculative_retry_delay());
 
         // if CL + RR result in covering all replicas, getReadExecutor forces AlwaysSpeculating.  So we know
         // that the last replica in our list is "extra."
@@ -5664,6 +6008,12 @@ class speculating_read_executor : public abstract_read_executor {
     virtual void got_cl() override {
         _speculate_timer.cancel();
     }
+    virtual std::optional<storage_proxy::clock_type::duration> speculative_retry_delay() const override {
+        auto& sr = _schema->speculative_retry();
+        return (sr.get_type() == speculative_retry::type::PERCENTILE) ?
+            std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
+            std::chrono::milliseconds(unsigned(sr.get_value()));
+    }
     virtual void adjust_targets_for_reconciliation() override {
         _targets = used_targets();
     }
@@ -5830,6 +6180,54 @@ void storage_proxy::handle_read_error(std::variant<exceptions::coordinator_excep
     }));
 }
 
+future<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>>
+storage_proxy::query_singular_grouped(lw_shared_ptr<query::read_command> cmd,
+        locator::effective_replication_map_ptr erm, locator::host_id replica,
+        std::vector<::shared_ptr<abstract_read_executor>> executors,
+        tracing::trace_state_ptr trace_state, clock_type::time_point timeout) {
+    std::vector<::compat::wrapping_partition_range> ranges;
+    std::vector<db::per_partition_rate_limit::info> rate_limit_info;
+    ranges.reserve(executors.size());
+    rate_limit_info.reserve(executors.size());
+    for (auto& e : executors) {
+        ranges.emplace_back(e->partition_range());
+        rate_limit_info.push_back(e->rate_limit_info());
+    }
+
+    get_stats().grouped_read_requests++;
+    get_stats().grouped_partition_reads += executors.size();
+    // If the grouped read fails, the executors read the partitions again, so
+    // leave them at least half of the time the query has left.
+    const auto now = clock_type::now();
+    const auto group_timeout = now + (timeout - now) / 2;
+    auto f = remote().send_read_data_multi(replica, group_timeout, trace_state, *cmd, ranges, rate_limit_info, get_fence(*erm));
+    // The grouped read doesn't speculate by itself. Instead, if the replica doesn't
+    // respond within the shortest speculative retry delay of the partitions, they
+    // are read by their executors, which speculate as usual.
+    std::optional<clock_type::duration> speculate_after;
+    for (auto& e : executors) {
+        if (auto d = e->speculative_retry_delay()) {
+            speculate_after = std::min(speculate_after.value_or(*d), *d);
+        }
+    }
+    if (speculate_after && now + *speculate_after < group_timeout) {
+        f = seastar::with_timeout(now + *speculate_after, std::move(f));
+    }
+    auto res = co_await coroutine::as_future(std::move(f));
+    if (res.failed()) {
+        // Let the executors read the partitions, they will retry or speculate as usual.
+        auto ex = res.get_exception();
+        tracing::trace(trace_state, "Reading {} partitions from /{} with a single request failed, reading them separately: {}", executors.size(), replica, ex);
+        slogger.debug("Reading {} partitions from {} with a single request failed: {}", executors.size(), replica, ex);
+        co_return std::vector<foreign_ptr<lw_shared_ptr<query::result>>>{};
+    }
+    auto&& [results, hit_rate] = res.get();
+    for (auto& e : executors) {
+        e->get_cf()->set_hit_rate(replica, hit_rate);
+    }
+    co_return std::move(results);
+}
+
 future<result<storage_proxy::coordinator_query_result>>
 storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
         dht::partition_range_vector&& partition_ranges,
@@ -5903,8 +6301,62 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
                 handle_completion(exec[0]);
             }
         } else {
+            // Partitions which need the data of a single replica are read from
+            // the same replica with a single request. The group is read when
+            // the first of its partitions is mapped, so the results are still
+            // merged in the order of the partition ranges.
+            struct read_group {
+                locator::host_id replica;
+                std::vector<::shared_ptr<abstract_read_executor>> executors;
+                std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results;
+                std::optional<shared_future<>> done;
+            };
+            std::vector<read_group> groups;
+            // Group and position in the group, for each grouped executor
+            std::vector<std::optional<std::pair<size_t, size_t>>> grouped(exec.size());
+            if (repair_decision == db::read_repair_decision::NONE
+                    && features().read_data_multi_verb
+                    && (!cmd->slice.is_reversed() || features().native_reverse_queries)
+                    && _db.local().get_config().enable_grouped_partition_reads()) {
+                std::unordered_map<locator::host_id, std::vector<size_t>> indexes_per_replica;
+                for (size_t i = 0; i < exec.size(); ++i) {
+                    // Reads which send data requests to several replicas right away aren't grouped.
+                    if (exec[i].first->speculative_retry_delay() == clock_type::duration::zero()) {
+                        continue;
+                    }
+                    if (auto replica = exec[i].first->single_data_target(); replica && !is_me(*erm, *replica)) {
+                        indexes_per_replica[*replica].push_back(i);
+                    }
+                }
+                for (auto& [replica, indexes] : indexes_per_replica) {
+                    if (indexes.size() < 2) {
+                        continue;
+                    }
+                    auto& group = groups.emplace_back(read_group{.replica = replica});
+                    for (auto i : indexes) {
+                        grouped[i].emplace(groups.size() - 1, group.executors.size());
+                        group.executors.push_back(exec[i].first);
+                    }
+                }
+            }
+
             auto mapper = [&] (
                     std::pair<::shared_ptr<abstract_read_executor>, dht::token_range>& executor_and_token_range) -> future<::result<foreign_ptr<lw_shared_ptr<query::result>>>> {
+                if (auto& g = grouped[&executor_and_token_range - exec.data()]) {
+                    auto& group = groups[g->first];
+                    if (!group.done) {
+                        group.done.emplace(query_singular_grouped(cmd, erm, group.replica, group.executors, query_options.trace_state, timeout).then(
+                                [&group] (std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results) {
+                            group.results = std::move(results);
+                        }));
+                    }
+                    co_await group.done->get_future();
+                    // If the grouped read failed, the partition is read on its own below.
+                    if (!group.results.empty()) {
+                        used_replicas.emplace(std::move(executor_and_token_range.second), std::vector<locator::host_id>{group.replica});
+                        co_return std::move(group.results[g->second]);
+                    }
+                }
                 auto result = co_await executor_and_token_range.first->execute(timeout);
                 // Handle success here. Failure is handled (only once) just outside the try..catch.
                 if (result) {
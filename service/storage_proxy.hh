@@ -326,6 +326,14 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             dht::partition_range_vector&& partition_ranges,
             db::consistency_level cl,
             coordinator_query_options optional_params);
+    // Reads the partitions of `executors`, each of which needs only the data of
+    // `replica`, with a single request. Returns the results in the order of
+    // `executors`, or an empty vector if the request failed or the replica
+    // didn't respond within the speculative retry delay of the partitions.
+    future<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>> query_singular_grouped(lw_shared_ptr<query::read_command> cmd,
+            locator::effective_replication_map_ptr erm, locator::host_id replica,
+            std::vector<::shared_ptr<abstract_read_executor>> executors,
+            tracing::trace_state_ptr trace_state, clock_type::time_point timeout);
     response_id_type register_response_handler(shared_ptr<abstract_write_response_handler>&& h);
     void remove_response_handler(response_id_type id);
     void remove_response_handler_entry(response_handlers_map::iterator entry);
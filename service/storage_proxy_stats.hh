@@ -113,6 +113,8 @@ struct write_stats {
     uint64_t cas_prune = 0;
     uint64_t cas_coordinator_dropped_prune = 0;
     uint64_t cas_replica_dropped_prune = 0;
+    uint64_t cas_replica_state_cache_hits = 0;
+    uint64_t cas_replica_state_cache_misses = 0;
 
     seastar::metrics::metric_groups _metrics;
 
@@ -162,6 +164,15 @@ struct stats : public write_stats {
 
     uint64_t replica_cross_shard_ops = 0;
 
+    // number of MUTATION_BATCH messages sent as a coordinator,
+    // the writes they carried and the distribution of their sizes
+    uint64_t mutation_batches_sent = 0;
+    uint64_t batched_mutations_sent = 0;
+    utils::estimated_histogram mutation_batch_size;
+
+    // number of MUTATION_BATCH messages received as a replica
+    uint64_t received_mutation_batches = 0;
+
     utils::timed_rate_moving_average_summary_and_histogram read;
     utils::timed_rate_moving_average_summary_and_histogram range;
 
@@ -171,6 +182,8 @@ struct stats : public write_stats {
     uint64_t read_retries = 0; // read is retried with new limit
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
+    uint64_t grouped_read_requests = 0; // READ_DATA_MULTI requests sent
+    uint64_t grouped_partition_reads = 0; // partitions read with READ_DATA_MULTI requests
 
     uint64_t cas_read_unfinished_commit = 0;
     uint64_t cas_foreground = 0;
@@ -26,6 +26,7 @@ enum class component_type {
     TemporaryTOC,
     TemporaryStatistics,
     Scylla,
+    ValueIndex,
     Unknown,
 };
 
@@ -63,6 +64,8 @@ struct fmt::formatter<sstables::component_type> : fmt::formatter<string_view> {
             return formatter<string_view>::format("TemporaryStatistics", ctx);
         case Scylla:
             return formatter<string_view>::format("Scylla", ctx);
+        case ValueIndex:
+            return formatter<string_view>::format("ValueIndex", ctx);
         case Unknown:
             return formatter<string_view>::format("Unknown", ctx);
         }
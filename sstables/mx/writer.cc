@@ -19,7 +19,9 @@
 #include "utils/assert.hh"
 #include "utils/exceptions.hh"
 #include "db/large_data_handler.hh"
+#include "db/sstable_value_index_extension.hh"
 
+#include <algorithm>
 #include <functional>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/container/static_vector.hpp>
@@ -600,8 +602,25 @@ class writer : public sstable_writer::writer_impl {
     large_data_stats_entry _row_size_entry;
     large_data_stats_entry _cell_size_entry;
     large_data_stats_entry _elements_in_collection_entry;
+    // Sstables from which partitions were copied with consume_raw_partition().
+    std::vector<generation_type> _raw_copy_sources;
+
+    // Builds the ValueIndex component of tables with an sstable_value_index
+    // option, see value_index. The block of each partition is written when
+    // the partition ends, the directory at the end of the stream.
+    std::unique_ptr<file_writer> _value_index_writer;
+    std::vector<const column_definition*> _value_index_columns;
+    value_index _value_index;
+    value_index_block _value_index_block;
+    int64_t _value_index_raw_token = 0;
+    bool _value_index_overflow = false;
+    // Bounds the memory used by the block of a partition.
+    static constexpr size_t max_value_index_entries_per_partition = 64 * 1024;
 
     void init_file_writers();
+    void init_value_index();
+    void add_to_value_index(const clustering_row& cr);
+    void write_value_index_block();
 
     // Returns the closed writer
     std::unique_ptr<file_writer> close_writer(std::unique_ptr<file_writer>& w);
@@ -801,6 +820,9 @@ class writer : public sstable_writer::writer_impl {
         _sst.create_data().get();
         _compression_enabled = !_sst.has_component(component_type::CRC);
         init_file_writers();
+        if (_sst.has_component(component_type::ValueIndex)) {
+            init_value_index();
+        }
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
@@ -819,6 +841,10 @@ class writer : public sstable_writer::writer_impl {
     stop_iteration consume(range_tombstone_change&& rtc) override;
     stop_iteration consume_end_of_partition() override;
     void consume_end_of_stream() override;
+    bool can_copy_raw_partitions_from(const sstable& source) const override;
+    stop_iteration consume_raw_partition(const dht::decorated_key& dk, const sstable& source, temporary_buffer<char> data) override;
+private:
+    void merge_raw_copy_source_stats(const sstable& source);
 };
 
 writer::~writer() {
@@ -833,6 +859,7 @@ writer::~writer() {
     };
     close_writer(_index_writer);
     close_writer(_data_writer);
+    close_writer(_value_index_writer);
 }
 
 void writer::maybe_set_pi_first_clustering(const writer::clustering_info& info) {
@@ -899,6 +926,60 @@ void writer::init_file_writers() {
     _index_writer = std::make_unique<file_writer>(output_stream<char>(std::move(out)), _sst.filename(component_type::Index));
 }
 
+void writer::init_value_index() {
+    file_output_stream_options options;
+    options.buffer_size = _sst.sstable_buffer_size;
+    _value_index_writer = std::make_unique<file_writer>(_sst.make_component_file_writer(component_type::ValueIndex, std::move(options)).get());
+    _value_index_columns = db::sstable_value_index_extension::indexed_columns(_schema);
+    for (const auto* cdef : _value_index_columns) {
+        _value_index.columns.elements.push_back(disk_string<uint16_t>{cdef->name()});
+    }
+}
+
+void writer::add_to_value_index(const clustering_row& cr) {
+    if (_value_index_overflow) {
+        return;
+    }
+    for (uint32_t i = 0; i < _value_index_columns.size(); ++i) {
+        const auto& cdef = *_value_index_columns[i];
+        const auto* cell = cr.cells().find_cell(cdef.id);
+        if (!cell) {
+            continue;
+        }
+        auto ac = cell->as_atomic_cell(cdef);
+        if (!ac.is_live()) {
+            continue;
+        }
+        if (_value_index_block.entries.elements.size() == max_value_index_entries_per_partition) {
+            _value_index_overflow = true;
+            _value_index_block.entries.elements.clear();
+            return;
+        }
+        _value_index_block.entries.elements.push_back(value_index_entry{
+            .column = i,
+            .value_hash = value_index::hash_value(ac.value()),
+            .clustering_key = disk_string<uint32_t>{to_bytes(cr.key().representation())},
+        });
+    }
+}
+
+void writer::write_value_index_block() {
+    if (!_value_index_overflow && _value_index_block.entries.elements.empty()) {
+        return;
+    }
+    _value_index.partitions.elements.push_back(value_index_partition{
+        .raw_token = _value_index_raw_token,
+        .key = disk_string<uint16_t>{to_bytes(bytes_view(*_partition_key))},
+        .overflow = _value_index_overflow,
+        .block_offset = _value_index_writer->offset(),
+    });
+    if (!_value_index_overflow) {
+        write(_sst.get_version(), *_value_index_writer, _value_index_block);
+    }
+    _value_index_block.entries.elements.clear();
+    _value_index_overflow = false;
+}
+
 std::unique_ptr<file_writer> writer::close_writer(std::unique_ptr<file_writer>& w) {
     auto writer = std::move(w);
     writer->close();
@@ -952,6 +1033,7 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
 
     _tombstone_written = false;
     _static_row_written = false;
+    _value_index_raw_token = dk.token().raw();
 }
 
 void writer::consume(tombstone t) {
@@ -1314,6 +1396,9 @@ stop_iteration writer::consume(clustering_row&& cr) {
     ensure_tombstone_is_written();
     ensure_static_row_is_written_if_needed();
     write_clustered(cr);
+    if (_value_index_writer) {
+        add_to_value_index(cr);
+    }
 
     auto can_split_partition_at_clustering_boundary = [this] {
         // will allow size limit to be exceeded for 10%, so we won't perform unnecessary split
@@ -1460,6 +1545,10 @@ stop_iteration writer::consume_end_of_partition() {
 
     maybe_record_large_partitions(_sst, *_partition_key, _c_stats.partition_size, _c_stats.rows_count, _c_stats.range_tombstones_count, _c_stats.dead_rows_count);
 
+    if (_value_index_writer) {
+        write_value_index_block();
+    }
+
     // update is about merging column_stats with the data being stored by collector.
     _collector.update(std::move(_c_stats));
     _c_stats.reset();
@@ -1472,6 +1561,122 @@ stop_iteration writer::consume_end_of_partition() {
     return get_data_offset() < _cfg.max_sstable_size ? stop_iteration::no : stop_iteration::yes;
 }
 
+static bool same_serialized_columns(const serialization_header& a, const serialization_header& b) {
+    auto same_names = [] (const bytes_array_vint_size& a, const bytes_array_vint_size& b) {
+        return a.value == b.value;
+    };
+    auto same_columns = [] (const serialization_header::column_desc& a, const serialization_header::column_desc& b) {
+        return a.name.value == b.name.value && a.type_name.value == b.type_name.value;
+    };
+    return a.pk_type_name.value == b.pk_type_name.value
+        && std::ranges::equal(a.clustering_key_types_names.elements, b.clustering_key_types_names.elements, same_names)
+        && std::ranges::equal(a.static_columns.elements, b.static_columns.elements, same_columns)
+        && std::ranges::equal(a.regular_columns.elements, b.regular_columns.elements, same_columns);
+}
+
+bool writer::can_copy_raw_partitions_from(const sstable& source) const {
+    // The reader interprets the data according to the version and the features
+    // of the sstable, so the copied bytes must mean the same thing in both.
+    if (source.get_version() != _sst.get_version() || _write_regular_as_static) {
+        return false;
+    }
+    // Copied partitions are not parsed, so their rows couldn't be indexed.
+    if (_value_index_writer) {
+        return false;
+    }
+    auto source_features = source.features().enabled_features;
+    if ((source_features & _features.enabled_features) != _features.enabled_features) {
+        return false;
+    }
+    // Cells of dropped columns are only skipped when read, so copying them
+    // would keep them past the compaction.
+    const auto& stats = source.get_stats_metadata();
+    for (const auto& [name, dropped] : _schema.dropped_columns()) {
+        if (dropped.timestamp >= stats.min_timestamp) {
+            return false;
+        }
+    }
+    // Cells are delta-encoded against the minimal values of the serialization header.
+    // An sstable without tombstones and expiring cells has no local deletion
+    // times and TTLs in its data, so only the timestamp base has to match.
+    // Live cells and row markers are recorded with the maximal local deletion
+    // time, so only a maximal minimum tells that there are no deletion times.
+    const auto& header = source.get_serialization_header();
+    const auto& own_header = _sst_schema.header;
+    if (header.min_timestamp_base.value != own_header.min_timestamp_base.value) {
+        return false;
+    }
+    bool has_deletion_times = !source.has_correct_max_deletion_time()
+            || stats.min_local_deletion_time != std::numeric_limits<int32_t>::max();
+    if (has_deletion_times && (header.min_local_deletion_time_base.value != own_header.min_local_deletion_time_base.value
+            || header.min_ttl_base.value != own_header.min_ttl_base.value)) {
+        return false;
+    }
+    return same_serialized_columns(header, own_header);
+}
+
+// The statistics of a copied partition are not known, so the ones of the whole
+// source sstable are merged instead, which is conservative.
+void writer::merge_raw_copy_source_stats(const sstable& source) {
+    if (std::ranges::find(_raw_copy_sources, source.generation()) != _raw_copy_sources.end()) {
+        return;
+    }
+    _raw_copy_sources.push_back(source.generation());
+
+    auto& stats = source.get_stats_metadata();
+    column_stats c_stats;
+    c_stats.timestamp_tracker.update(stats.min_timestamp);
+    c_stats.timestamp_tracker.update(stats.max_timestamp);
+    auto ext_stats = source.get_ext_timestamp_stats();
+    auto min_live_timestamp = [&] (ext_timestamp_stats_type type) {
+        auto it = ext_stats.find(type);
+        return it != ext_stats.end() ? it->second : stats.min_timestamp;
+    };
+    c_stats.min_live_timestamp_tracker.update(min_live_timestamp(ext_timestamp_stats_type::min_live_timestamp));
+    c_stats.min_live_row_marker_timestamp_tracker.update(min_live_timestamp(ext_timestamp_stats_type::min_live_row_marker_timestamp));
+    c_stats.local_deletion_time_tracker.update(stats.min_local_deletion_time);
+    c_stats.local_deletion_time_tracker.update(stats.max_local_deletion_time);
+    c_stats.ttl_tracker.update(stats.min_ttl);
+    c_stats.ttl_tracker.update(stats.max_ttl);
+    c_stats.tombstone_histogram = stats.estimated_tombstone_drop_time;
+    c_stats.has_legacy_counter_shards = stats.has_legacy_counter_shards;
+    _collector.update(std::move(c_stats));
+
+    _collector.update_min_max_components(source.min_position());
+    _collector.update_min_max_components(source.max_position());
+}
+
+stop_iteration writer::consume_raw_partition(const dht::decorated_key& dk, const sstable& source, temporary_buffer<char> data) {
+    merge_raw_copy_source_stats(source);
+
+    _partition_key = key::from_partition_key(_schema, dk.key());
+    maybe_add_summary_entry(dk.token(), bytes_view(*_partition_key));
+
+    _sst._components->filter->add(bytes_view(*_partition_key));
+    _collector.add_key(bytes_view(*_partition_key));
+    _num_partitions_consumed++;
+
+    auto p_key = disk_string_view<uint16_t>();
+    p_key.value = bytes_view(*_partition_key);
+    write(_sst.get_version(), *_index_writer, p_key);
+    write_vint(*_index_writer, _data_writer->offset());
+    // Copied partitions have no promoted index.
+    write_vint(*_index_writer, uint64_t(0));
+
+    _data_writer->write(data.get(), data.size());
+    _collector.add_partition_size(data.size());
+    // Copied partitions are below all large data thresholds, see
+    // compaction::setup_raw_partition_copier(), so only the maximum is tracked.
+    _partition_size_entry.max_value = std::max(_partition_size_entry.max_value, uint64_t(data.size()));
+
+    if (!_first_key) {
+        _first_key = *_partition_key;
+    }
+    _last_key = std::move(*_partition_key);
+    _partition_key = std::nullopt;
+    return get_data_offset() < _cfg.max_sstable_size ? stop_iteration::no : stop_iteration::yes;
+}
+
 void writer::consume_end_of_stream() {
     _cfg.monitor->on_data_write_completed();
 
@@ -1492,6 +1697,14 @@ void writer::consume_end_of_stream() {
     _sst.write_summary();
     _sst.maybe_rebuild_filter_from_index(_num_partitions_consumed);
     _sst.write_filter();
+    if (_value_index_writer) {
+        uint64_t directory_offset = _value_index_writer->offset();
+        write(_sst.get_version(), *_value_index_writer, _value_index);
+        write(_sst.get_version(), *_value_index_writer, directory_offset);
+        _sst._metadata_size_on_disk += _value_index_writer->offset();
+        close_writer(_value_index_writer);
+        _sst._components->value_index = std::move(_value_index);
+    }
     _sst.write_statistics();
     _sst.write_compression();
     run_identifier identifier{_run_identifier};
@@ -26,6 +26,7 @@ struct shareable_components {
     std::optional<sstables::scylla_metadata> scylla_metadata;
     weak_ptr<sstables::checksum> checksum;
     std::optional<uint32_t> digest;
+    std::optional<sstables::value_index> value_index;
 };
 
 }   // namespace sstables
@@ -972,6 +972,9 @@ sstable_set_impl::create_single_key_sstable_reader(
         readers.push_back(make_mutation_reader_from_mutations_v2(schema, permit, mutation(schema, *pos.key()), slice, fwd));
     }
     sstable_histogram.add(num_readers);
+    auto& stats = cf->get_stats();
+    stats.sstable_reads_rate.mark();
+    stats.sstables_read_rate.mark(num_readers);
     return make_combined_reader(schema, std::move(permit), std::move(readers), fwd, fwd_mr);
 }
 
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <seastar/core/smp.hh>
+#include <seastar/core/temporary_buffer.hh>
 #include "schema/schema_fwd.hh"
 #include "mutation/mutation_fragment.hh"
 #include "mutation/mutation_fragment_v2.hh"
@@ -43,6 +44,17 @@ class sstable_writer {
     stop_iteration consume(range_tombstone_change&& rtc);
     stop_iteration consume_end_of_partition();
     void consume_end_of_stream();
+
+    // Returns true if the partitions serialized in the data file of source can
+    // be copied into this sstable as they are, i.e. both sstables use the same
+    // format and serialization header.
+    bool can_copy_raw_partitions_from(const sstable& source) const;
+    // Appends a whole partition whose serialized bytes were read from the data
+    // file of source, which must satisfy can_copy_raw_partitions_from().
+    // Only partitions without a promoted index can be copied this way.
+    // Returns stop_iteration::yes when the sstable reached its maximum size,
+    // like consume_end_of_partition().
+    stop_iteration consume_raw_partition(const dht::decorated_key& dk, const sstable& source, temporary_buffer<char> data);
 };
 
 } // namespace sstables
@@ -61,10 +61,12 @@
 #include "utils/stall_free.hh"
 #include "checked-file-impl.hh"
 #include "db/extensions.hh"
+#include "db/sstable_value_index_extension.hh"
 #include "sstables/partition_index_cache.hh"
 #include "db/large_data_handler.hh"
 #include "db/config.hh"
 #include "sstables/random_access_reader.hh"
+#include "utils/xx_hasher.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/partition_index_cache.hh"
 #include "utils/UUID_gen.hh"
@@ -867,6 +869,9 @@ void sstable::generate_toc() {
         _recognized_components.insert(component_type::CompressionInfo);
     }
     _recognized_components.insert(component_type::Scylla);
+    if (!db::sstable_value_index_extension::indexed_columns(*_schema).empty()) {
+        _recognized_components.insert(component_type::ValueIndex);
+    }
 }
 
 future<std::unordered_map<component_type, file>> sstable::readable_file_for_all_components() const {
@@ -1432,6 +1437,107 @@ future<> sstable::read_filter(sstable_open_config cfg) {
     });
 }
 
+uint64_t value_index::hash_value(managed_bytes_view value) {
+    xx_hasher h;
+    for (bytes_view fragment : fragment_range(value)) {
+        h.update(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+    }
+    return h.finalize_uint64();
+}
+
+future<> sstable::read_value_index() {
+    if (!has_component(component_type::ValueIndex)) {
+        return make_ready_future<>();
+    }
+
+    return do_read_simple(component_type::ValueIndex, [this] (version_types v, file&& f, uint64_t size) -> future<> {
+        if (size < sizeof(uint64_t)) {
+            throw malformed_sstable_exception(format("ValueIndex component too short: {} bytes", size));
+        }
+        std::exception_ptr ex;
+        auto r = file_random_access_reader(std::move(f), size, sstable_buffer_size);
+        try {
+            co_await r.seek(size - sizeof(uint64_t));
+            uint64_t directory_offset;
+            co_await parse(*_schema, v, r, directory_offset);
+            co_await r.seek(directory_offset);
+            value_index index;
+            co_await parse(*_schema, v, r, index);
+            _components->value_index = std::move(index);
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await r.close();
+
+        maybe_rethrow_exception(std::move(ex));
+    });
+}
+
+future<std::optional<std::vector<clustering_key_prefix>>>
+sstable::find_value_index_rows(const dht::decorated_key& dk, const column_definition& column, managed_bytes_view value) const {
+    const auto value_hash = value_index::hash_value(value);
+    if (!_components->value_index) {
+        co_return std::nullopt;
+    }
+    const auto& index = *_components->value_index;
+    auto col = std::ranges::find_if(index.columns.elements, [&] (const disk_string<uint16_t>& name) {
+        return name.value == column.name();
+    });
+    if (col == index.columns.elements.end()) {
+        co_return std::nullopt;
+    }
+    const uint32_t column_pos = col - index.columns.elements.begin();
+
+    const auto raw_token = dk.token().raw();
+    auto& partitions = index.partitions.elements;
+    auto it = std::ranges::lower_bound(partitions, raw_token, std::less<>(), std::mem_fn(&value_index_partition::raw_token));
+    for (; it != partitions.end() && it->raw_token == raw_token; ++it) {
+        if (key_view(it->key.value).to_partition_key(*_schema).equal(*_schema, dk.key())) {
+            break;
+        }
+    }
+    std::vector<clustering_key_prefix> rows;
+    if (it == partitions.end() || it->raw_token != raw_token) {
+        co_return rows;
+    }
+    if (it->overflow) {
+        co_return std::nullopt;
+    }
+    // The directory may be reclaimed while the block is read.
+    const auto block_offset = it->block_offset;
+
+    // The file is opened once and kept open until the sstable is closed,
+    // each lookup reads through its own handle to it.
+    if (!_value_index_file) {
+        auto f = co_await new_sstable_component_file(_read_error_handler, component_type::ValueIndex, open_flags::ro);
+        if (!_value_index_file) {
+            _value_index_file = std::move(f);
+        } else {
+            co_await f.close();
+        }
+    }
+    auto f = make_checked_file(_read_error_handler, _value_index_file.dup().to_file());
+    auto size = co_await f.size();
+    std::exception_ptr ex;
+    auto r = file_random_access_reader(std::move(f), size, sstable_buffer_size);
+    try {
+        co_await r.seek(block_offset);
+        value_index_block block;
+        co_await parse(*_schema, _version, r, block);
+        for (const auto& e : block.entries.elements) {
+            if (e.column == column_pos && e.value_hash == value_hash) {
+                rows.push_back(clustering_key_prefix::from_bytes(bytes_view(e.clustering_key.value)));
+            }
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await r.close();
+    maybe_rethrow_exception(std::move(ex));
+
+    co_return rows;
+}
+
 void sstable::write_filter() {
     if (!has_component(component_type::Filter)) {
         return;
@@ -1511,7 +1617,8 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
 
 size_t sstable::total_reclaimable_memory_size() const {
     if (!_total_reclaimable_memory) {
-        _total_reclaimable_memory = _components->filter ? _components->filter->memory_size() : 0;
+        _total_reclaimable_memory = (_components->filter ? _components->filter->memory_size() : 0)
+                + (_components->value_index ? _components->value_index->memory_footprint() : 0);
     }
 
     return _total_reclaimable_memory.value();
@@ -1530,6 +1637,12 @@ size_t sstable::reclaim_memory_from_components() {
         }
     }
 
+    if (_components->value_index) {
+        // Lookups of a reclaimed directory don't narrow reads.
+        memory_reclaimed_this_iteration += _components->value_index->memory_footprint();
+        _components->value_index.reset();
+    }
+
     _total_reclaimable_memory.reset();
     _total_memory_reclaimed += memory_reclaimed_this_iteration;
     return memory_reclaimed_this_iteration;
@@ -1548,8 +1661,11 @@ future<> sstable::reload_reclaimed_components() {
     co_await utils::get_local_injector().inject("reload_reclaimed_components/pause", utils::wait_for_message(std::chrono::seconds(5)));
 
     co_await read_filter();
+    if (!_components->value_index) {
+        co_await read_value_index();
+    }
     _total_reclaimable_memory.reset();
-    _total_memory_reclaimed -= _components->filter->memory_size();
+    _total_memory_reclaimed -= std::min(_total_memory_reclaimed, total_reclaimable_memory_size());
     sstlog.info("Reloaded bloom filter of {}", get_filename());
 }
 
@@ -1573,7 +1689,8 @@ future<> sstable::load_metadata(sstable_open_config cfg, bool validate) noexcept
     co_await coroutine::all(
             [&] { return read_compression(); },
             [&] { return read_filter(cfg); },
-            [&] { return read_summary(); });
+            [&] { return read_summary(); },
+            [&] { return read_value_index(); });
     if (validate) {
         validate_min_max_metadata();
         validate_max_local_deletion_time();
@@ -2820,6 +2937,13 @@ future<> sstable::close_files() {
             general_disk_error();
         });
     }
+    auto value_index_closed = make_ready_future<>();
+    if (_value_index_file) {
+        value_index_closed = _value_index_file.close().handle_exception([me = shared_from_this()] (auto ep) {
+            sstlog.warn("sstable close value index file failed: {}", ep);
+            general_disk_error();
+        });
+    }
     auto data_closed = make_ready_future<>();
     if (_data_file) {
         data_closed = _data_file.close().handle_exception([me = shared_from_this()] (auto ep) {
@@ -2851,7 +2975,7 @@ future<> sstable::close_files() {
 
     _on_closed(*this);
 
-    return when_all_succeed(std::move(index_closed), std::move(data_closed), std::move(unlinked)).discard_result().then([this, me = shared_from_this()] {
+    return when_all_succeed(std::move(index_closed), std::move(value_index_closed), std::move(data_closed), std::move(unlinked)).discard_result().then([this, me = shared_from_this()] {
         if (_open_mode) {
             if (_open_mode.value() == open_flags::ro) {
                 _stats.on_close_for_reading();
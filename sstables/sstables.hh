@@ -380,6 +380,14 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return _components->filter->memory_size();
     }
 
+    // Finds the clustering keys of the rows of partition `dk` which may hold
+    // a live `column` cell equal to `value`, using the ValueIndex component.
+    // Returns std::nullopt when the component can't tell: the sstable has
+    // none, its directory was reclaimed from memory, the column isn't
+    // indexed in it, or the partition overflowed.
+    future<std::optional<std::vector<clustering_key_prefix>>>
+    find_value_index_rows(const dht::decorated_key& dk, const column_definition& column, managed_bytes_view value) const;
+
     version_types get_version() const {
         return _version;
     }
@@ -536,6 +544,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     file _index_file;
     seastar::shared_ptr<cached_file> _cached_index_file;
     file _data_file;
+    // Opened by the first find_value_index_rows(), see there.
+    mutable file _value_index_file;
     uint64_t _data_file_size;
     uint64_t _index_file_size;
     // on-disk size of components but data and index.
@@ -655,6 +665,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> read_filter(sstable_open_config cfg = {});
 
+    future<> read_value_index();
+
     void write_filter();
     // Rebuild a bloom filter from the index with the given number of
     // partitions, if the partition estimate provided during bloom
@@ -12,6 +12,7 @@
 #include <seastar/core/enum.hh>
 #include <seastar/core/weak_ptr.hh>
 #include "bytes.hh"
+#include "utils/managed_bytes.hh"
 #include "gc_clock.hh"
 #include "locator/host_id.hh"
 #include "mutation/tombstone.hh"
@@ -108,6 +109,65 @@ struct filter_ref {
     explicit filter_ref(int hashes, const utils::chunked_vector<uint64_t>& buckets) : hashes(hashes), buckets(buckets) {}
 };
 
+// The ValueIndex component maps the values of the columns listed in the
+// table's sstable_value_index option to the rows holding them, per partition.
+// It consists of one block of entries per partition, followed by the
+// value_index directory and the offset of the latter (an uint64_t).
+//
+// Values are stored as hashes, so a lookup may return rows holding another
+// value, but it never misses a row holding a live cell with the looked up one.
+struct value_index_entry {
+    uint32_t column; // position in value_index::columns
+    uint64_t value_hash;
+    disk_string<uint32_t> clustering_key;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(column, value_hash, clustering_key); }
+};
+
+struct value_index_block {
+    disk_array<uint32_t, value_index_entry> entries;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(entries); }
+};
+
+struct value_index_partition {
+    int64_t raw_token;
+    disk_string<uint16_t> key;
+    // Partitions with more indexed cells than the writer is willing to
+    // keep have no block, so reads of them can't be narrowed.
+    bool overflow;
+    uint64_t block_offset;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(raw_token, key, overflow, block_offset); }
+};
+
+// The directory of the component, kept in memory. Partitions without any
+// indexed cell are absent, the others are in ring order. It is reclaimable
+// like the bloom filter, and reads aren't narrowed when it's reclaimed.
+struct value_index {
+    disk_array<uint32_t, disk_string<uint16_t>> columns;
+    disk_array<uint32_t, value_index_partition> partitions;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(columns, partitions); }
+
+    static uint64_t hash_value(managed_bytes_view value);
+
+    uint64_t memory_footprint() const {
+        auto sz = sizeof(*this) + sizeof(value_index_partition) * partitions.elements.size();
+        for (auto& c : columns.elements) {
+            sz += sizeof(c) + c.value.size();
+        }
+        for (auto& p : partitions.elements) {
+            sz += p.key.value.size();
+        }
+        return sz;
+    }
+};
+
 enum class indexable_element {
     partition,
     cell
@@ -73,6 +73,18 @@ void sstable_writer::consume_end_of_stream() {
     return _impl->consume_end_of_stream();
 }
 
+bool sstable_writer::can_copy_raw_partitions_from(const sstable& source) const {
+    return _impl->can_copy_raw_partitions_from(source);
+}
+
+stop_iteration sstable_writer::consume_raw_partition(const dht::decorated_key& dk, const sstable& source, temporary_buffer<char> data) {
+    _impl->_validator(dk);
+    _impl->_validator(mutation_fragment_v2::kind::partition_start, position_in_partition_view::for_partition_start(), {});
+    _impl->_validator.on_end_of_partition();
+    _impl->_sst.get_stats().on_partition_write();
+    return _impl->consume_raw_partition(dk, source, std::move(data));
+}
+
 sstable_writer::sstable_writer(sstable_writer&& o) = default;
 sstable_writer& sstable_writer::operator=(sstable_writer&& o) = default;
 sstable_writer::~sstable_writer() {
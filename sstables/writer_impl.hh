@@ -47,6 +47,8 @@ struct sstable_writer::writer_impl {
     virtual stop_iteration consume(range_tombstone_change&& rtc) = 0;
     virtual stop_iteration consume_end_of_partition() = 0;
     virtual void consume_end_of_stream() = 0;
+    virtual bool can_copy_raw_partitions_from(const sstable& source) const = 0;
+    virtual stop_iteration consume_raw_partition(const dht::decorated_key& dk, const sstable& source, temporary_buffer<char> data) = 0;
     virtual ~writer_impl() {}
 };
 
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <algorithm>
+#include <ranges>
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include "backlog_controller.hh"
+#include "test/lib/backlog_controller_simulation.hh"
+
+static constexpr float interval = 0.25;
+static constexpr float drain_rate = 1.0;
+static constexpr float target = 0.3;
+static constexpr pid_gains gains{.kp = 1.0, .ki = 0.1, .kd = 0.05};
+
+// Backlog grows at 0.2 per second, i.e. the process has to run at 20% of
+// its full speed to keep up.
+static constexpr float sustained_growth = 0.2 * interval;
+
+SEASTAR_THREAD_TEST_CASE(test_pid_controller_settles_at_target) {
+    auto steps = tests::simulate_backlog_controller(std::vector<float>(2000, sustained_growth), target, interval, drain_rate, gains);
+    for (auto& step : steps | std::views::drop(1000)) {
+        BOOST_REQUIRE_CLOSE(step.backlog, target, 1);
+        BOOST_REQUIRE_CLOSE(step.output, sustained_growth / (drain_rate * interval), 1);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_pid_controller_absorbs_burst) {
+    std::vector<float> incoming(4000, sustained_growth);
+    incoming[2000] += 0.5;
+    auto steps = tests::simulate_backlog_controller(incoming, target, interval, drain_rate, gains);
+    auto before = steps[1999].output;
+    auto after_burst = steps | std::views::drop(2000);
+    // The burst is consumed with extra output, without saturating it...
+    BOOST_REQUIRE(std::ranges::all_of(after_burst, [&] (auto& step) { return step.output < 1; }));
+    BOOST_REQUIRE_GT(steps[2000].output, before);
+    // ... and the controller goes back to where it was before the burst.
+    for (auto& step : after_burst | std::views::drop(1000)) {
+        BOOST_REQUIRE_CLOSE(step.backlog, target, 1);
+        BOOST_REQUIRE_CLOSE(step.output, before, 1);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_pid_controller_anti_windup) {
+    // Backlog grows faster than it can be consumed for a while, so the output
+    // stays saturated until the growth slows down and the backlog is consumed.
+    std::vector<float> incoming(400, 2 * drain_rate * interval);
+    incoming.resize(4000, sustained_growth);
+    auto steps = tests::simulate_backlog_controller(incoming, target, interval, drain_rate, gains);
+    BOOST_REQUIRE_EQUAL(steps[399].output, 1);
+    // Without anti-windup, the integral accumulated while saturated would
+    // drive the backlog well below the target once it is consumed.
+    auto after = steps | std::views::drop(400);
+    auto lowest = std::ranges::min(after | std::views::transform(&tests::backlog_simulation_step::backlog));
+    BOOST_REQUIRE_GT(lowest, target * 0.9);
+    BOOST_REQUIRE_CLOSE(steps.back().backlog, target, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_pid_controller_state) {
+    pid_controller pid;
+    pid.update(0.5, target, interval, gains);
+    BOOST_REQUIRE_CLOSE(pid.error(), 0.5 - target, 0.1);
+    BOOST_REQUIRE_CLOSE(pid.proportional(), gains.kp * (0.5 - target), 0.1);
+    BOOST_REQUIRE_CLOSE(pid.integral(), gains.ki * (0.5 - target) * interval, 0.1);
+    // There is no derivative until there is a previous measurement.
+    BOOST_REQUIRE_EQUAL(pid.derivative(), 0);
+    pid.update(0.6, target, interval, gains);
+    BOOST_REQUIRE_GT(pid.derivative(), 0);
+    BOOST_REQUIRE_CLOSE(pid.output(), pid.proportional() + pid.integral() + pid.derivative(), 0.1);
+
+    pid.reset();
+    BOOST_REQUIRE_EQUAL(pid.output(), 0);
+    BOOST_REQUIRE_EQUAL(pid.integral(), 0);
+    pid.update(0, target, interval, gains);
+    // A backlog below the target can't produce a negative output.
+    BOOST_REQUIRE_EQUAL(pid.output(), 0);
+}
@@ -127,6 +127,9 @@ class single_compaction_group : public compaction::table_state {
     virtual const std::string get_group_id() const noexcept override { return "0"; }
     virtual seastar::condition_variable& get_staging_done_condition() noexcept override { return _staging_done_condition; }
     dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override { return dht::token_range(); }
+    double sstables_per_read() const noexcept override { return 0; }
+    double read_rate() const noexcept override { return 0; }
+    double tombstones_per_read() const noexcept override { return 0; }
 };
 
 SEASTAR_TEST_CASE(basic_compaction_group_splitting_test) {
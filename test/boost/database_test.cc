@@ -1305,6 +1305,46 @@ SEASTAR_TEST_CASE(upgrade_sstables) {
     });
 }
 
+// Upgrades started with a maintenance batch run in the batch's slot,
+// while other maintenance operations wait for the batch to be released.
+SEASTAR_TEST_CASE(upgrade_sstables_in_maintenance_batch) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf1 (k int, v int, primary key (k));").get();
+        e.execute_cql("create table ks.cf2 (k int, v int, primary key (k));").get();
+        for (int i = 0; i < 100; ++i) {
+            e.execute_cql(format("insert into ks.cf1 (k, v) values ({}, {});", i, i)).get();
+            e.execute_cql(format("insert into ks.cf2 (k, v) values ({}, {});", i, i)).get();
+        }
+        auto& db = e.local_db();
+        db.flush_all_memtables().get();
+
+        auto& cm = db.get_compaction_manager();
+        auto& cf1 = db.find_column_family("ks", "cf1");
+        auto& cf2 = db.find_column_family("ks", "cf2");
+        BOOST_REQUIRE(!cf1.get_sstables()->empty());
+        BOOST_REQUIRE(!cf2.get_sstables()->empty());
+        auto cf1_sstables = *cf1.get_sstables();
+
+        auto upgrade = [&cm] (replica::table& t, compaction::maintenance_batch_ptr batch) {
+            return t.parallel_foreach_table_state([&cm, batch] (compaction::table_state& ts) {
+                constexpr bool exclude_current_version = false;
+                return cm.perform_sstable_upgrade(nullptr, ts, exclude_current_version, tasks::task_info{}, batch);
+            });
+        };
+
+        auto batch = cm.start_maintenance_batch().get();
+        auto cf2_upgrade = upgrade(cf2, {});
+        upgrade(cf1, batch).get();
+        for (auto& sst : *cf1.get_sstables()) {
+            BOOST_REQUIRE(!cf1_sstables.contains(sst));
+        }
+        BOOST_REQUIRE(!cf2_upgrade.available());
+
+        batch = nullptr;
+        cf2_upgrade.get();
+    });
+}
+
 SEASTAR_THREAD_TEST_CASE(per_service_level_reader_concurrency_semaphore_test) {
     cql_test_config cfg;
     do_with_cql_env_thread([] (cql_test_env& e) {
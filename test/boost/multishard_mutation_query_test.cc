@@ -762,6 +762,35 @@ SEASTAR_THREAD_TEST_CASE(test_evict_a_shard_reader_on_each_page) {
     }, cql_config_with_extensions()).get();
 }
 
+// Check that the shard readers of range scans are admitted as expensive
+// reads, like the range scans going through database::query().
+SEASTAR_THREAD_TEST_CASE(test_range_scan_cost_class) {
+    do_with_cql_env_thread([] (cql_test_env& env) -> future<> {
+        auto [s, pkeys] = create_test_table(env, KEYSPACE_NAME, get_name());
+
+        auto reads_admitted = [&env] (reader_permit::cost_class cost) {
+            return env.db().map_reduce0([cost] (replica::database& db) {
+                return do_with(uint64_t(0), [&db, cost] (uint64_t& admitted) {
+                    return db.foreach_reader_concurrency_semaphore([cost, &admitted] (reader_concurrency_semaphore& sem) {
+                        admitted += sem.get_stats().reads_admitted_by_cost_class[static_cast<size_t>(cost)];
+                        return make_ready_future<>();
+                    }).then([&admitted] {
+                        return admitted;
+                    });
+                });
+            }, uint64_t(0), std::plus<uint64_t>()).get();
+        };
+
+        const auto expensive_before = reads_admitted(reader_permit::cost_class::expensive);
+        auto [results, npages] = read_all_partitions_with_paged_scan(env.db(), s, 4, stateful_query::no, [] (size_t) { });
+        tests::require_equal(results.size(), pkeys.size());
+        // Each page reads from at least one shard with a new permit.
+        tests::require_greater_equal(reads_admitted(reader_permit::cost_class::expensive) - expensive_before, npages);
+
+        return make_ready_future<>();
+    }, cql_config_with_extensions()).get();
+}
+
 // Best run with SMP>=2
 SEASTAR_THREAD_TEST_CASE(test_read_reversed) {
     do_with_cql_env_thread([] (cql_test_env& env) -> future<> {
@@ -66,6 +66,7 @@
 #include "readers/filtering.hh"
 #include "readers/evictable.hh"
 #include "readers/queue.hh"
+#include "readers/pipelined.hh"
 
 BOOST_AUTO_TEST_SUITE(mutation_reader_test)
 
@@ -2668,6 +2669,45 @@ SEASTAR_THREAD_TEST_CASE(test_compacting_reader_next_partition) {
     reader_assertions.produces_end_of_stream();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_pipelined_reader) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto gen = random_mutation_generator(random_mutation_generator::generate_counters::no);
+    const auto muts = gen(20);
+
+    auto make_reader = [&] (size_t depth) {
+        auto underlying = make_mutation_reader_from_mutations_v2(gen.schema(), semaphore.make_permit(), muts);
+        underlying.set_max_buffer_size(1);
+        return make_pipelined_reader(std::move(underlying), depth);
+    };
+
+    for (size_t depth : {1, 2, 8}) {
+        testlog.info("depth={}", depth);
+
+        assert_that(make_reader(depth))
+            .produces(muts)
+            .produces_end_of_stream();
+
+        // Skip every other partition right after its partition start.
+        auto assertions = assert_that(make_reader(depth));
+        for (size_t i = 0; i < muts.size(); ++i) {
+            if (i % 2) {
+                assertions.produces(muts[i].decorated_key());
+            } else {
+                assertions.produces(muts[i]);
+            }
+        }
+        assertions.produces_end_of_stream();
+
+        // Closing the reader while the producer is still running.
+        {
+            auto reader = make_reader(depth);
+            auto close_reader = deferred_close(reader);
+            reader.fill_buffer().get();
+            BOOST_REQUIRE(!reader.is_buffer_empty());
+        }
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_compacting_reader_is_consistent_with_compaction) {
     simple_schema ss;
     schema_ptr s = ss.schema();
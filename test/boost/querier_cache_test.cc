@@ -216,8 +216,8 @@ class test_querier_cache {
         return _s.schema()->full_slice();
     }
 
-    template <typename Querier>
-    entry_info produce_first_page_and_save_querier(void(query::querier_cache::*insert_mem_ptr)(query_id, Querier&&, tracing::trace_state_ptr), unsigned key,
+    template <typename Querier, typename InsertFn>
+    entry_info produce_first_page_and_save_querier(InsertFn insert_fn, unsigned key,
             const dht::partition_range& range, const query::partition_slice& slice, uint64_t row_limit) {
         const auto cache_key = make_cache_key(key);
 
@@ -226,8 +226,7 @@ class test_querier_cache {
         auto&& dk = dk_ck.first;
         auto&& ck = dk_ck.second;
         auto permit = querier.permit();
-        auto insert_fn = std::mem_fn(insert_mem_ptr);
-        insert_fn(_cache, cache_key, std::move(querier), nullptr);
+        std::invoke(insert_fn, _cache, cache_key, std::move(querier), nullptr);
 
         // Either no keys at all (nothing read) or at least partition key.
         BOOST_REQUIRE((dk && ck) || !ck);
@@ -289,6 +288,17 @@ class test_querier_cache {
         return produce_first_page_and_save_data_querier(1);
     }
 
+    entry_info produce_first_page_and_save_prefetched_data_querier(unsigned key) {
+        auto insert_fn = [] (query::querier_cache& cache, query_id key, query::querier&& q, tracing::trace_state_ptr trace_state) {
+            cache.insert_data_querier_with_prefetch(key, std::move(q), std::move(trace_state), utils::phased_barrier::operation());
+        };
+        return produce_first_page_and_save_querier<query::querier>(insert_fn, key, make_default_partition_range(), _s.schema()->full_slice(), 5);
+    }
+
+    void wait_for_prefetch(unsigned key) {
+        _cache.wait_for_prefetch(make_cache_key(key)).get();
+    }
+
     entry_info produce_first_page_and_save_mutation_querier(unsigned key, const dht::partition_range& range,
             const query::partition_slice& slice, uint64_t row_limit = 5) {
         return produce_first_page_and_save_querier<query::querier>(&query::querier_cache::insert_mutation_querier, key, range, slice, row_limit);
@@ -367,6 +377,12 @@ class test_querier_cache {
         return *this;
     }
 
+    test_querier_cache& prefetch_hits() {
+        BOOST_REQUIRE_EQUAL(_cache.get_stats().prefetches, ++_expected_stats.prefetches);
+        BOOST_REQUIRE_EQUAL(_cache.get_stats().prefetch_hits, ++_expected_stats.prefetch_hits);
+        return *this;
+    }
+
     test_querier_cache& no_evictions() {
         BOOST_REQUIRE_EQUAL(_cache.get_stats().time_based_evictions, _expected_stats.time_based_evictions);
         BOOST_REQUIRE_EQUAL(_cache.get_stats().resource_based_evictions, _expected_stats.resource_based_evictions);
@@ -396,6 +412,18 @@ SEASTAR_THREAD_TEST_CASE(lookup_with_wrong_key_misses) {
         .no_evictions();
 }
 
+SEASTAR_THREAD_TEST_CASE(lookup_prefetched_data_querier) {
+    test_querier_cache t;
+
+    const auto entry = t.produce_first_page_and_save_prefetched_data_querier(1);
+    t.wait_for_prefetch(1);
+    t.assert_cache_lookup_data_querier(entry.key, *t.get_schema(), entry.expected_range, entry.expected_slice)
+        .no_misses()
+        .no_drops()
+        .no_evictions()
+        .prefetch_hits();
+}
+
 SEASTAR_THREAD_TEST_CASE(lookup_data_querier_as_mutation_querier_misses) {
     test_querier_cache t;
 
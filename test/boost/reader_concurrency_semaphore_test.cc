@@ -2259,4 +2259,45 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_live_update_cpu_concu
     require_can_admit(true, "!need_cpu");
 }
 
+// Check that cheaper reads waiting for admission are preferred over
+// expensive ones, but the latter are not starved.
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_admission_by_cost_class) {
+    simple_schema s;
+    const auto schema = s.schema();
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 100 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+
+    reader_permit_opt permit = semaphore.obtain_permit(schema, get_name(), 1024, db::timeout_clock::now(), {}).get();
+
+    std::vector<sstring> admission_order;
+    std::vector<future<>> futures;
+    auto enqueue = [&] (sstring name, reader_permit::cost_class cost) {
+        futures.push_back(semaphore.obtain_permit(schema, get_name(), 1024, db::no_timeout, {}, cost).then([&admission_order, name] (reader_permit) {
+            admission_order.push_back(name);
+        }));
+    };
+    for (int i = 0; i < 4; ++i) {
+        enqueue(format("e{}", i), reader_permit::cost_class::expensive);
+    }
+    for (int i = 0; i < 4; ++i) {
+        enqueue(format("c{}", i), reader_permit::cost_class::cheap);
+    }
+
+    const auto& stats = semaphore.get_stats();
+    BOOST_REQUIRE_EQUAL(stats.waiters, 8);
+    BOOST_REQUIRE_EQUAL(stats.reads_waiting_for_admission_by_cost_class[static_cast<size_t>(reader_permit::cost_class::cheap)], 4);
+    BOOST_REQUIRE_EQUAL(stats.reads_waiting_for_admission_by_cost_class[static_cast<size_t>(reader_permit::cost_class::expensive)], 4);
+
+    permit = {};
+    when_all_succeed(futures.begin(), futures.end()).get();
+
+    testlog.info("admission order: {}", admission_order);
+    BOOST_REQUIRE(admission_order == std::vector<sstring>({"c0", "e0", "c1", "c2", "c3", "e1", "e2", "e3"}));
+    BOOST_REQUIRE_EQUAL(stats.reads_admitted_by_cost_class[static_cast<size_t>(reader_permit::cost_class::cheap)], 4);
+    BOOST_REQUIRE_EQUAL(stats.reads_admitted_by_cost_class[static_cast<size_t>(reader_permit::cost_class::normal)], 1);
+    BOOST_REQUIRE_EQUAL(stats.reads_admitted_by_cost_class[static_cast<size_t>(reader_permit::cost_class::expensive)], 4);
+    BOOST_REQUIRE_EQUAL(stats.reads_waiting_for_admission_by_cost_class[static_cast<size_t>(reader_permit::cost_class::cheap)], 0);
+    BOOST_REQUIRE_EQUAL(stats.reads_waiting_for_admission_by_cost_class[static_cast<size_t>(reader_permit::cost_class::expensive)], 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -50,6 +50,7 @@
 #include "test/lib/random_schema.hh"
 #include "mutation/mutation_compactor.hh"
 #include "db/config.hh"
+#include "db/system_keyspace.hh"
 #include "mutation_writer/partition_based_splitting_writer.hh"
 #include "compaction/table_state.hh"
 #include "mutation/mutation_rebuilder.hh"
@@ -62,6 +63,7 @@
 #include <boost/icl/interval_map.hpp>
 #include "test/lib/test_services.hh"
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/reader_concurrency_semaphore.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/random_utils.hh"
@@ -1963,6 +1965,98 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(unified_compaction_strategy_test) {
+  return test_env::do_with_async([] (test_env& env) {
+    // The test table enforces min_threshold, which is lowered so that the
+    // scaling parameters alone decide, except where it is tested explicitly.
+    auto cf = env.make_table_for_tests(schema_builder(table_for_tests::make_default_schema()).set_min_compaction_threshold(2).build());
+    auto stop_cf = deferred_stop(cf);
+
+    const auto keys = tests::generate_partition_keys(50, cf.schema());
+    const auto& min_key = keys.front();
+    const auto& max_key = keys.back();
+    constexpr uint64_t MB = 1024 * 1024;
+
+    auto make_ucs = [] (std::map<sstring, sstring> options = {}) {
+        return sstables::make_compaction_strategy(sstables::compaction_strategy_type::unified, options);
+    };
+    auto add_sstable = [&] (uint64_t size, const partition_key& first_key, const partition_key& last_key) {
+        return add_sstable_for_leveled_test(env, cf, size, /*level*/0, first_key, last_key);
+    };
+
+    std::vector<shared_sstable> flushed;
+    for (auto i = 0; i < 4; i++) {
+        flushed.push_back(add_sstable(10 * MB, min_key.key(), max_key.key()));
+    }
+    std::vector<shared_sstable> three_flushed(flushed.begin(), flushed.begin() + 3);
+    std::vector<shared_sstable> two_flushed(flushed.begin(), flushed.begin() + 2);
+
+    // A tiered level with a fanout of 4 waits for 4 overlapping sstables...
+    auto cs = make_ucs();
+    BOOST_REQUIRE(get_sstables_for_compaction(cs, cf.as_table_state(), three_flushed).sstables.empty());
+    BOOST_REQUIRE_EQUAL(get_sstables_for_compaction(cs, cf.as_table_state(), flushed).sstables.size(), 4);
+
+    // ...while a leveled one compacts any 2 of them.
+    cs = make_ucs({{"scaling_parameters", "L10"}});
+    BOOST_REQUIRE_EQUAL(get_sstables_for_compaction(cs, cf.as_table_state(), two_flushed).sstables.size(), 2);
+
+    // An enforced min_threshold holds back levels whose own threshold is lower.
+    {
+        auto strict_cf = env.make_table_for_tests(schema_builder(table_for_tests::make_default_schema()).set_min_compaction_threshold(3).build());
+        auto stop_strict_cf = deferred_stop(strict_cf);
+        BOOST_REQUIRE(get_sstables_for_compaction(cs, strict_cf.as_table_state(), two_flushed).sstables.empty());
+        BOOST_REQUIRE_EQUAL(get_sstables_for_compaction(cs, strict_cf.as_table_state(), three_flushed).sstables.size(), 3);
+    }
+
+    // Sstables which don't overlap are not compacted together.
+    auto first_half = add_sstable(10 * MB, min_key.key(), keys[20].key());
+    auto second_half = add_sstable(10 * MB, keys[30].key(), max_key.key());
+    BOOST_REQUIRE(get_sstables_for_compaction(cs, cf.as_table_state(), { first_half, second_half }).sstables.empty());
+
+    // Sstables overlapping the range of the most overlapping ones are compacted with them,
+    // even if they don't contain the most overlapped token, but the rest are not.
+    {
+        auto a = add_sstable(MB, keys[0].key(), keys[10].key());
+        auto b = add_sstable(MB, keys[5].key(), keys[15].key());
+        auto c = add_sstable(MB, keys[12].key(), keys[20].key());
+        auto d = add_sstable(MB, keys[30].key(), keys[40].key());
+        cs = make_ucs({{"scaling_parameters", "T3"}});
+        BOOST_REQUIRE(get_sstables_for_compaction(cs, cf.as_table_state(), { a, b, c, d }).sstables.empty());
+        cs = make_ucs({{"scaling_parameters", "L10"}});
+        auto desc = get_sstables_for_compaction(cs, cf.as_table_state(), { d, c, b, a });
+        BOOST_REQUIRE(std::ranges::is_permutation(desc.sstables, std::vector<shared_sstable>{ a, b, c }));
+    }
+
+    // Sstables of different densities are in different levels, and the lower level goes first.
+    auto large1 = add_sstable(1024 * MB, min_key.key(), max_key.key());
+    auto large2 = add_sstable(1024 * MB, min_key.key(), max_key.key());
+    cs = make_ucs({{"scaling_parameters", "N"}});
+    auto desc = get_sstables_for_compaction(cs, cf.as_table_state(), { flushed[0], large1, flushed[1], large2 });
+    BOOST_REQUIRE(std::ranges::is_permutation(desc.sstables, two_flushed));
+    desc = get_sstables_for_compaction(cs, cf.as_table_state(), { flushed[0], large1, large2 });
+    BOOST_REQUIRE(std::ranges::is_permutation(desc.sstables, std::vector<shared_sstable>{ large1, large2 }));
+
+    // Large outputs are split into a power of two multiple of base_shard_count sstables.
+    cs = make_ucs();
+    desc = cs.get_major_compaction_job(cf.as_table_state(), flushed);
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, sstables::compaction_descriptor::default_max_sstable_bytes);
+    std::vector<shared_sstable> huge;
+    for (auto i = 0; i < 4; i++) {
+        huge.push_back(add_sstable(3 * 1024 * MB, min_key.key(), max_key.key()));
+    }
+    desc = cs.get_major_compaction_job(cf.as_table_state(), huge);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), 4);
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, 12 * 1024 * MB / 8);
+
+    // Only levels which need compaction contribute to the backlog.
+    auto tracker = cs.make_backlog_tracker();
+    tracker.replace_sstables({}, three_flushed);
+    BOOST_REQUIRE_EQUAL(tracker.backlog(), 0);
+    tracker.replace_sstables({}, { flushed[3] });
+    BOOST_REQUIRE_GT(tracker.backlog(), 0);
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto make_schema = [&] (std::string_view cf, sstables::compaction_strategy_type cst) {
@@ -2085,6 +2179,74 @@ SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
             auto descriptor = get_sstables_for_compaction(cs, stcs_table.as_table_state(), { sst });
             BOOST_REQUIRE(descriptor.sstables.size() == 1);
         }
+        // sstable below tombstone_threshold will be included once reads of the table scan enough
+        // tombstones for the droppable ones to cross tombstone_read_cost_threshold
+        {
+            std::map<sstring, sstring> options;
+            options.emplace("tombstone_threshold", "0.5f");
+            options.emplace("tombstone_read_cost_threshold", "10");
+            auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, options);
+            sstables::test(sst).set_data_file_write_time(db_clock::time_point::min());
+            auto descriptor = get_sstables_for_compaction(cs, stcs_table.as_table_state(), { sst });
+            BOOST_REQUIRE(descriptor.sstables.size() == 0);
+
+            auto& stats = stcs_table->get_stats();
+            auto scan = [&] (unsigned reads, uint64_t tombstones_per_read) {
+                for (unsigned i = 0; i < reads; i++) {
+                    stats.tombstone_scanned.mark(std::chrono::microseconds(tombstones_per_read));
+                    stats.tombstones_scanned_rate.mark(tombstones_per_read);
+                }
+                // Like the meter timer does every tick.
+                stats.tombstone_scanned.met().update();
+                stats.tombstones_scanned_rate().update();
+            };
+            // Reads used to scan no tombstones...
+            scan(1000, 0);
+            descriptor = get_sstables_for_compaction(cs, stcs_table.as_table_state(), { sst });
+            BOOST_REQUIRE(descriptor.sstables.size() == 0);
+            // ...but the recent ones scan many, which outweighs the old ones.
+            for (auto tick = 0; tick < 100; tick++) {
+                scan(1, 100);
+            }
+            descriptor = get_sstables_for_compaction(cs, stcs_table.as_table_state(), { sst });
+            BOOST_REQUIRE(descriptor.sstables.size() == 1);
+        }
+    });
+}
+
+// The read amplification score of a compaction job follows the number of
+// sstables read by the recent reads, and not by all reads since startup.
+SEASTAR_TEST_CASE(sstables_per_read_follows_recent_reads) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "sstables_per_read")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+        auto t = env.make_table_for_tests(s);
+        auto close_t = deferred_stop(t);
+        auto& table_s = t.as_table_state();
+        BOOST_REQUIRE_EQUAL(table_s.sstables_per_read(), 0);
+
+        auto& stats = t->get_stats();
+        auto read = [&] (unsigned reads, uint64_t sstables_per_read) {
+            for (unsigned i = 0; i < reads; i++) {
+                stats.estimated_sstable_per_read.add(sstables_per_read);
+                stats.sstable_reads_rate.mark();
+                stats.sstables_read_rate.mark(sstables_per_read);
+            }
+            // Like the meter timer does every tick.
+            stats.sstable_reads_rate().update();
+            stats.sstables_read_rate().update();
+        };
+        // Reads used to touch many sstables...
+        read(1000, 8);
+        BOOST_REQUIRE_CLOSE(table_s.sstables_per_read(), 8, 0.1);
+        // ...but once the sstables are compacted the recent ones touch a
+        // single one, and the score of compacting the table drops.
+        for (auto tick = 0; tick < 100; tick++) {
+            read(1, 1);
+        }
+        BOOST_REQUIRE_GE(stats.estimated_sstable_per_read.mean(), 7);
+        BOOST_REQUIRE_LT(table_s.sstables_per_read(), 1.5);
     });
 }
 
@@ -5303,6 +5465,10 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test_incremental) {
     return run_controller_test(sstables::compaction_strategy_type::incremental);
 }
 
+SEASTAR_TEST_CASE(simple_backlog_controller_test_unified) {
+    return run_controller_test(sstables::compaction_strategy_type::unified);
+}
+
 SEASTAR_TEST_CASE(test_compaction_strategy_cleanup_method) {
     return test_env::do_with_async([] (test_env& env) {
         constexpr size_t all_files = 64;
@@ -5529,6 +5695,269 @@ SEASTAR_TEST_CASE(test_large_partition_splitting_on_compaction) {
     });
 }
 
+SEASTAR_TEST_CASE(test_large_partition_isolation_on_compaction) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "test_large_partition_isolation_on_compaction")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("cl", int32_type, column_kind::clustering_key)
+                .with_column("value", bytes_type);
+        builder.set_compressor_params(compression_parameters::no_compression());
+        auto s = builder.build();
+        auto sst_gen = env.make_sst_factory(s);
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+
+        auto pkeys = tests::generate_partition_keys(5, s);
+        auto& large_pkey = pkeys[2];
+        auto make_partition = [&] (const dht::decorated_key& dk, int32_t rows, size_t value_size) {
+            mutation m(s, dk);
+            for (int32_t i = 0; i < rows; i++) {
+                auto ck = clustering_key::from_exploded(*s, {int32_type->decompose(i)});
+                m.set_clustered_cell(ck, bytes("value"), data_value(bytes(value_size, 'v')), api::new_timestamp());
+            }
+            return m;
+        };
+
+        std::vector<mutation> small;
+        for (auto& dk : pkeys) {
+            small.push_back(make_partition(dk, 1, 10));
+        }
+        auto small_sst = make_sstable_containing(sst_gen, std::move(small));
+        auto large_sst = make_sstable_containing(sst_gen, std::vector<mutation>{make_partition(large_pkey, 100, 1024)});
+
+        auto desc = sstables::compaction_descriptor({ small_sst, large_sst });
+        desc.isolate_partitions_above = 50 * 1024;
+        auto ret = compact_sstables(env, std::move(desc), cf, sst_gen).get();
+
+        // The large partition is written alone, between the partitions which precede and follow it.
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 3);
+        std::ranges::sort(ret.new_sstables, [&] (const shared_sstable& a, const shared_sstable& b) {
+            return a->compare_by_first_key(*b) < 0;
+        });
+        auto& isolated = ret.new_sstables[1];
+        BOOST_REQUIRE(isolated->get_first_decorated_key().equal(*s, large_pkey));
+        BOOST_REQUIRE(isolated->get_last_decorated_key().equal(*s, large_pkey));
+        BOOST_REQUIRE(ret.new_sstables[0]->get_last_decorated_key().equal(*s, pkeys[1]));
+        BOOST_REQUIRE(ret.new_sstables[2]->get_first_decorated_key().equal(*s, pkeys[3]));
+
+        // Partitions below the threshold share an sstable as before.
+        desc = sstables::compaction_descriptor({ small_sst, large_sst });
+        desc.isolate_partitions_above = 1024 * 1024;
+        ret = compact_sstables(env, std::move(desc), cf, sst_gen).get();
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+    });
+}
+
+SEASTAR_TEST_CASE(test_compaction_resume_from_checkpoint) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "test_compaction_resume_from_checkpoint")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+        auto sst_gen = env.make_sst_factory(s);
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+
+        auto keys = tests::generate_partition_keys(10, s);
+        auto make_insert = [&] (const dht::decorated_key& dk, int32_t value, api::timestamp_type ts) {
+            mutation m(s, dk);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(value), ts);
+            return m;
+        };
+        // Both inputs span all the keys, the newer one overwrites every other key.
+        std::vector<mutation> older, newer, expected;
+        for (size_t i = 0; i < keys.size(); i++) {
+            older.push_back(make_insert(keys[i], i, 1));
+            expected.push_back(older.back());
+            if (i % 2 == 1) {
+                newer.push_back(make_insert(keys[i], -int32_t(i), 2));
+                expected.back().apply(newer.back());
+            }
+        }
+        auto inputs = std::vector<shared_sstable>{make_sstable_containing(sst_gen, std::move(older)), make_sstable_containing(sst_gen, std::move(newer))};
+
+        // Every output holds a single partition, and is checkpointed once sealed.
+        auto desc = sstables::compaction_descriptor(inputs, 0, 0);
+        auto run = desc.run_identifier;
+        std::vector<shared_sstable> outputs;
+        std::vector<std::pair<compaction_checkpoint, size_t>> checkpoints;
+        desc.checkpointer = [&] (const compaction_checkpoint& checkpoint) {
+            checkpoints.emplace_back(checkpoint, outputs.size());
+        };
+        auto replacer = [&] (compaction_completion_desc completion) {
+            for (auto& sst : completion.new_sstables) {
+                if (sst->run_identifier() == run) {
+                    outputs.push_back(sst);
+                }
+            }
+        };
+        compact_sstables(env, std::move(desc), cf, sst_gen, replacer).get();
+
+        BOOST_REQUIRE_EQUAL(checkpoints.size(), keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            auto& [checkpoint, sealed] = checkpoints[i];
+            BOOST_REQUIRE(checkpoint.last_key.equal(*s, keys[i]));
+            BOOST_REQUIRE_EQUAL(sealed, i + 1);
+            // The inputs are exhausted by the output holding their last key.
+            BOOST_REQUIRE_EQUAL(checkpoint.remaining_inputs.size(), i + 1 < keys.size() ? 2 : 0);
+        }
+
+        // Resuming from a checkpoint only compacts the partitions following it, and
+        // together with the outputs sealed before it, produces the whole compaction.
+        auto& [checkpoint, sealed] = checkpoints[4];
+        desc = sstables::compaction_descriptor(checkpoint.remaining_inputs, 0, 0, run);
+        desc.resume_after = checkpoint.last_key;
+        auto ret = compact_sstables(env, std::move(desc), cf, sst_gen).get();
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), keys.size() - 5);
+
+        auto permit = env.make_reader_permit();
+        std::vector<mutation_reader> readers;
+        auto resumed_outputs = std::vector<shared_sstable>(outputs.begin(), outputs.begin() + sealed);
+        resumed_outputs.insert(resumed_outputs.end(), ret.new_sstables.begin(), ret.new_sstables.end());
+        for (auto& sst : resumed_outputs) {
+            BOOST_REQUIRE(sst->run_identifier() == run);
+            readers.push_back(sstable_reader(sst, s, permit));
+        }
+        auto rd = assert_that(make_combined_reader(s, permit, std::move(readers)));
+        for (auto& m : expected) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
+
+// Fills ks.cf with 3 sstables of about 4MB holding disjoint token ranges, so that a
+// major compaction writes them to 1MB sstables of level 2, and exhausts them one by one.
+// Returns the values written, by partition key.
+static std::map<int32_t, bytes> populate_for_checkpoint_test(cql_test_env& e) {
+    e.execute_cql("CREATE TABLE ks.cf (pk int PRIMARY KEY, v blob)"
+            " WITH compaction = {'class': 'LeveledCompactionStrategy', 'sstable_size_in_mb': '1'}"
+            " AND compression = {'sstable_compression': ''}").get();
+    auto& t = e.local_db().find_column_family("ks", "cf");
+    t.disable_auto_compaction().get();
+    auto s = t.schema();
+
+    constexpr int32_t partitions = 120;
+    auto pks = std::views::iota(0, partitions) | std::ranges::to<std::vector>();
+    std::ranges::sort(pks, dht::decorated_key::less_comparator(s), [&] (int32_t pk) {
+        return dht::decorate_key(*s, partition_key::from_singular(*s, pk));
+    });
+    auto insert = e.prepare("INSERT INTO ks.cf (pk, v) VALUES (?, ?)").get();
+    std::map<int32_t, bytes> values;
+    for (int32_t i = 0; i < partitions; i++) {
+        auto value = tests::random::get_bytes(100 * 1024);
+        e.execute_prepared(insert, {{cql3::raw_value::make_value(int32_type->decompose(pks[i])), cql3::raw_value::make_value(value)}}).get();
+        values.emplace(pks[i], std::move(value));
+        if ((i + 1) % (partitions / 3) == 0) {
+            t.flush().get();
+        }
+    }
+    BOOST_REQUIRE_EQUAL(t.get_sstables()->size(), 3);
+    return values;
+}
+
+static void check_checkpoint_test_data(cql_test_env& e, const std::map<int32_t, bytes>& values) {
+    for (auto& [pk, value] : values) {
+        auto msg = e.execute_cql(format("SELECT v FROM ks.cf WHERE pk = {}", pk)).get();
+        assert_that(msg).is_rows().with_rows({{value}});
+    }
+}
+
+static std::vector<shared_sstable> sstables_of_run(const replica::table& t, sstables::run_id run) {
+    return *t.get_sstables() | std::views::filter([run] (const shared_sstable& sst) { return sst->run_identifier() == run; }) | std::ranges::to<std::vector>();
+}
+
+SEASTAR_TEST_CASE(test_major_compaction_resumes_from_checkpoint) {
+#ifndef SCYLLA_ENABLE_ERROR_INJECTION
+    fmt::print("Skipping test as it depends on error injection. Please run in mode where it's enabled (debug,dev).\n");
+    return make_ready_future<>();
+#endif
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto values = populate_for_checkpoint_test(e);
+        auto& t = e.local_db().find_column_family("ks", "cf");
+        auto& sys_ks = e.get_system_keyspace().local();
+
+        // Interrupt the major compaction once it exhausted its first input.
+        utils::get_local_injector().enable("major_compaction_stop_after_checkpoint", false, {{"remaining_inputs", "2"}});
+        t.compact_all_sstables(tasks::task_info{}).get();
+        utils::get_local_injector().disable("major_compaction_stop_after_checkpoint");
+
+        auto checkpoints = sys_ks.get_compaction_checkpoints(t.schema()->id()).get();
+        BOOST_REQUIRE_EQUAL(checkpoints.size(), 1);
+        BOOST_REQUIRE_EQUAL(checkpoints.front().inputs.size(), 2);
+        auto run = sstables::run_id(checkpoints.front().run_id);
+        auto sealed = sstables_of_run(t, run);
+        BOOST_REQUIRE(!sealed.empty());
+        BOOST_REQUIRE_EQUAL(t.get_sstables()->size(), sealed.size() + 2);
+        for (auto& sst : sealed) {
+            BOOST_REQUIRE_EQUAL(sst->get_sstable_level(), 2);
+        }
+        check_checkpoint_test_data(e, values);
+
+        // After a restart, only the sstables and the checkpoint are left of the interrupted
+        // compaction, so the next major compaction resumes from the checkpoint alone.
+        t.compact_all_sstables(tasks::task_info{}).get();
+
+        // The remaining inputs alone would make level 1 outputs, but the resumed compaction
+        // writes to the same run and level, and leaves the sealed outputs alone.
+        auto outputs = sstables_of_run(t, run);
+        BOOST_REQUIRE_EQUAL(outputs.size(), t.get_sstables()->size());
+        BOOST_REQUIRE_GT(outputs.size(), sealed.size());
+        for (auto& sst : sealed) {
+            BOOST_REQUIRE(std::ranges::find(outputs, sst) != outputs.end());
+        }
+        for (auto& sst : outputs) {
+            BOOST_REQUIRE_EQUAL(sst->get_sstable_level(), 2);
+        }
+        // The checkpoint is removed once the compaction completes.
+        BOOST_REQUIRE(sys_ks.get_compaction_checkpoints(t.schema()->id()).get().empty());
+        check_checkpoint_test_data(e, values);
+    });
+}
+
+SEASTAR_TEST_CASE(test_major_compaction_drops_stale_checkpoint) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto values = populate_for_checkpoint_test(e);
+        auto& t = e.local_db().find_column_family("ks", "cf");
+        auto& sys_ks = e.get_system_keyspace().local();
+        auto s = t.schema();
+
+        auto inputs = *t.get_sstables() | std::views::transform([] (const shared_sstable& sst) { return fmt::to_string(sst->generation()); })
+                | std::ranges::to<std::vector>();
+        auto make_checkpoint = [&] (std::unordered_set<sstring> inputs) {
+            return db::compaction_checkpoint_entry{
+                .table_uuid = s->id(),
+                .run_id = utils::make_random_uuid(),
+                .ks = s->ks_name(),
+                .cf = s->cf_name(),
+                .inputs = std::move(inputs),
+                .last_key = to_bytes(partition_key::from_singular(*s, values.begin()->first).representation()),
+                .bytes_total = 1,
+                .bytes_done = 1,
+            };
+        };
+        // One of the inputs of this checkpoint was compacted since.
+        auto stale = make_checkpoint({inputs[0], inputs[1], "gone"});
+        sys_ks.save_compaction_checkpoint(stale).get();
+        // None of the inputs of this one are known, it belongs to another shard.
+        auto foreign = make_checkpoint({"elsewhere"});
+        sys_ks.save_compaction_checkpoint(foreign).get();
+
+        t.compact_all_sstables(tasks::task_info{}).get();
+
+        // The compaction started over, and its own checkpoints were removed once it completed.
+        auto outputs = *t.get_sstables() | std::ranges::to<std::vector>();
+        BOOST_REQUIRE_GT(outputs.size(), 1);
+        for (auto& sst : outputs) {
+            BOOST_REQUIRE(sst->run_identifier() == outputs.front()->run_identifier());
+            BOOST_REQUIRE(sst->run_identifier().uuid() != stale.run_id);
+        }
+        auto checkpoints = sys_ks.get_compaction_checkpoints(s->id()).get();
+        BOOST_REQUIRE_EQUAL(checkpoints.size(), 1);
+        BOOST_REQUIRE_EQUAL(checkpoints.front().run_id, foreign.run_id);
+        check_checkpoint_test_data(e, values);
+    });
+}
+
 SEASTAR_TEST_CASE(check_table_sstable_set_includes_maintenance_sstables) {
     return test_env::do_with_async([] (test_env& env) {
         simple_schema ss;
@@ -5737,6 +6166,84 @@ SEASTAR_TEST_CASE(compaction_optimization_to_avoid_bloom_filter_checks) {
     });
 }
 
+SEASTAR_TEST_CASE(compaction_copies_non_overlapping_partitions_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "raw_partition_copy")
+                .with_column("pk", utf8_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type)
+                .build();
+        auto sst_gen = env.make_sst_factory(s);
+        auto t = env.make_table_for_tests(s);
+        auto stop_t = deferred_stop(t);
+
+        auto compact = [&] (std::vector<shared_sstable> ssts) {
+            return compact_sstables(env, sstables::compaction_descriptor(std::move(ssts)), t, sst_gen).get();
+        };
+
+        auto make_insert = [&] (const dht::decorated_key& key, api::timestamp_type ts) {
+            mutation m(s, key);
+            for (int32_t ck = 0; ck < 3; ++ck) {
+                m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(ck)), bytes("v"), data_value(ck), ts);
+            }
+            return m;
+        };
+
+        auto make_expiring_insert = [&] (const dht::decorated_key& key, api::timestamp_type ts, gc_clock::duration ttl) {
+            auto m = make_insert(key, ts);
+            m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(int32_t(3))), bytes("v"), data_value(int32_t(3)), ts, ttl);
+            return m;
+        };
+
+        // The older sstable holds most of the partitions, and shares one of them with the newer sstable.
+        const auto keys = tests::generate_partition_keys(20, s);
+        auto make_muts = [&] (unsigned first, unsigned last, std::function<mutation(const dht::decorated_key&)> make) {
+            std::vector<mutation> muts;
+            for (unsigned i = first; i < last; ++i) {
+                muts.push_back(make(keys[i]));
+            }
+            return muts;
+        };
+        auto compact_and_check = [&] (const std::vector<mutation>& old_muts, const std::vector<mutation>& new_muts) {
+            std::vector<mutation> expected(old_muts.begin(), old_muts.end() - 1);
+            expected.push_back(old_muts.back() + new_muts.front());
+            expected.insert(expected.end(), new_muts.begin() + 1, new_muts.end());
+
+            auto result = compact({make_sstable_containing(sst_gen, old_muts), make_sstable_containing(sst_gen, new_muts)});
+            BOOST_REQUIRE_EQUAL(1, result.new_sstables.size());
+            auto reader = assert_that(sstable_reader(result.new_sstables[0], s, env.make_reader_permit()));
+            for (auto& m : expected) {
+                reader.produces(m);
+            }
+            reader.produces_end_of_stream();
+            return result.stats.raw_copied_partitions;
+        };
+
+        auto old_muts = make_muts(0, 15, [&] (const dht::decorated_key& key) { return make_insert(key, 1); });
+        auto new_muts = make_muts(14, keys.size(), [&] (const dht::decorated_key& key) { return make_insert(key, 2); });
+        auto raw_copied_partitions = compact_and_check(old_muts, new_muts);
+        // False positives of the bloom filter may cause some partitions to be rewritten.
+        BOOST_REQUIRE_GT(raw_copied_partitions, 0);
+        BOOST_REQUIRE_LE(raw_copied_partitions, 14);
+
+        // Partitions of sstables with tombstones are always rewritten, as they may have
+        // something to purge, even though the sstables also hold live cells.
+        auto old_muts_with_tombstone = old_muts;
+        old_muts_with_tombstone.front().partition().apply(tombstone(0, gc_clock::now()));
+        auto new_muts_with_tombstone = new_muts;
+        new_muts_with_tombstone.back().partition().apply(tombstone(0, gc_clock::now()));
+        BOOST_REQUIRE_EQUAL(0, compact_and_check(old_muts_with_tombstone, new_muts_with_tombstone));
+
+        // Expiring cells are delta-encoded against the minimal local deletion time and TTL
+        // of their sstable, which differ from those of the output here, so their partitions
+        // have to be rewritten to keep their expiry.
+        auto old_expiring_muts = make_muts(0, 15, [&] (const dht::decorated_key& key) { return make_expiring_insert(key, 1, std::chrono::hours(1)); });
+        auto new_expiring_muts = new_muts;
+        new_expiring_muts.front() = make_expiring_insert(keys[14], 2, std::chrono::minutes(1));
+        BOOST_REQUIRE_EQUAL(0, compact_and_check(old_expiring_muts, new_expiring_muts));
+    });
+}
+
 static future<> run_incremental_compaction_test(sstables::offstrategy offstrategy, std::function<future<>(table_for_tests&, owned_ranges_ptr)> run_compaction) {
     return test_env::do_with_async([run_compaction = std::move(run_compaction), offstrategy] (test_env& env) {
         auto builder = schema_builder("tests", "test")
@@ -519,4 +519,31 @@ BOOST_AUTO_TEST_CASE(expression_extract_column_restrictions) {
         {});
 }
 
+// Key lookups with every key column restricted by EQ take a path which only
+// evaluates the bound values. Check that it picks the right values for the
+// right columns and that a NULL bound value matches nothing.
+SEASTAR_TEST_CASE(prepared_key_lookup) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        cquery_nofail(e, "create table ks.t(p1 int, p2 text, c1 int, c2 text, v int, primary key((p1,p2),c1,c2))");
+        cquery_nofail(e, "insert into ks.t(p1,p2,c1,c2,v) values (1,'a',2,'b',3)");
+        cquery_nofail(e, "insert into ks.t(p1,p2,c1,c2,v) values (1,'a',2,'c',4)");
+        cquery_nofail(e, "insert into ks.t(p1,p2,c1,c2,v) values (1,'b',2,'b',5)");
+
+        auto v = [] (bytes b) { return cql3::raw_value::make_value(std::move(b)); };
+        auto row = e.prepare("select v from ks.t where p2=? and p1=? and c1=? and c2=?").get();
+        assert_that(e.execute_prepared(row, {v(T("a")), v(I(1)), v(I(2)), v(T("c"))}).get())
+                .is_rows().with_rows({{I(4)}});
+        assert_that(e.execute_prepared(row, {v(T("b")), v(I(1)), v(I(2)), v(T("b"))}).get())
+                .is_rows().with_rows({{I(5)}});
+        assert_that(e.execute_prepared(row, {cql3::raw_value::make_null(), v(I(1)), v(I(2)), v(T("b"))}).get())
+                .is_rows().is_empty();
+        assert_that(e.execute_prepared(row, {v(T("a")), v(I(1)), v(I(2)), cql3::raw_value::make_null()}).get())
+                .is_rows().is_empty();
+
+        auto prefix = e.prepare("select v from ks.t where p1=? and p2=? and c1=?").get();
+        assert_that(e.execute_prepared(prefix, {v(I(1)), v(T("a")), v(I(2))}).get())
+                .is_rows().with_rows({{I(3)}, {I(4)}});
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
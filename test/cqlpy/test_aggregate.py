@@ -261,3 +261,43 @@ def test_sum_star(cql, table1):
     p = unique_key_int()
     with pytest.raises(SyntaxException):
         cql.execute(f"select sum(*) from {table1} where p = {p}")
+
+# Aggregates of native numeric columns are computed over batches of rows
+# rather than row by row. Check that aggregating more rows than fit in one
+# batch, with some null values, gives the same results as computing them
+# one value at a time.
+def test_aggregates_over_many_rows(cql, test_keyspace):
+    schema = "p int, c int, i int, b bigint, d double, t timestamp, PRIMARY KEY (p, c)"
+    with new_test_table(cql, test_keyspace, schema) as table:
+        stmt = cql.prepare(f"insert into {table} (p, c, i, b, d, t) values (0, ?, ?, ?, ?, ?)")
+        n = 2500
+        rows = []
+        for c in range(n):
+            i = None if c % 7 == 0 else c - 1000
+            b = None if c % 5 == 0 else (c - 1000) * 1000000000000
+            d = None if c % 3 == 0 else c * 0.1
+            t = None if c % 11 == 0 else c * 1000
+            cql.execute(stmt, [c, i, b, d, t])
+            rows.append((i, b, d, t))
+        def nonnull(k):
+            return [r[k] for r in rows if r[k] is not None]
+        ints, bigints, doubles, timestamps = nonnull(0), nonnull(1), nonnull(2), nonnull(3)
+        double_sum = 0.0
+        for d in doubles:
+            double_sum += d
+        res = cql.execute(f"select count(*), count(i), sum(i), min(i), max(i), avg(i), sum(b), min(b), max(b), sum(d), avg(d) from {table} where p = 0").one()
+        assert res[0] == n
+        assert res[1] == len(ints)
+        assert res[2] == sum(ints)
+        assert res[3] == min(ints)
+        assert res[4] == max(ints)
+        assert res[5] == int(sum(ints) / len(ints))
+        assert res[6] == sum(bigints)
+        assert res[7] == min(bigints)
+        assert res[8] == max(bigints)
+        assert res[9] == double_sum
+        assert res[10] == pytest.approx(double_sum / len(doubles))
+        res = cql.execute(f"select count(t), tounixtimestamp(min(t)), tounixtimestamp(max(t)) from {table} where p = 0").one()
+        assert res[0] == len(timestamps)
+        assert res[1] == min(timestamps)
+        assert res[2] == max(timestamps)
@@ -65,3 +65,27 @@ def test_multi_column_relation_desc(cql, table2):
     cql.execute(stmt, [0, 1, 1])
     cql.execute(stmt, [0, 1, 2])
     assert [(1, 2), (1, 1)] == list(cql.execute(f'SELECT c1,c2 FROM {table2} WHERE p = 0 AND (c1, c2) >= (1, 1)'))
+
+# Test SELECT with IN on the partition key, ORDER BY and LIMIT: the first
+# rows in the requested order are selected out of the rows of all the
+# partitions. Check both orders, on tables with ascending and descending
+# clustering order, and with partitions whose rows interleave.
+@pytest.mark.parametrize("clustering_order", ["ASC", "DESC"])
+def test_in_order_by_limit(cql, test_keyspace, clustering_order):
+    schema="k INT, c INT, v INT, PRIMARY KEY (k, c)"
+    order=f"WITH CLUSTERING ORDER BY (c {clustering_order})"
+    with new_test_table(cql, test_keyspace, schema, order) as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (k, c, v) VALUES (?, ?, ?)')
+        keys = range(5)
+        cs = []
+        for k in keys:
+            for i in range(10):
+                c = i * len(keys) + (k * 3) % len(keys)
+                cql.execute(stmt, [k, c, k])
+                cs.append((c, k))
+        in_keys = ', '.join(str(k) for k in keys)
+        for N in [1, 7, 25, 100]:
+            expected = sorted(cs)[0:N]
+            assert expected == list(cql.execute(f'SELECT c, v FROM {table} WHERE k IN ({in_keys}) ORDER BY c ASC LIMIT {N}'))
+            expected = sorted(cs, reverse=True)[0:N]
+            assert expected == list(cql.execute(f'SELECT c, v FROM {table} WHERE k IN ({in_keys}) ORDER BY c DESC LIMIT {N}'))
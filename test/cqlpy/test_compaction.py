@@ -6,6 +6,7 @@ import pytest
 import requests
 from .util import new_materialized_view, new_test_table
 from . import nodetool
+from .rest_api import scylla_inject_error, post_request, get_request
 import time
 
 # sleep to let a ttl (of `seconds`) expire and
@@ -182,3 +183,54 @@ def test_compactionstats_after_major_compaction(scylla_only, cql, test_keyspace,
             nodetool.compact(cql, table)
             tasks, stats = get_compaction_stats(cql, table)
             assert tasks == 0, f"Found {tasks} pending compaction tasks unexpectedly: stats={stats}"
+
+def get_read_amplification_score(cql, table):
+    ks, cf = table.split('.')
+    res = requests.get(f'{nodetool.rest_api_url(cql)}/compaction_manager/metrics/read_amplification_scores')
+    res.raise_for_status()
+    stats = res.json()
+    scores = [float(s['score']) for s in stats if s['ks'] == ks and s['cf'] == cf]
+    return scores, stats
+
+def wait_for(cond, timeout=60):
+    deadline = time.time() + timeout
+    while not cond():
+        assert time.time() < deadline, "Timed out waiting"
+        time.sleep(0.1)
+
+def test_read_amplification_scores(scylla_only, cql, test_keyspace):
+    """
+    Test that the compaction job picked for a table whose reads touch several
+    sstables has a positive read amplification score, and that the score drops
+    to 0 once the table has no compaction left to do
+    """
+    injection = "compaction_regular_compaction_task_executor_picked_job"
+    with new_test_table(cql, test_keyspace, schema="p int, c int, v int, PRIMARY KEY (p, c)") as table:
+        ks, cf = table.split('.')
+        def read_rate():
+            return get_request(cql, f'column_family/metrics/read_latency/moving_average_histogram/{ks}:{cf}')['meter']['rates'][0]
+        def score():
+            scores, stats = get_read_amplification_score(cql, table)
+            assert len(scores) == 1, f"Expected a single score for {table}: stats={stats}"
+            return scores[0]
+
+        with scylla_inject_error(cql, injection):
+            with nodetool.no_autocompaction_context(cql, table):
+                for c in range(4):
+                    cql.execute(f"INSERT INTO {table} (p, c, v) VALUES (0, {c}, {c})")
+                    nodetool.flush(cql, table)
+                # The read rate is only updated every few seconds.
+                def read():
+                    for _ in range(10):
+                        assert len(list(cql.execute(f"SELECT * FROM {table} WHERE p = 0"))) == 4
+                    return read_rate() > 0
+                wait_for(read)
+                # No job is picked while autocompaction is disabled.
+                assert score() == 0
+            # Enabling autocompaction picks the job compacting the 4 sstables
+            # every read touches, which waits in the injection point.
+            wait_for(lambda: score() > 0)
+            post_request(cql, f'v2/error_injection/injection/{injection}/message')
+        # Once the job is done, the next pick finds nothing to compact.
+        wait_for(lambda: score() == 0)
+        assert len(list(cql.execute(f"SELECT * FROM {table} WHERE p = 0"))) == 4
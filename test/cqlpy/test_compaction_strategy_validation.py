@@ -57,6 +57,16 @@ def test_incremental_compaction_strategy_options(cql, table1):
     assert_throws(cql, table1, r"space_amplification_goal value \(2.2\) must be greater than 1.0 and less than or equal to 2.0", "ALTER TABLE %s WITH compaction = { 'class' : 'IncrementalCompactionStrategy', 'space_amplification_goal' : 2.2 }")
     assert_throws(cql, table1, r"min_threshold value \(1\) must be bigger or equal to 2", "ALTER TABLE %s WITH compaction = { 'class' : 'IncrementalCompactionStrategy', 'min_threshold' : 1 }")
 
+# UnifiedCompactionStrategy is Scylla-specific in this form (Cassandra's UCS takes sizes with units)
+def test_unified_compaction_strategy_options(scylla_only, cql, table1):
+    assert_throws(cql, table1, r"scaling_parameters value \(T1\) must be a comma-separated list", "ALTER TABLE %s WITH compaction = { 'class' : 'UnifiedCompactionStrategy', 'scaling_parameters' : 'T1' }")
+    assert_throws(cql, table1, r"scaling_parameters value \(L4,X\) must be a comma-separated list", "ALTER TABLE %s WITH compaction = { 'class' : 'UnifiedCompactionStrategy', 'scaling_parameters' : 'L4,X' }")
+    assert_throws(cql, table1, r"target_sstable_size_in_mb value \(0\) must be positive", "ALTER TABLE %s WITH compaction = { 'class' : 'UnifiedCompactionStrategy', 'target_sstable_size_in_mb' : 0 }")
+    assert_throws(cql, table1, r"min_sstable_size_in_mb value \(-1\) must be positive", "ALTER TABLE %s WITH compaction = { 'class' : 'UnifiedCompactionStrategy', 'min_sstable_size_in_mb' : -1 }")
+    assert_throws(cql, table1, r"base_shard_count value \(0\) must be between 1 and 1024", "ALTER TABLE %s WITH compaction = { 'class' : 'UnifiedCompactionStrategy', 'base_shard_count' : 0 }")
+    cql.execute(f"ALTER TABLE {table1} WITH compaction = {{ 'class' : 'UnifiedCompactionStrategy', 'scaling_parameters' : 'L10, T4, N, -2' }}")
+    cql.execute(f"ALTER TABLE {table1} WITH compaction = {{ 'class' : 'SizeTieredCompactionStrategy' }}")
+
 def test_not_allowed_options(cql, table1):
     def scylla_error(**kwargs):
         template = "Invalid compaction strategy options {{{}}} for chosen strategy type"
@@ -13,7 +13,9 @@
 import pytest
 import re
 from .util import new_test_table, new_type, user_type
-from cassandra.protocol import InvalidRequest
+from . import nodetool
+from .rest_api import scylla_inject_error
+from cassandra.protocol import InvalidRequest, ConfigurationException
 from cassandra.query import UNSET_VALUE
 
 # When filtering for "x > 0" or "x < 0", rows with an unset value for x
@@ -486,3 +488,139 @@ def test_selecting_a_regular_column_does_not_poison_filtering_of_a_static_row(cq
         cql.execute(f"INSERT INTO {table} (a, s) VALUES (1, 2)")
         res = cql.execute(f"SELECT a, b, c, s FROM {table} WHERE s = 2 ALLOW FILTERING")
         assert list(res) == [(1, None, None, 2)]
+
+# Replicas may apply simple restrictions on regular columns themselves, and
+# count only the matching rows towards the page's limits. Check that paged
+# filtering queries still return exactly the matching rows, also when cells
+# are missing or deleted, and that LIMIT and PER PARTITION LIMIT count only
+# the matching rows.
+def test_filter_regular_column_paged(cql, test_keyspace):
+    with new_test_table(cql, test_keyspace, 'p int, c int, v int, w text, primary key (p, c)') as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c, v, w) VALUES (?, ?, ?, ?)')
+        rows = {}
+        for p in range(4):
+            for c in range(30):
+                rows[(p, c)] = (c % 7, str(c % 3))
+                cql.execute(stmt, [p, c, c % 7, str(c % 3)])
+        for p in range(4):
+            cql.execute(f'INSERT INTO {table} (p, c) VALUES ({p}, 100)')
+            rows[(p, 100)] = (None, None)
+            cql.execute(f'DELETE v FROM {table} WHERE p = {p} AND c = 3')
+            rows[(p, 3)] = (None, rows[(p, 3)][1])
+        ops = {'=': lambda a, b: a == b, '!=': lambda a, b: a != b,
+               '<': lambda a, b: a < b, '<=': lambda a, b: a <= b,
+               '>': lambda a, b: a > b, '>=': lambda a, b: a >= b}
+        for op, f in ops.items():
+            expected = sorted((p, c) for (p, c), (v, w) in rows.items() if v is not None and f(v, 3) and w == '1')
+            s = cql.prepare(f"SELECT p, c FROM {table} WHERE v {op} ? AND w = '1' ALLOW FILTERING")
+            s.fetch_size = 4
+            assert sorted(cql.execute(s, [3])) == expected
+        s = cql.prepare(f"SELECT p, c FROM {table} WHERE v = 5 ALLOW FILTERING")
+        s.fetch_size = 3
+        all_matching = list(cql.execute(s))
+        assert len(all_matching) == 16
+        s = cql.prepare(f"SELECT p, c FROM {table} WHERE v = 5 LIMIT 6 ALLOW FILTERING")
+        s.fetch_size = 3
+        assert list(cql.execute(s)) == all_matching[:6]
+        s = cql.prepare(f"SELECT p, c FROM {table} WHERE v = 5 PER PARTITION LIMIT 2 ALLOW FILTERING")
+        s.fetch_size = 3
+        assert sorted(cql.execute(s)) == sorted((p, c) for p in range(4) for c in [5, 12])
+
+def traced_value_index(cql, query):
+    events = cql.execute(query, trace=True).get_query_trace().events
+    return any('sstable value index' in event.description for event in events)
+
+# Tables with an sstable_value_index option index the listed columns in an
+# sstable component, which replicas use to read only the candidate rows of a
+# single-partition filtering query. Check that the results stay correct when
+# the values of a row are spread over memtables and several sstables, and
+# overwritten or deleted in newer ones.
+def test_sstable_value_index(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "p int, c int, v int, w text, PRIMARY KEY (p, c)",
+            "WITH sstable_value_index = {'columns': 'v, w'}") as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c, v, w) VALUES (?, ?, ?, ?)')
+        rows = {}
+        for p in range(2):
+            for c in range(50):
+                rows[(p, c)] = (c % 5, str(c % 3))
+                cql.execute(stmt, [p, c, c % 5, str(c % 3)])
+        nodetool.flush(cql, table)
+        for c in range(0, 50, 7):
+            rows[(0, c)] = (2, rows[(0, c)][1])
+            cql.execute(f'UPDATE {table} SET v = 2 WHERE p = 0 AND c = {c}')
+        cql.execute(f'DELETE FROM {table} WHERE p = 0 AND c = 12')
+        del rows[(0, 12)]
+        cql.execute(f'DELETE FROM {table} WHERE p = 0 AND c > 40 AND c < 45')
+        for c in range(41, 45):
+            del rows[(0, c)]
+        nodetool.flush(cql, table)
+        cql.execute(f'DELETE v FROM {table} WHERE p = 0 AND c = 17')
+        rows[(0, 17)] = (None, rows[(0, 17)][1])
+        cql.execute(f'INSERT INTO {table} (p, c, v) VALUES (0, 100, 2)')
+        rows[(0, 100)] = (2, None)
+
+        for v in range(5):
+            expected = sorted(c for (p, c), (rv, _) in rows.items() if p == 0 and rv == v)
+            query = f'SELECT c FROM {table} WHERE p = 0 AND v = {v} ALLOW FILTERING'
+            assert traced_value_index(cql, query)
+            assert sorted(r.c for r in cql.execute(query)) == expected
+            s = cql.prepare(f'SELECT c FROM {table} WHERE p = 0 AND v = ? ALLOW FILTERING')
+            s.fetch_size = 3
+            assert sorted(r.c for r in cql.execute(s, [v])) == expected
+        expected = sorted(c for (p, c), (rv, rw) in rows.items() if p == 0 and rw == '1' and c >= 10 and c < 30)
+        query = f"SELECT c FROM {table} WHERE p = 0 AND c >= 10 AND c < 30 AND w = '1' ALLOW FILTERING"
+        assert traced_value_index(cql, query)
+        assert sorted(r.c for r in cql.execute(query)) == expected
+        # Columns removed from the option are no longer looked up, even if
+        # existing sstables still index them.
+        cql.execute(f"ALTER TABLE {table} WITH sstable_value_index = {{'columns': 'v'}}")
+        query = f"SELECT c FROM {table} WHERE p = 1 AND w = '1' ALLOW FILTERING"
+        assert not traced_value_index(cql, query)
+        assert sorted(r.c for r in cql.execute(query)) == sorted(c for (p, c), (_, rw) in rows.items() if p == 1 and rw == '1')
+
+# Sstables written before the option was set have no value index, so reads
+# filter whole partitions until compaction rewrites them.
+def test_sstable_value_index_added_later(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "p int, c int, v int, PRIMARY KEY (p, c)") as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c, v) VALUES (?, ?, ?)')
+        for c in range(20):
+            cql.execute(stmt, [0, c, c % 4])
+        nodetool.flush(cql, table)
+        cql.execute(f"ALTER TABLE {table} WITH sstable_value_index = {{'columns': 'v'}}")
+        query = f'SELECT c FROM {table} WHERE p = 0 AND v = 1 ALLOW FILTERING'
+        expected = [c for c in range(20) if c % 4 == 1]
+        assert not traced_value_index(cql, query)
+        assert [r.c for r in cql.execute(query)] == expected
+        nodetool.compact(cql, table)
+        assert traced_value_index(cql, query)
+        assert [r.c for r in cql.execute(query)] == expected
+
+# The partition is snapshotted in the memtables before the sstables are
+# looked up, so rows of a memtable flushed in between are still found: the
+# sstable written by the flush isn't among those looked up.
+def test_sstable_value_index_concurrent_flush(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "p int, c int, v int, PRIMARY KEY (p, c)",
+            "WITH sstable_value_index = {'columns': 'v'}") as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c, v) VALUES (?, ?, ?)')
+        for c in range(10):
+            cql.execute(stmt, [0, c, c % 2])
+        nodetool.flush(cql, table)
+        for c in range(10, 20):
+            cql.execute(stmt, [0, c, c % 2])
+        query = f'SELECT c FROM {table} WHERE p = 0 AND v = 1 ALLOW FILTERING'
+        with scylla_inject_error(cql, "narrow_slice_with_value_index_flush", one_shot=True):
+            assert [r.c for r in cql.execute(query)] == [c for c in range(20) if c % 2 == 1]
+        assert traced_value_index(cql, query)
+
+def test_sstable_value_index_validation(cql, test_keyspace, scylla_only):
+    schema = "p int, c int, v int, s int static, l list<int>, d decimal, PRIMARY KEY (p, c)"
+    with new_test_table(cql, test_keyspace, schema) as table:
+        for columns in ['', 'x', 'p', 'c', 's', 'l', 'd', 'v, v']:
+            with pytest.raises(ConfigurationException):
+                cql.execute(f"ALTER TABLE {table} WITH sstable_value_index = {{'columns': '{columns}'}}")
+        with pytest.raises(ConfigurationException):
+            cql.execute(f"ALTER TABLE {table} WITH sstable_value_index = {{'column': 'v'}}")
+        cql.execute(f"ALTER TABLE {table} WITH sstable_value_index = {{'columns': 'v'}}")
+    with pytest.raises(ConfigurationException):
+        with new_test_table(cql, test_keyspace, "p int PRIMARY KEY, v int", "WITH sstable_value_index = {'columns': 'v'}"):
+            pass
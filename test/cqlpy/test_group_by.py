@@ -7,7 +7,7 @@
 #############################################################################
 
 import pytest
-from .util import new_test_table
+from .util import new_test_table, config_value_context
 from cassandra.protocol import InvalidRequest
 
 # table1 has some pre-set data which the tests below SELECT on (the tests
@@ -221,6 +221,55 @@ def test_group_by_v_and_sum_with_limit(cql, table1):
     for i in range(1,4):
         assert results[:i] == list(cql.execute(f'SELECT p,v,sum(v) FROM {table1} GROUP BY p,c1 LIMIT {i}'))
 
+# Aggregations with GROUP BY may be computed in parallel by the replicas when
+# all the groups fit in one page, and fall back to the regular paged query
+# otherwise. Check that both ways give the same groups, in the same order.
+def test_group_by_count_and_sum_fetch_size(cql, test_keyspace):
+    with new_test_table(cql, test_keyspace, "p int, c1 int, c2 int, v int, PRIMARY KEY (p, c1, c2)") as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c1, c2, v) VALUES (?, ?, ?, ?)')
+        for p in range(20):
+            for c1 in range(3):
+                for c2 in range(p % 4 + 1):
+                    cql.execute(stmt, [p, c1, c2, p + c1 + c2])
+        def execute(qry, fetch_size):
+            stmt = cql.prepare(qry)
+            stmt.fetch_size = fetch_size
+            return list(cql.execute(stmt))
+        for qry in [f'SELECT p, count(*), sum(v) FROM {table} GROUP BY p',
+                    f'SELECT p, c1, count(*), sum(v) FROM {table} GROUP BY p, c1',
+                    f'SELECT c1, max(v), p FROM {table} GROUP BY p, c1',
+                    f'SELECT count(v) FROM {table} GROUP BY p, c1 LIMIT 7']:
+            expected = execute(qry, 5)
+            assert expected == execute(qry, 1000)
+            assert expected == execute(qry, None)
+        assert sorted(execute(f'SELECT p, count(*), sum(v) FROM {table} GROUP BY p', 1000)) == \
+            [(p, 3 * (p % 4 + 1), sum(p + c1 + c2 for c1 in range(3) for c2 in range(p % 4 + 1))) for p in range(20)]
+
+# Check that the groups are really computed in parallel when they fit in a
+# page, and by the regular query when they don't, or when an unpaged query
+# has more groups than fit in max_memory_for_unlimited_query_soft_limit.
+def test_group_by_parallelized(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "p int, c int, v int, PRIMARY KEY (p, c)") as table:
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c, v) VALUES (?, ?, ?)')
+        for p in range(20):
+            for c in range(3):
+                cql.execute(stmt, [p, c, p + c])
+        expected = [(p, 3, 3 * p + 3) for p in range(20)]
+        def execute(fetch_size):
+            stmt = cql.prepare(f'SELECT p, count(*), sum(v) FROM {table} GROUP BY p')
+            stmt.fetch_size = fetch_size
+            res = cql.execute(stmt, trace=True)
+            descriptions = [event.description for event in res.get_query_trace().events]
+            parallelized = any('groups in parallel' in d for d in descriptions)
+            fell_back = any('falling back to a regular query' in d for d in descriptions)
+            assert parallelized != fell_back
+            return sorted(res), parallelized
+        assert execute(1000) == (expected, True)
+        assert execute(None) == (expected, True)
+        assert execute(5) == (expected, False)
+        with config_value_context(cql, 'max_memory_for_unlimited_query_soft_limit', '100'):
+            assert execute(None) == (expected, False)
+
 # GROUP BY of a non-aggregated column qualified by ttl or writetime should work (#14715)
 def test_group_by_non_aggregated_mutation_attribute_of_column(cql, table1):
     results = list(cql.execute(f'SELECT v, writetime(v), ttl(v) FROM {table1} GROUP BY p, c1'))
@@ -2,7 +2,7 @@
 #
 # SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
 
-from .util import new_test_table
+from .util import new_test_table, config_value_context
 from cassandra.query import SimpleStatement
 import pytest
 from . import nodetool
@@ -35,3 +35,33 @@ def test_sticky_stop_flag(cql, test_keyspace):
         res = list(cql.execute(statement))
 
         assert len(res) == 199
+
+# With adaptive paging, the server picks the number of rows in each page,
+# based on the size and latency of the previous pages, within bounds derived
+# from the page size requested by the client. Small rows should make pages
+# grow beyond the requested size, and all rows should still be returned
+# exactly once.
+def test_adaptive_paging(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, 'pk int, ck int, v int, PRIMARY KEY (pk, ck)') as table:
+        insert_row_id = cql.prepare(f"INSERT INTO {table} (pk, ck, v) VALUES (?, ?, ?)")
+        for ck in range(1000):
+            cql.execute(insert_row_id, (0, ck, ck))
+
+        # Disable the time budget, so the page sizes only depend on the size
+        # of the rows.
+        with config_value_context(cql, 'enable_adaptive_paging', 'true'), \
+                config_value_context(cql, 'adaptive_paging_time_budget_in_ms', '0'):
+            statement = SimpleStatement(f"SELECT * FROM {table} WHERE pk = 0", fetch_size=10)
+            res = cql.execute(statement)
+            page_sizes = []
+            rows = []
+            while True:
+                page_sizes.append(len(res.current_rows))
+                rows.extend(res.current_rows)
+                if not res.has_more_pages:
+                    break
+                res.fetch_next_page()
+
+        assert [r.ck for r in rows] == list(range(1000))
+        assert max(page_sizes) > 10
+        assert max(page_sizes) <= 10 * 16
@@ -15,7 +15,7 @@ from cassandra.protocol import SyntaxException, AlreadyExists, InvalidRequest, C
 from cassandra.query import SimpleStatement
 from .cassandra_tests.porting import assert_rows, assert_row_count, assert_rows_ignoring_order, assert_empty
 
-from .util import new_test_table, unique_name, unique_key_int, is_scylla
+from .util import new_test_table, unique_name, unique_key_int, is_scylla, config_value_context
 
 # A reproducer for issue #7443: Normally, when the entire table is SELECTed,
 # the partitions are returned sorted by the partitions' token. When there
@@ -1981,3 +1981,100 @@ def test_index_in_API(cql, test_keyspace):
         wait_for_index(cql, test_keyspace, index_name)
         res = rest_api.get_request(cql, f"column_family/built_indexes/{table.replace('.',':')}")
         assert index_name in res
+
+# Test that a query using an index returns all matching rows, whether they
+# are spread over many partitions or share a few partitions (which are then
+# read with one request per partition), with and without paging, and with
+# any limit on the number of base partitions read in parallel.
+@pytest.mark.parametrize("concurrency", ["1", "3", "4096"])
+def test_index_base_fetch_concurrency(cql, test_keyspace, scylla_only, concurrency):
+    with new_test_table(cql, test_keyspace, "p int, c int, v int, PRIMARY KEY (p, c)") as table:
+        index_name = unique_name()
+        cql.execute(f"CREATE INDEX {index_name} ON {table}(v)")
+        wait_for_index(cql, test_keyspace, index_name)
+        stmt = cql.prepare(f"INSERT INTO {table} (p, c, v) VALUES (?, ?, ?)")
+        for p in range(50):
+            for c in range(p % 4):
+                cql.execute(stmt, [p, c, 1 if (p + c) % 3 else 2])
+        expected = sorted((p, c) for p in range(50) for c in range(p % 4) if (p + c) % 3)
+        with config_value_context(cql, 'secondary_index_base_query_concurrency', concurrency):
+            for page_size in [2, 7, 1000]:
+                rows = cql.execute(SimpleStatement(f"SELECT p, c FROM {table} WHERE v = 1", fetch_size=page_size))
+                assert sorted((r.p, r.c) for r in rows) == expected
+            assert len(list(cql.execute(f"SELECT p, c FROM {table} WHERE v = 1 LIMIT 5"))) == 5
+    # Without a clustering key, whole partitions are read, several of them
+    # with a single command.
+    with new_test_table(cql, test_keyspace, "p int PRIMARY KEY, v int") as table:
+        index_name = unique_name()
+        cql.execute(f"CREATE INDEX {index_name} ON {table}(v)")
+        wait_for_index(cql, test_keyspace, index_name)
+        stmt = cql.prepare(f"INSERT INTO {table} (p, v) VALUES (?, ?)")
+        for p in range(50):
+            cql.execute(stmt, [p, 1 if p % 3 else 2])
+        expected = [p for p in range(50) if p % 3]
+        with config_value_context(cql, 'secondary_index_base_query_concurrency', concurrency):
+            for page_size in [2, 7, 1000]:
+                rows = cql.execute(SimpleStatement(f"SELECT p FROM {table} WHERE v = 1", fetch_size=page_size))
+                assert sorted(r.p for r in rows) == expected
+
+def traced_covering_index(cql, query):
+    events = cql.execute(query, trace=True).get_query_trace().events
+    return any('covering index' in event.description for event in events)
+
+# Test that an index can include regular columns, and that queries selecting
+# only keys, the indexed column and included columns are answered from the
+# index, with the same results as queries which read the base table.
+def test_covering_index(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "p int, c int, v int, x int, y int, PRIMARY KEY (p, c)") as table:
+        index_name = unique_name()
+        cql.execute(f"CREATE INDEX {index_name} ON {table}(v) INCLUDE (x)")
+        wait_for_index(cql, test_keyspace, index_name)
+        stmt = cql.prepare(f"INSERT INTO {table} (p, c, v, x, y) VALUES (?, ?, ?, ?, ?)")
+        for p in range(10):
+            for c in range(3):
+                cql.execute(stmt, [p, c, p % 2, p * 10 + c, -p])
+        cql.execute(f"UPDATE {table} SET x = null WHERE p = 1 AND c = 1")
+
+        expected = sorted((p, c, None if (p, c) == (1, 1) else p * 10 + c) for p in range(10) for c in range(3) if p % 2 == 1)
+        query = f"SELECT p, c, x FROM {table} WHERE v = 1"
+        assert traced_covering_index(cql, query)
+        assert sorted(cql.execute(query)) == expected
+        for page_size in [1, 4, 100]:
+            assert sorted(cql.execute(SimpleStatement(query, fetch_size=page_size))) == expected
+        assert len(list(cql.execute(f"SELECT x FROM {table} WHERE v = 1 LIMIT 4"))) == 4
+
+        # Selectors over included columns are computed as usual.
+        assert sorted(r.s for r in cql.execute(f"SELECT blobasint(intasblob(x)) AS s FROM {table} WHERE v = 0")) == \
+            sorted(p * 10 + c for p in range(0, 10, 2) for c in range(3))
+
+        # Updates of included columns are seen by the index.
+        cql.execute(f"UPDATE {table} SET x = 1000 WHERE p = 3 AND c = 2")
+        assert list(cql.execute(f"SELECT x FROM {table} WHERE v = 1 AND p = 3 AND c = 2 ALLOW FILTERING")) == [(1000,)]
+        assert (3, 2, 1000) in list(cql.execute(query))
+
+        # Queries selecting columns which are not included, or selecting
+        # their write time, read the base table.
+        for query in [f"SELECT p, y FROM {table} WHERE v = 1", f"SELECT * FROM {table} WHERE v = 1",
+                      f"SELECT writetime(x) FROM {table} WHERE v = 1"]:
+            assert not traced_covering_index(cql, query)
+            assert len(list(cql.execute(query))) == 15
+
+# Test the validation of the INCLUDE clause of CREATE INDEX, and that it is
+# shown by DESCRIBE.
+def test_covering_index_validation(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "p int, c int, v int, x int, s int static, PRIMARY KEY (p, c)") as table:
+        for include, error in [("p", "regular columns"), ("c", "regular columns"), ("s", "regular columns"),
+                               ("v", "indexed column"), ("x, x", "Duplicate"), ("nonexistent", "No column")]:
+            with pytest.raises(InvalidRequest, match=error):
+                cql.execute(f"CREATE INDEX ON {table}(v) INCLUDE ({include})")
+        with pytest.raises(InvalidRequest, match="global indexes"):
+            cql.execute(f"CREATE INDEX ON {table}((p), v) INCLUDE (x)")
+
+        index_name = unique_name()
+        cql.execute(f"CREATE INDEX {index_name} ON {table}(v) INCLUDE (x)")
+        wait_for_index(cql, test_keyspace, index_name)
+        desc = cql.execute(f"DESC INDEX {test_keyspace}.{index_name}").one().create_statement
+        assert "INCLUDE (x)" in desc
+        # A column included in an index cannot be dropped.
+        with pytest.raises(InvalidRequest, match="needs this column"):
+            cql.execute(f"ALTER TABLE {table} DROP x")
@@ -331,6 +331,44 @@ def test_static_row_tombstone_span(cql, test_keyspace, lowered_tombstone_limit,
         check_pages_many_partitions(cql.execute(statement), {0: all_pks[0], -1: all_pks[-1]})
 
 
+# Rows which replicas filter out themselves count like tombstones, so a
+# filtering query which matches almost no rows still gets its pages cut.
+def test_filtered_out_rows_prefix(cql, table, lowered_tombstone_limit, driver_bug_1):
+    insert_row_id = cql.prepare(f"INSERT INTO {table} (pk, ck, v) VALUES (?, ?, ?)")
+
+    pk = unique_key_int()
+
+    for ck in range(0, 30):
+        cql.execute(insert_row_id, (pk, ck, 1))
+
+    cql.execute(insert_row_id, (pk, 31, 0))
+
+    statement = SimpleStatement(f"SELECT * FROM {table} WHERE pk = {pk} AND v = 0 ALLOW FILTERING", fetch_size=10)
+    check_pages_single_partition(cql.execute(statement), [
+        [],
+        [],
+        [],
+        [31]
+    ])
+
+
+@pytest.mark.parametrize("test_keyspace", ["tablets", "vnodes"], indirect=True)
+def test_filtered_out_rows_span(cql, test_keyspace, lowered_tombstone_limit, driver_bug_1):
+    with new_test_table(cql, test_keyspace, 'pk int, ck int, v int, PRIMARY KEY (pk, ck)') as table:
+        insert_row_id = cql.prepare(f"INSERT INTO {table} (pk, ck, v) VALUES (?, ?, ?)")
+
+        for pk in range(0, 400):
+            cql.execute(insert_row_id, (pk, 0, 1))
+
+        all_pks = get_all_pks(cql, table)
+
+        for pk in (all_pks[0], all_pks[-1]):
+            cql.execute(insert_row_id, (pk, 0, 0))
+
+        statement = SimpleStatement(f"SELECT * FROM {table} WHERE v = 0 ALLOW FILTERING", fetch_size=10)
+        check_pages_many_partitions(cql.execute(statement), {0: all_pks[0], -1: all_pks[-1]})
+
+
 # Sanity check that empty pages support didn't mess up truly empty results.
 def test_empty_table(cql, test_keyspace, lowered_tombstone_limit, driver_bug_1):
     with new_test_table(cql, test_keyspace, 'pk int, ck int, v int, PRIMARY KEY (pk, ck)') as table:
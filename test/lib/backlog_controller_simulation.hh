@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "backlog_controller.hh"
+
+namespace tests {
+
+struct backlog_simulation_step {
+    float backlog;
+    float output;
+};
+
+// Replays a backlog trace through a pid_controller in closed loop, so the
+// behaviour of the controller can be checked offline.
+//
+// incoming[i] is the (normalized) backlog added during the i-th interval of dt
+// seconds, e.g. recorded from a node's backlog metric. At full output, the
+// controlled process consumes drain_rate backlog per second.
+inline std::vector<backlog_simulation_step> simulate_backlog_controller(const std::vector<float>& incoming, float target,
+        float dt, float drain_rate, pid_gains gains) {
+    pid_controller pid;
+    std::vector<backlog_simulation_step> steps;
+    steps.reserve(incoming.size());
+    float backlog = 0;
+    float output = 0;
+    for (auto added : incoming) {
+        backlog = std::max(backlog + added - output * drain_rate * dt, 0.0f);
+        output = pid.update(backlog, target, dt, gains);
+        steps.push_back({backlog, output});
+    }
+    return steps;
+}
+
+} // namespace tests
@@ -105,6 +105,7 @@ cql_test_config::cql_test_config(shared_ptr<db::config> cfg)
 
     db_config->add_cdc_extension();
     db_config->add_per_partition_rate_limit_extension();
+    db_config->add_sstable_value_index_extension();
     db_config->add_tags_extension();
     db_config->add_tombstone_gc_extension();
 
@@ -596,7 +597,16 @@ class single_node_cql_env : public cql_test_env {
                     .maintenance_sched_group = compaction_manager::scheduling_group{dbcfg.streaming_scheduling_group},
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
+                    .controller_feedback = {
+                        .target_backlog = cfg->compaction_controller_target_backlog,
+                        .kp = cfg->backlog_controller_proportional_gain,
+                        .ki = cfg->backlog_controller_integral_gain,
+                        .kd = cfg->backlog_controller_derivative_gain,
+                    },
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .pipeline_depth = cfg->compaction_pipeline_depth,
+                    .checkpoint_major = cfg->compaction_checkpoint_major,
+                    .maintenance_batch_threshold_in_mb = cfg->compaction_maintenance_batch_threshold_in_mb,
                     .flush_all_tables_before_major = cfg->compaction_flush_all_tables_before_major_seconds() * 1s,
                 };
             });
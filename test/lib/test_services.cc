@@ -127,6 +127,15 @@ class table_for_tests::table_state : public compaction::table_state {
     dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override {
         return table().get_token_range_after_split(t);
     }
+    double sstables_per_read() const noexcept override {
+        return table().sstables_per_read();
+    }
+    double read_rate() const noexcept override {
+        return table().get_stats().reads().rate().rates[0];
+    }
+    double tombstones_per_read() const noexcept override {
+        return table().tombstones_scanned_per_read();
+    }
 };
 
 table_for_tests::data::data()
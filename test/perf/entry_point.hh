@@ -14,6 +14,7 @@
 
 namespace perf {
 
+int scylla_compaction_strategy_main(int argc, char** argv);
 int scylla_fast_forward_main(int argc, char** argv);
 int scylla_row_cache_update_main(int argc, char**argv);
 int scylla_simple_query_main(int argc, char** argv);
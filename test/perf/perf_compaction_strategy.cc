@@ -0,0 +1,451 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <fstream>
+#include <random>
+
+#include <boost/program_options/errors.hpp>
+#include <json/json.h>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/thread.hh>
+
+#include "compaction/compaction.hh"
+#include "compaction/compaction_manager.hh"
+#include "compaction/compaction_strategy.hh"
+#include "compaction/strategy_control.hh"
+#include "compaction/table_state.hh"
+#include "replica/memtable.hh"
+#include "replica/memtable-sstable.hh"
+#include "schema/schema_builder.hh"
+#include "sstables/sstables.hh"
+#include "test/lib/log.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/test_services.hh"
+#include "test/perf/entry_point.hh"
+
+// Simulates the life of a table under a given compaction strategy and workload.
+//
+// Each step of the simulation flushes one memtable worth of writes generated by the
+// workload, then runs the compactions picked by the strategy until it has none left,
+// like a compaction manager with unlimited bandwidth would. The amplification of the
+// strategy is measured along the way:
+//
+// - write amplification: bytes written by flushes and compactions, divided by the
+//   bytes written by flushes,
+// - space amplification: size of the table on disk, divided by its size once all of
+//   it is compacted into a single sstable,
+// - read amplification: number of sstables a single-partition read of a key drawn
+//   from the workload would have to read, i.e. those whose token range and bloom
+//   filter contain the key.
+//
+// SSTables are written to the test environment's temporary directory, which can be
+// put on tmpfs with TMPDIR to take the disk out of the throughput measurements.
+
+using namespace sstables;
+
+namespace {
+
+enum class workload {
+    // New rows in partitions chosen uniformly.
+    uniform,
+    // New rows in partitions chosen with a zipfian distribution, a few partitions get most of the writes.
+    zipfian,
+    // A few partitions get rows clustered by time with a TTL, older data expires as the simulation advances.
+    time_series,
+    // Overwrites of a single row in partitions chosen uniformly.
+    overwrite,
+};
+
+const std::unordered_map<sstring, workload> workloads = {
+    {"uniform", workload::uniform},
+    {"zipfian", workload::zipfian},
+    {"time_series", workload::time_series},
+    {"overwrite", workload::overwrite},
+};
+
+sstring workload_name(workload w) {
+    for (auto& [name, value] : workloads) {
+        if (value == w) {
+            return name;
+        }
+    }
+    abort();
+}
+
+struct simulation_config {
+    compaction_strategy_type strategy;
+    std::map<sstring, sstring> strategy_options;
+    workload wl;
+    unsigned flushes;
+    unsigned rows_per_flush;
+    unsigned partitions;
+    unsigned value_size;
+    std::chrono::seconds flush_interval;
+    std::chrono::seconds ttl;
+    unsigned read_samples;
+};
+
+struct step_result {
+    unsigned step;
+    unsigned sstables;
+    uint64_t disk_size;
+    double backlog_before_compaction;
+    double backlog_after_compaction;
+    unsigned compactions;
+    double read_amplification;
+};
+
+struct simulation_result {
+    uint64_t flushed_bytes = 0;
+    uint64_t compaction_input_bytes = 0;
+    uint64_t compaction_output_bytes = 0;
+    uint64_t compactions = 0;
+    std::chrono::duration<double> compaction_time{0};
+    uint64_t max_disk_size = 0;
+    uint64_t final_disk_size = 0;
+    uint64_t compacted_size = 0;
+    double mean_read_amplification = 0;
+    std::vector<step_result> steps;
+};
+
+class simulation_strategy_control : public compaction::strategy_control {
+public:
+    bool has_ongoing_compaction(table_state& table_s) const noexcept override {
+        return false;
+    }
+    std::vector<sstables::shared_sstable> candidates(table_state& t) const override {
+        return *t.main_sstable_set().all() | std::ranges::to<std::vector>();
+    }
+    std::vector<sstables::frozen_sstable_run> candidates_as_runs(table_state& t) const override {
+        return t.main_sstable_set().all_sstable_runs();
+    }
+};
+
+class simulation {
+    test_env& _env;
+    const simulation_config& _cfg;
+    schema_ptr _schema;
+    table_for_tests _table;
+    simulation_strategy_control _control;
+    std::mt19937 _rng;
+    std::discrete_distribution<unsigned> _zipfian;
+    int64_t _next_clustering = 0;
+    simulation_result _result;
+private:
+    schema_ptr make_schema() const {
+        auto builder = schema_builder("ks", "cf")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", long_type, column_kind::clustering_key)
+                .with_column("v", bytes_type);
+        builder.set_compaction_strategy(_cfg.strategy);
+        builder.set_compaction_strategy_options(std::map<sstring, sstring>(_cfg.strategy_options));
+        // Let compaction purge expired data right away.
+        builder.set_gc_grace_seconds(0);
+        return builder.build();
+    }
+
+    static std::discrete_distribution<unsigned> make_zipfian(unsigned n) {
+        static constexpr double exponent = 0.99;
+        std::vector<double> weights(n);
+        for (unsigned i = 0; i < n; ++i) {
+            weights[i] = 1 / std::pow(i + 1, exponent);
+        }
+        return std::discrete_distribution<unsigned>(weights.begin(), weights.end());
+    }
+
+    unsigned partition_count() const {
+        // Time series have few partitions (e.g. sensors), each getting many rows.
+        return _cfg.wl == workload::time_series ? std::max(_cfg.partitions / 100, 1u) : _cfg.partitions;
+    }
+
+    unsigned next_partition() {
+        if (_cfg.wl == workload::zipfian) {
+            return _zipfian(_rng);
+        }
+        return std::uniform_int_distribution<unsigned>(0, partition_count() - 1)(_rng);
+    }
+
+    dht::decorated_key make_key(unsigned pk) const {
+        return dht::decorate_key(*_schema, partition_key::from_single_value(*_schema, int32_type->decompose(int32_t(pk))));
+    }
+
+    // Writes of step i happen at now - (flushes - i) * flush_interval, so that
+    // time-series data expires as the simulation approaches the present.
+    gc_clock::time_point write_time(unsigned step) const {
+        return gc_clock::now() - (_cfg.flushes - step) * _cfg.flush_interval;
+    }
+
+    lw_shared_ptr<replica::memtable> make_memtable(unsigned step) {
+        auto mt = make_lw_shared<replica::memtable>(_schema);
+        auto& v_def = *_schema->get_column_definition("v");
+        auto now = write_time(step);
+        auto ts = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+        for (unsigned i = 0; i < _cfg.rows_per_flush; ++i) {
+            auto value = tests::random::get_bytes(_cfg.value_size);
+            mutation m(_schema, make_key(next_partition()));
+            if (_cfg.wl == workload::time_series) {
+                auto ck = clustering_key::from_single_value(*_schema, long_type->decompose(int64_t(ts + i)));
+                m.set_clustered_cell(ck, v_def, atomic_cell::make_live(*bytes_type, ts, bytes_view(value), now + _cfg.ttl, _cfg.ttl));
+            } else {
+                auto ck_value = _cfg.wl == workload::overwrite ? int64_t(0) : _next_clustering++;
+                auto ck = clustering_key::from_single_value(*_schema, long_type->decompose(ck_value));
+                m.set_clustered_cell(ck, v_def, atomic_cell::make_live(*bytes_type, ts, bytes_view(value)));
+            }
+            mt->apply(std::move(m));
+        }
+        return mt;
+    }
+
+    void flush(unsigned step) {
+        auto mt = make_memtable(step);
+        auto sst = _env.make_sstable(_schema);
+        replica::write_memtable_to_sstable(*mt, sst).get();
+        sst->open_data(sstable_open_config{ .load_first_and_last_position_metadata = true }).get();
+        _result.flushed_bytes += sst->bytes_on_disk();
+        _table->add_sstable_and_update_cache(sst).get();
+    }
+
+    compaction_result compact(compaction_descriptor descriptor) {
+        auto& table_s = _table.as_table_state();
+        auto sst_factory = _env.make_sst_factory(_schema);
+        descriptor.creator = [sst_factory] (shard_id) {
+            return sst_factory();
+        };
+        descriptor.replacer = [] (compaction_completion_desc) {};
+        descriptor.enable_garbage_collection(table_s.main_sstable_set());
+        auto old_sstables = descriptor.sstables;
+        auto cdata = compaction_manager::create_compaction_data();
+        compaction_progress_monitor progress_monitor;
+        auto res = sstables::compact_sstables(std::move(descriptor), cdata, table_s, progress_monitor).get();
+        table_s.on_compaction_completion(compaction_completion_desc{ .old_sstables = old_sstables, .new_sstables = res.new_sstables }, offstrategy::no).get();
+        return res;
+    }
+
+    unsigned compact_until_done() {
+        static constexpr unsigned max_compactions_per_step = 1000;
+        auto& table_s = _table.as_table_state();
+        unsigned compactions = 0;
+        while (compactions < max_compactions_per_step) {
+            auto descriptor = table_s.get_compaction_strategy().get_sstables_for_compaction(table_s, _control);
+            if (descriptor.sstables.empty()) {
+                break;
+            }
+            auto start = std::chrono::steady_clock::now();
+            auto res = compact(std::move(descriptor));
+            _result.compaction_time += std::chrono::steady_clock::now() - start;
+            _result.compaction_input_bytes += res.stats.start_size;
+            _result.compaction_output_bytes += res.stats.end_size;
+            ++compactions;
+        }
+        _result.compactions += compactions;
+        return compactions;
+    }
+
+    uint64_t disk_size() {
+        auto& set = _table.as_table_state().main_sstable_set();
+        uint64_t size = 0;
+        set.for_each_sstable([&] (const shared_sstable& sst) {
+            size += sst->bytes_on_disk();
+        });
+        return size;
+    }
+
+    double read_amplification() {
+        auto& set = _table.as_table_state().main_sstable_set();
+        uint64_t touched = 0;
+        for (unsigned i = 0; i < _cfg.read_samples; ++i) {
+            auto dk = make_key(next_partition());
+            for (auto& sst : set.select(dht::partition_range::make_singular(dk))) {
+                touched += sst->filter_has_key(*_schema, dk.key());
+            }
+        }
+        return double(touched) / std::max(_cfg.read_samples, 1u);
+    }
+
+    double backlog() {
+        return _table.as_table_state().get_backlog_tracker().backlog();
+    }
+public:
+    simulation(test_env& env, const simulation_config& cfg)
+        : _env(env)
+        , _cfg(cfg)
+        , _schema(make_schema())
+        , _table(env.make_table_for_tests(_schema))
+        , _rng(tests::random::get_int<uint32_t>())
+        , _zipfian(make_zipfian(partition_count()))
+    {
+        _table->start();
+        _table->set_compaction_strategy(_cfg.strategy);
+    }
+
+    simulation_result run() {
+        double read_amplification_sum = 0;
+        for (unsigned step = 0; step < _cfg.flushes; ++step) {
+            flush(step);
+            auto backlog_before = backlog();
+            auto compactions = compact_until_done();
+            auto size = disk_size();
+            auto read_amp = read_amplification();
+            read_amplification_sum += read_amp;
+            _result.max_disk_size = std::max(_result.max_disk_size, size);
+            _result.steps.push_back(step_result{
+                .step = step,
+                .sstables = unsigned(_table.as_table_state().main_sstable_set().size()),
+                .disk_size = size,
+                .backlog_before_compaction = backlog_before,
+                .backlog_after_compaction = backlog(),
+                .compactions = compactions,
+                .read_amplification = read_amp,
+            });
+        }
+        _result.mean_read_amplification = read_amplification_sum / std::max(_cfg.flushes, 1u);
+        _result.final_disk_size = disk_size();
+
+        // The size of the data once fully compacted is the reference for space amplification.
+        auto all = *_table.as_table_state().main_sstable_set().all() | std::ranges::to<std::vector>();
+        if (!all.empty()) {
+            auto res = compact(compaction_descriptor(std::move(all)));
+            _result.compacted_size = res.stats.end_size;
+        }
+        _table.stop().get();
+        return std::move(_result);
+    }
+};
+
+double ratio(uint64_t a, uint64_t b) {
+    return b ? double(a) / b : 0;
+}
+
+Json::Value to_json(const simulation_config& cfg, const simulation_result& res) {
+    Json::Value result;
+    result["strategy"] = std::string(compaction_strategy::name(cfg.strategy));
+    result["workload"] = std::string(workload_name(cfg.wl));
+
+    Json::Value stats;
+    stats["flushed_bytes"] = Json::UInt64(res.flushed_bytes);
+    stats["compaction_input_bytes"] = Json::UInt64(res.compaction_input_bytes);
+    stats["compaction_output_bytes"] = Json::UInt64(res.compaction_output_bytes);
+    stats["compactions"] = Json::UInt64(res.compactions);
+    stats["write_amplification"] = ratio(res.flushed_bytes + res.compaction_output_bytes, res.flushed_bytes);
+    stats["space_amplification"] = ratio(res.final_disk_size, res.compacted_size);
+    stats["max_space_amplification"] = ratio(res.max_disk_size, res.compacted_size);
+    stats["read_amplification"] = res.mean_read_amplification;
+    stats["final_read_amplification"] = res.steps.empty() ? 0 : res.steps.back().read_amplification;
+    stats["compaction_throughput_bytes_per_second"] = res.compaction_time.count() ? res.compaction_input_bytes / res.compaction_time.count() : 0;
+    result["stats"] = std::move(stats);
+
+    Json::Value steps(Json::arrayValue);
+    for (auto& step : res.steps) {
+        Json::Value s;
+        s["step"] = step.step;
+        s["sstables"] = step.sstables;
+        s["disk_size"] = Json::UInt64(step.disk_size);
+        s["backlog_before_compaction"] = step.backlog_before_compaction;
+        s["backlog_after_compaction"] = step.backlog_after_compaction;
+        s["compactions"] = step.compactions;
+        s["read_amplification"] = step.read_amplification;
+        steps.append(std::move(s));
+    }
+    result["steps"] = std::move(steps);
+    return result;
+}
+
+std::map<sstring, sstring> parse_strategy_options(const std::vector<sstring>& options) {
+    std::map<sstring, sstring> ret;
+    for (auto& option : options) {
+        auto pos = option.find('=');
+        if (pos == sstring::npos) {
+            throw boost::program_options::invalid_option_value(option);
+        }
+        ret.emplace(option.substr(0, pos), option.substr(pos + 1));
+    }
+    return ret;
+}
+
+} // anonymous namespace
+
+namespace perf {
+
+int scylla_compaction_strategy_main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("strategy", bpo::value<std::vector<sstring>>()->default_value({
+                "SizeTieredCompactionStrategy", "LeveledCompactionStrategy", "TimeWindowCompactionStrategy",
+                "IncrementalCompactionStrategy", "UnifiedCompactionStrategy"}, ""),
+            "compaction strategies to simulate, can be given multiple times")
+        ("strategy-option", bpo::value<std::vector<sstring>>()->default_value({}, ""),
+            "option of the simulated strategies, as name=value, can be given multiple times")
+        ("workload", bpo::value<std::vector<sstring>>()->default_value({"uniform", "zipfian", "time_series", "overwrite"}, ""),
+            "workloads to simulate, one of: uniform, zipfian, time_series, overwrite, can be given multiple times")
+        ("flushes", bpo::value<unsigned>()->default_value(64), "number of memtable flushes to simulate")
+        ("rows-per-flush", bpo::value<unsigned>()->default_value(10000), "number of rows written by each flush")
+        ("partitions", bpo::value<unsigned>()->default_value(100000), "number of distinct partitions written to")
+        ("value-size", bpo::value<unsigned>()->default_value(100), "size in bytes of the value of each row")
+        ("flush-interval", bpo::value<unsigned>()->default_value(3600), "simulated time between flushes, in seconds")
+        ("ttl", bpo::value<unsigned>()->default_value(86400), "TTL of the rows of the time_series workload, in seconds")
+        ("read-samples", bpo::value<unsigned>()->default_value(1000), "number of keys sampled to measure read amplification")
+        ("json-result", bpo::value<std::string>(), "name of the json result file, results are written to the standard output if not given")
+        ("verbose", "Enables standard logging")
+        ;
+
+    return app.run(argc, argv, [&] {
+        return seastar::async([&] {
+            auto& opts = app.configuration();
+            if (!opts.contains("verbose")) {
+                auto testlog_level = logging::logger_registry().get_logger_level("testlog");
+                logging::logger_registry().set_all_loggers_level(seastar::log_level::warn);
+                logging::logger_registry().set_logger_level("testlog", testlog_level);
+            }
+            auto strategy_options = parse_strategy_options(opts["strategy-option"].as<std::vector<sstring>>());
+
+            std::vector<simulation_config> configs;
+            for (auto& strategy : opts["strategy"].as<std::vector<sstring>>()) {
+                for (auto& wl : opts["workload"].as<std::vector<sstring>>()) {
+                    auto it = workloads.find(wl);
+                    if (it == workloads.end()) {
+                        throw bpo::invalid_option_value(wl);
+                    }
+                    configs.push_back(simulation_config{
+                        .strategy = compaction_strategy::type(strategy),
+                        .strategy_options = strategy_options,
+                        .wl = it->second,
+                        .flushes = opts["flushes"].as<unsigned>(),
+                        .rows_per_flush = opts["rows-per-flush"].as<unsigned>(),
+                        .partitions = std::max(opts["partitions"].as<unsigned>(), 1u),
+                        .value_size = opts["value-size"].as<unsigned>(),
+                        .flush_interval = std::chrono::seconds(opts["flush-interval"].as<unsigned>()),
+                        .ttl = std::chrono::seconds(opts["ttl"].as<unsigned>()),
+                        .read_samples = opts["read-samples"].as<unsigned>(),
+                    });
+                }
+            }
+
+            Json::Value results(Json::arrayValue);
+            test_env::do_with_async([&] (test_env& env) {
+                for (auto& cfg : configs) {
+                    testlog.info("Simulating {} with the {} workload", compaction_strategy::name(cfg.strategy), workload_name(cfg.wl));
+                    auto res = simulation(env, cfg).run();
+                    results.append(to_json(cfg, res));
+                }
+            }).get();
+
+            if (opts.contains("json-result")) {
+                auto out = std::ofstream(opts["json-result"].as<std::string>());
+                out << results;
+            } else {
+                std::cout << results << std::endl;
+            }
+        });
+    });
+}
+
+} // namespace perf
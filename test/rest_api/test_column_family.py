@@ -2,13 +2,14 @@
 #
 # SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
 
+import json
 import pytest
 import sys
 import requests
 import threading
 import time
 
-from ..cqlpy.util import new_test_table, new_test_keyspace
+from ..cqlpy.util import new_test_table, new_test_keyspace, config_value_context
 from test.rest_api.rest_util import scylla_inject_error
 
 def do_test_column_family_attribute_api_table(cql, this_dc, rest_api, api_name):
@@ -146,3 +147,108 @@ def test_column_family_compaction_strategy(cql, this_dc, rest_api):
                 resp = rest_api.send("POST", f"column_family/compaction_strategy/{table_name}", params={"class_name": strategy})
                 resp.raise_for_status()
                 check_strategy(strategy)
+
+def test_column_family_export(cql, this_dc, rest_api):
+    ksdef = f"WITH REPLICATION = {{ 'class' : 'NetworkTopologyStrategy', '{this_dc}' : '1' }}"
+    with new_test_keyspace(cql, ksdef) as test_keyspace:
+        with new_test_table(cql, test_keyspace, "p int, c int, v int, PRIMARY KEY (p, c)") as t:
+            table_name = t.replace('.', ':')
+            for p in range(10):
+                for c in range(3):
+                    cql.execute(f"INSERT INTO {t} (p, c, v) VALUES ({p}, {c}, {p * c})")
+            cql.execute(f"DELETE FROM {t} WHERE p = 0 AND c = 0")
+
+            def export(**params):
+                resp = rest_api.send("GET", f"column_family/export/{table_name}", params=params)
+                resp.raise_for_status()
+                return [json.loads(line) for line in resp.text.splitlines()]
+
+            rows = export()
+            assert len(rows) == 29
+            tokens = [int(r['partition_key']['token']) for r in rows]
+            assert tokens == sorted(tokens)
+            assert {(r['partition_key']['value'], r['clustering_key']['value'], r['columns']['v']) for r in rows} == \
+                {(str(p), str(c), str(p * c)) for p in range(10) for c in range(3) if (p, c) != (0, 0)}
+
+            # Resume the export after the first partition.
+            first_token = rows[0]['partition_key']['token']
+            resumed = export(start_token=first_token)
+            assert resumed == [r for r in rows if r['partition_key']['token'] != first_token]
+
+            resp = rest_api.send("GET", f"column_family/export/{table_name}", params={"start_token": "not-a-token"})
+            assert resp.status_code == requests.codes.bad_request
+
+# An export interrupted in the middle of a partition is resumed right after
+# the last row received, whether it is a static or a clustering row.
+def test_column_family_export_resume_mid_partition(cql, this_dc, rest_api):
+    ksdef = f"WITH REPLICATION = {{ 'class' : 'NetworkTopologyStrategy', '{this_dc}' : '1' }}"
+    with new_test_keyspace(cql, ksdef) as test_keyspace:
+        with new_test_table(cql, test_keyspace, "p int, c int, s int STATIC, v int, PRIMARY KEY (p, c)") as t:
+            table_name = t.replace('.', ':')
+            for p in range(4):
+                if p % 2 == 0:
+                    cql.execute(f"INSERT INTO {t} (p, s) VALUES ({p}, {p})")
+                for c in range(4):
+                    cql.execute(f"INSERT INTO {t} (p, c, v) VALUES ({p}, {c}, {p * c})")
+
+            def export(**params):
+                resp = rest_api.send("GET", f"column_family/export/{table_name}", params=params)
+                resp.raise_for_status()
+                return [json.loads(line) for line in resp.text.splitlines()]
+
+            rows = export()
+            assert len(rows) == 18
+            for i in range(1, len(rows) + 1):
+                last = rows[i - 1]
+                params = {"after_partition_key": last['partition_key']['raw']}
+                if 'clustering_key' in last:
+                    params["after_clustering_key"] = last['clustering_key']['raw']
+                assert rows[:i] + export(**params) == rows, f"resuming after row {i - 1}: {last}"
+
+            # The cursor doesn't need to be an exported row.
+            # Clustering key 99 is past all the rows of the partition.
+            missing = rows[1]['partition_key']['raw']
+            after_all = rows[1]['clustering_key']['raw'][:-8] + "00000063"
+            resumed = export(after_partition_key=missing, after_clustering_key=after_all)
+            assert resumed == [r for r in rows[1:] if r['partition_key']['raw'] != missing]
+
+            for params in [{"after_partition_key": "zz"},
+                           {"after_clustering_key": rows[1]['clustering_key']['raw']},
+                           {"after_partition_key": rows[0]['partition_key']['raw'], "start_token": rows[0]['partition_key']['token']}]:
+                resp = rest_api.send("GET", f"column_family/export/{table_name}", params=params)
+                assert resp.status_code == requests.codes.bad_request, params
+
+# Deleted data must not be exported, also when the streaming reader doesn't
+# compact the data itself.
+@pytest.mark.parametrize("compacting", ["true", "false"])
+def test_column_family_export_deleted_data(cql, this_dc, rest_api, compacting):
+    ksdef = f"WITH REPLICATION = {{ 'class' : 'NetworkTopologyStrategy', '{this_dc}' : '1' }}"
+    with new_test_keyspace(cql, ksdef) as test_keyspace:
+        with new_test_table(cql, test_keyspace, "p int, c int, v int, s set<int>, PRIMARY KEY (p, c)") as t:
+            table_name = t.replace('.', ':')
+            for p in range(4):
+                for c in range(5):
+                    cql.execute(f"INSERT INTO {t} (p, c, v, s) VALUES ({p}, {c}, {p * c}, {{1, 2}})")
+            cql.execute(f"DELETE FROM {t} WHERE p = 0")
+            cql.execute(f"DELETE FROM {t} WHERE p = 1 AND c >= 1 AND c < 4")
+            cql.execute(f"DELETE FROM {t} WHERE p = 2 AND c = 2")
+            cql.execute(f"DELETE v FROM {t} WHERE p = 3 AND c = 0")
+            cql.execute(f"UPDATE {t} SET s = s - {{1}} WHERE p = 3 AND c = 1")
+
+            with config_value_context(cql, 'enable_compacting_data_for_streaming_and_repair', compacting):
+                resp = rest_api.send("GET", f"column_family/export/{table_name}")
+                resp.raise_for_status()
+                rows = [json.loads(line) for line in resp.text.splitlines()]
+
+            def columns(p, c):
+                if (p, c) == (3, 0):
+                    return {'s': ['1', '2']}
+                if (p, c) == (3, 1):
+                    return {'v': str(p * c), 's': ['2']}
+                return {'v': str(p * c), 's': ['1', '2']}
+            expected = {(p, c) for p in range(1, 4) for c in range(5) if not (p == 1 and 1 <= c < 4) and (p, c) != (2, 2)}
+            assert {(int(r['partition_key']['value']), int(r['clustering_key']['value'])) for r in rows} == expected
+            for r in rows:
+                key = (int(r['partition_key']['value']), int(r['clustering_key']['value']))
+                assert set(r['columns']) == set(columns(*key))
+                assert r['columns'].get('v') == columns(*key).get('v')
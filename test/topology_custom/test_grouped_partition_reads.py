@@ -0,0 +1,162 @@
+#
+# Copyright (C) 2024-present ScyllaDB
+#
+# SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+#
+from test.pylib.manager_client import ManagerClient
+from test.pylib.rest_client import inject_error
+from test.pylib.util import wait_for_cql_and_get_hosts
+from test.topology.conftest import skip_mode
+
+import contextlib
+import logging
+import pytest
+import time
+from cassandra import ConsistencyLevel
+from cassandra.query import SimpleStatement
+
+logger = logging.getLogger(__name__)
+
+partition_count = 50
+ck_count = 4
+
+
+async def create_cluster(manager: ManagerClient, speculative_retry: str = "NONE"):
+    servers = await manager.servers_add(3)
+    cql = manager.get_cql()
+    # All reads are coordinated by the first node, which reads the partitions
+    # it doesn't own from the other two, so these are grouped.
+    host = (await wait_for_cql_and_get_hosts(cql, [servers[0]], time.time() + 60))[0]
+    await cql.run_async("CREATE KEYSPACE ks WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 2}")
+    await cql.run_async(f"CREATE TABLE ks.tab (pk int, ck int, s int STATIC, v int, PRIMARY KEY (pk, ck)) WITH speculative_retry = '{speculative_retry}'")
+
+    # Every third partition is deleted, and every fifth has no clustering rows.
+    insert_stmt = cql.prepare("INSERT INTO ks.tab (pk, ck, v) VALUES (?, ?, ?)")
+    for pk in range(partition_count):
+        await cql.run_async("INSERT INTO ks.tab (pk, s) VALUES (%s, %s)", [pk, -pk])
+        if pk % 5 != 0:
+            for ck in range(ck_count):
+                await cql.run_async(insert_stmt, [pk, ck, pk * ck])
+        if pk % 3 == 0:
+            await cql.run_async("DELETE FROM ks.tab WHERE pk = %s", [pk])
+    return servers, cql, host
+
+
+# A partition with only a static row is returned only if the query doesn't restrict the clustering key.
+def expected_rows(pks, ck_filter=None, per_partition_limit=None):
+    rows = []
+    for pk in sorted(set(pks)):
+        if pk >= partition_count or pk % 3 == 0:
+            continue
+        if pk % 5 == 0:
+            if ck_filter:
+                continue
+            partition = [(pk, None, -pk, None)]
+        else:
+            partition = [(pk, ck, -pk, pk * ck) for ck in range(ck_count) if not ck_filter or ck_filter(ck)]
+        rows += partition[:per_partition_limit]
+    return rows
+
+
+async def get_grouped_reads(manager: ManagerClient, server) -> int:
+    metrics = await manager.metrics.query(server.ip_addr)
+    return int(metrics.get('scylla_storage_proxy_coordinator_grouped_partition_reads') or 0)
+
+
+async def select(cql, host, restriction: str, fetch_size=None, using: str = ""):
+    query = SimpleStatement(f"SELECT pk, ck, s, v FROM ks.tab WHERE {restriction} {using}",
+                            consistency_level=ConsistencyLevel.ONE, fetch_size=fetch_size)
+    rows = [(r.pk, r.ck, r.s, r.v) for r in await cql.run_async(query, host=host, all_pages=True)]
+    # Partitions of IN queries come in the token order.
+    return sorted(rows, key=lambda r: (r[0], -1 if r[1] is None else r[1]))
+
+
+# Checks that partitions read with grouped requests return the same rows as
+# when each partition is read on its own, for live, deleted, missing and
+# static-only partitions, with clustering restrictions, limits and paging.
+@pytest.mark.asyncio
+async def test_grouped_partition_reads(manager: ManagerClient) -> None:
+    servers, cql, host = await create_cluster(manager)
+
+    pks = list(range(partition_count + 10))
+    in_list = ", ".join(str(pk) for pk in pks)
+    queries = [
+        (f"pk IN ({in_list})", {}, expected_rows(pks)),
+        (f"pk IN ({in_list}) AND ck >= 1 AND ck < 3", {}, expected_rows(pks, ck_filter=lambda ck: 1 <= ck < 3)),
+        (f"pk IN ({in_list}) PER PARTITION LIMIT 2", {}, expected_rows(pks, per_partition_limit=2)),
+        (f"pk IN ({in_list})", {'fetch_size': 7}, expected_rows(pks)),
+    ]
+    for restriction, kwargs, expected in queries:
+        grouped_before = await get_grouped_reads(manager, servers[0])
+        assert await select(cql, host, restriction, **kwargs) == expected, restriction
+        assert await get_grouped_reads(manager, servers[0]) > grouped_before, restriction
+
+    await manager.server_update_config(servers[0].server_id, 'enable_grouped_partition_reads', False)
+    for restriction, kwargs, expected in queries:
+        grouped_before = await get_grouped_reads(manager, servers[0])
+        assert await select(cql, host, restriction, **kwargs) == expected, restriction
+        assert await get_grouped_reads(manager, servers[0]) == grouped_before, restriction
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+@contextlib.asynccontextmanager
+async def inject_on_replicas(manager: ManagerClient, servers, parameters: dict = {}):
+    async with contextlib.AsyncExitStack() as stack:
+        handlers = [await stack.enter_async_context(inject_error(manager.api, s.ip_addr, 'storage_proxy::handle_read_data_multi',
+                                                                 parameters=parameters)) for s in servers]
+        yield handlers
+        for handler in handlers:
+            await handler.message()
+
+
+# Checks that if the grouped request fails, the partitions are read on their
+# own and the query still returns all of them.
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_grouped_partition_reads_failure(manager: ManagerClient) -> None:
+    servers, cql, host = await create_cluster(manager)
+
+    pks = list(range(partition_count))
+    async with inject_on_replicas(manager, servers[1:], {'fail': '1'}):
+        grouped_before = await get_grouped_reads(manager, servers[0])
+        assert await select(cql, host, f"pk IN ({', '.join(map(str, pks))})") == expected_rows(pks)
+        assert await get_grouped_reads(manager, servers[0]) > grouped_before
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+# Checks that a grouped request which doesn't get a response leaves enough of
+# the query's time for the partitions to be read on their own.
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_grouped_partition_reads_timeout(manager: ManagerClient) -> None:
+    servers, cql, host = await create_cluster(manager)
+
+    pks = list(range(partition_count))
+    async with inject_on_replicas(manager, servers[1:]):
+        start = time.time()
+        assert await select(cql, host, f"pk IN ({', '.join(map(str, pks))})", using="USING TIMEOUT 6s") == expected_rows(pks)
+        # The grouped request times out after half of the query timeout.
+        assert time.time() - start >= 3
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+# Checks that when the replica doesn't respond to the grouped request within
+# the speculative retry delay, the partitions are read without waiting for it.
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_grouped_partition_reads_speculative_retry(manager: ManagerClient) -> None:
+    servers, cql, host = await create_cluster(manager, speculative_retry="100ms")
+
+    pks = list(range(partition_count))
+    async with inject_on_replicas(manager, servers[1:]):
+        start = time.time()
+        grouped_before = await get_grouped_reads(manager, servers[0])
+        assert await select(cql, host, f"pk IN ({', '.join(map(str, pks))})", using="USING TIMEOUT 60s") == expected_rows(pks)
+        assert await get_grouped_reads(manager, servers[0]) > grouped_before
+        # Much sooner than the 30s timeout of the grouped request.
+        assert time.time() - start < 20
+
+    await cql.run_async("DROP KEYSPACE ks")
@@ -0,0 +1,168 @@
+#
+# Copyright (C) 2024-present ScyllaDB
+#
+# SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+#
+from test.pylib.manager_client import ManagerClient
+from test.pylib.rest_client import inject_error
+from test.pylib.util import wait_for, wait_for_cql_and_get_hosts
+from test.topology.conftest import skip_mode
+
+import asyncio
+import logging
+import pytest
+import time
+from cassandra import ConsistencyLevel, WriteFailure
+from cassandra.protocol import WriteTimeout
+from cassandra.query import SimpleStatement
+
+logger = logging.getLogger(__name__)
+
+config = {
+    'enable_mutation_batching': True,
+    # A long window makes it very likely that concurrent writes share a batch.
+    'mutation_batching_max_delay_in_us': 5000,
+    'mutation_batching_max_mutations': 16,
+}
+
+
+async def create_cluster(manager: ManagerClient, tables: list[str]):
+    servers = await manager.servers_add(3, config=config)
+    cql = manager.get_cql()
+    # All writes are coordinated by the first node, so that the other two
+    # receive them in batches, and never apply them as a coordinator.
+    host = (await wait_for_cql_and_get_hosts(cql, [servers[0]], time.time() + 60))[0]
+    await cql.run_async("CREATE KEYSPACE ks WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 3}")
+    for table in tables:
+        await cql.run_async(f"CREATE TABLE ks.{table} (pk int PRIMARY KEY, v int)")
+    return servers, cql, host
+
+
+def insert(cql, host, table: str, pk: int, using: str = ""):
+    return cql.run_async(SimpleStatement(f"INSERT INTO ks.{table} (pk, v) VALUES ({pk}, {pk}) {using}",
+                                         consistency_level=ConsistencyLevel.ALL), host=host)
+
+
+async def check_rows(cql, host, table: str, pks: list[int]) -> None:
+    rows = await cql.run_async(SimpleStatement(f"SELECT pk, v FROM ks.{table}", consistency_level=ConsistencyLevel.ALL), host=host)
+    assert sorted((r.pk, r.v) for r in rows) == [(pk, pk) for pk in pks]
+
+
+async def get_batched_mutations(manager: ManagerClient, server) -> int:
+    metrics = await manager.metrics.query(server.ip_addr)
+    return int(metrics.get('scylla_storage_proxy_coordinator_batched_mutations') or 0)
+
+
+# Checks that CL=ALL writes sent in MUTATION_BATCH messages are all applied
+# on every replica.
+@pytest.mark.asyncio
+async def test_mutation_batching(manager: ManagerClient) -> None:
+    servers, cql, host = await create_cluster(manager, ['tab'])
+
+    row_count = 1000
+    batched_before = await get_batched_mutations(manager, servers[0])
+    await asyncio.gather(*[insert(cql, host, 'tab', pk) for pk in range(row_count)])
+    await check_rows(cql, host, 'tab', list(range(row_count)))
+
+    # Every write is sent to the two other replicas.
+    assert await get_batched_mutations(manager, servers[0]) - batched_before >= 2 * row_count
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+# Checks that a write which fails on a replica fails only itself, and not
+# the other writes that were sent to that replica in the same batch.
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_mutation_batching_partial_failure(manager: ManagerClient) -> None:
+    servers, cql, host = await create_cluster(manager, ['good', 'bad'])
+
+    row_count = 200
+    batched_before = await get_batched_mutations(manager, servers[0])
+    async with inject_error(manager.api, servers[2].ip_addr, 'storage_proxy::handle_mutation_batch',
+                            parameters={'cf_name': 'bad', 'fail': '1'}):
+        results = await asyncio.gather(*[insert(cql, host, table, pk) for pk in range(row_count) for table in ['good', 'bad']],
+                                       return_exceptions=True)
+
+    good_results = results[0::2]
+    bad_results = results[1::2]
+    assert not [r for r in good_results if isinstance(r, Exception)]
+    assert all(isinstance(r, WriteFailure) for r in bad_results), [r for r in bad_results if not isinstance(r, WriteFailure)]
+    assert await get_batched_mutations(manager, servers[0]) - batched_before >= 2 * 2 * row_count
+
+    await check_rows(cql, host, 'good', list(range(row_count)))
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+# Checks that a write stuck on a replica doesn't delay the acknowledgement of
+# the writes batched with it, and that it times out on its own.
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_mutation_batching_slow_write(manager: ManagerClient) -> None:
+    servers, cql, host = await create_cluster(manager, ['fast', 'slow'])
+
+    row_count = 100
+    async with inject_error(manager.api, servers[2].ip_addr, 'storage_proxy::handle_mutation_batch',
+                            parameters={'cf_name': 'slow'}) as handler:
+        slow = []
+        fast = []
+        for pk in range(row_count):
+            slow.append(asyncio.ensure_future(insert(cql, host, 'slow', pk, "USING TIMEOUT 3s")))
+            fast.append(insert(cql, host, 'fast', pk))
+
+        # The fast writes complete while the slow ones are held on the replica.
+        await asyncio.gather(*fast)
+        assert not [f for f in slow if f.done()]
+
+        slow_results = await asyncio.gather(*slow, return_exceptions=True)
+        assert all(isinstance(r, WriteTimeout) for r in slow_results), [r for r in slow_results if not isinstance(r, WriteTimeout)]
+
+        await handler.message()
+
+    await check_rows(cql, host, 'fast', list(range(row_count)))
+
+    # Once the replica is no longer stuck, writes to the slow table succeed again.
+    await insert(cql, host, 'slow', row_count)
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+# Checks that the coordinators keep sending writes with the MUTATION verb
+# until every node supports MUTATION_BATCH, and switch to batching afterwards.
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_mutation_batching_mixed_cluster(manager: ManagerClient) -> None:
+    servers = await manager.servers_add(2, config=config)
+    old_server = await manager.server_add(config=config | {
+        'error_injections_at_startup': [{'name': 'suppress_features', 'value': 'MUTATION_BATCH_VERB'}],
+    })
+    cql = manager.get_cql()
+    host = (await wait_for_cql_and_get_hosts(cql, [servers[0]], time.time() + 60))[0]
+    await cql.run_async("CREATE KEYSPACE ks WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 3}")
+    await cql.run_async("CREATE TABLE ks.tab (pk int PRIMARY KEY, v int)")
+
+    row_count = 100
+    await asyncio.gather(*[insert(cql, host, 'tab', pk) for pk in range(row_count)])
+    await check_rows(cql, host, 'tab', list(range(row_count)))
+    for s in servers + [old_server]:
+        assert await get_batched_mutations(manager, s) == 0
+
+    # "Upgrade" the node which didn't support MUTATION_BATCH.
+    await manager.server_stop_gracefully(old_server.server_id)
+    await manager.server_update_config(old_server.server_id, 'error_injections_at_startup', [])
+    await manager.server_start(old_server.server_id)
+    await wait_for_cql_and_get_hosts(cql, servers + [old_server], time.time() + 60)
+
+    async def feature_enabled():
+        rows = await cql.run_async("SELECT enabled_features FROM system.topology", host=host)
+        if 'MUTATION_BATCH_VERB' in rows[0].enabled_features:
+            return True
+    await wait_for(feature_enabled, time.time() + 60)
+
+    batched_before = await get_batched_mutations(manager, servers[0])
+    await asyncio.gather(*[insert(cql, host, 'tab', pk) for pk in range(row_count, 2 * row_count)])
+    await check_rows(cql, host, 'tab', list(range(2 * row_count)))
+    assert await get_batched_mutations(manager, servers[0]) - batched_before >= 2 * row_count
+
+    await cql.run_async("DROP KEYSPACE ks")
@@ -0,0 +1,148 @@
+#
+# Copyright (C) 2024-present ScyllaDB
+#
+# SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+#
+from test.pylib.manager_client import ManagerClient
+from test.pylib.rest_client import inject_error
+from test.topology.conftest import skip_mode
+
+import contextlib
+import logging
+import pytest
+from cassandra import ConsistencyLevel, WriteFailure
+from cassandra.protocol import WriteTimeout
+from cassandra.query import SimpleStatement
+
+logger = logging.getLogger(__name__)
+
+key_count = 5
+
+
+async def create_cluster(manager: ManagerClient):
+    servers = await manager.servers_add(3)
+    cql = manager.get_cql()
+    await cql.run_async("CREATE KEYSPACE ks WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 3}"
+                        " AND tablets = {'enabled': false}")
+    await cql.run_async("CREATE TABLE ks.tab (pk int PRIMARY KEY, v int)")
+    for pk in range(key_count):
+        rows = await cql.run_async(f"INSERT INTO ks.tab (pk, v) VALUES ({pk}, 0) IF NOT EXISTS")
+        assert rows[0].applied
+    return servers, cql
+
+
+async def increment_all(cql, first: int, last: int) -> None:
+    for v in range(first, last):
+        for pk in range(key_count):
+            rows = await cql.run_async(f"UPDATE ks.tab SET v = {v + 1} WHERE pk = {pk} IF v = {v}")
+            assert rows[0].applied
+            # A condition on a stale value returns the current one.
+            rows = await cql.run_async(f"UPDATE ks.tab SET v = -1 WHERE pk = {pk} IF v = {v}")
+            assert not rows[0].applied
+            assert rows[0].v == v + 1
+
+
+async def check_values(cql, value: int) -> None:
+    rows = await cql.run_async(SimpleStatement("SELECT pk, v FROM ks.tab", consistency_level=ConsistencyLevel.ALL))
+    assert sorted((r.pk, r.v) for r in rows) == [(pk, value) for pk in range(key_count)]
+
+
+async def get_cache_stats(manager: ManagerClient, servers) -> tuple[int, int]:
+    hits = 0
+    misses = 0
+    for s in servers:
+        metrics = await manager.metrics.query(s.ip_addr)
+        hits += int(metrics.get('scylla_storage_proxy_replica_cas_state_cache_hits') or 0)
+        misses += int(metrics.get('scylla_storage_proxy_replica_cas_state_cache_misses') or 0)
+    return hits, misses
+
+
+async def set_cache_size(manager: ManagerClient, servers, size: int) -> None:
+    for s in servers:
+        await manager.server_update_config(s.server_id, 'paxos_state_cache_size', size)
+
+
+# Checks that once the paxos state of the keys is cached, LWT rounds no longer
+# read it from system.paxos, and still see every change made by the previous
+# rounds, also when the cache is turned off and on between rounds.
+@pytest.mark.asyncio
+async def test_paxos_state_cache(manager: ManagerClient) -> None:
+    servers, cql = await create_cluster(manager)
+
+    rounds = 10
+    await increment_all(cql, 0, rounds)
+    hits_before, misses_before = await get_cache_stats(manager, servers)
+    await increment_all(cql, rounds, 2 * rounds)
+    hits, misses = await get_cache_stats(manager, servers)
+    assert misses == misses_before
+    assert hits > hits_before
+    await check_values(cql, 2 * rounds)
+
+    # Rounds made while the cache is off must not be hidden by a stale
+    # cached state once it is turned back on.
+    await set_cache_size(manager, servers, 0)
+    await increment_all(cql, 2 * rounds, 3 * rounds)
+    await set_cache_size(manager, servers, 1000)
+    await increment_all(cql, 3 * rounds, 4 * rounds)
+    await check_values(cql, 4 * rounds)
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+# Checks that keys evicted from a cache smaller than the working set are
+# read again from system.paxos, with the right state.
+@pytest.mark.asyncio
+async def test_paxos_state_cache_eviction(manager: ManagerClient) -> None:
+    servers, cql = await create_cluster(manager)
+    await set_cache_size(manager, servers, 1)
+
+    rounds = 10
+    _, misses_before = await get_cache_stats(manager, servers)
+    await increment_all(cql, 0, rounds)
+    _, misses = await get_cache_stats(manager, servers)
+    # Keys are updated in turns, so each is evicted before it is used again.
+    assert misses - misses_before >= rounds * key_count
+    await check_values(cql, rounds)
+
+    await cql.run_async("DROP KEYSPACE ks")
+
+
+# Checks that a proposal which was accepted but never learned is found in
+# the cached state by the next round, which completes it.
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_paxos_state_cache_accepted_proposal(manager: ManagerClient) -> None:
+    servers, cql = await create_cluster(manager)
+
+    rounds = 3
+    await increment_all(cql, 0, rounds)
+    hits_before, misses_before = await get_cache_stats(manager, servers)
+
+    pk = 0
+    async with contextlib.AsyncExitStack() as stack:
+        for s in servers:
+            await stack.enter_async_context(inject_error(manager.api, s.ip_addr, 'paxos_error_before_learn'))
+        try:
+            await cql.run_async(f"UPDATE ks.tab SET v = 100 WHERE pk = {pk} IF v = {rounds}")
+        except (WriteFailure, WriteTimeout) as e:
+            logger.info(f"The update failed as expected: {e}")
+
+    # The update was accepted by the replicas, but not applied.
+    rows = await cql.run_async(SimpleStatement(f"SELECT v FROM ks.tab WHERE pk = {pk}", consistency_level=ConsistencyLevel.ALL))
+    assert rows[0].v == rounds
+
+    # A serial read finishes the accepted proposal.
+    rows = await cql.run_async(SimpleStatement(f"SELECT v FROM ks.tab WHERE pk = {pk}", consistency_level=ConsistencyLevel.SERIAL))
+    assert rows[0].v == 100
+    rows = await cql.run_async(SimpleStatement(f"SELECT v FROM ks.tab WHERE pk = {pk}", consistency_level=ConsistencyLevel.ALL))
+    assert rows[0].v == 100
+
+    # The state was served from the cache all along.
+    hits, misses = await get_cache_stats(manager, servers)
+    assert misses == misses_before
+    assert hits > hits_before
+
+    rows = await cql.run_async(f"UPDATE ks.tab SET v = 101 WHERE pk = {pk} IF v = 100")
+    assert rows[0].applied
+
+    await cql.run_async("DROP KEYSPACE ks")
@@ -957,6 +957,9 @@ class scylla_sstable_table_state : public compaction::table_state {
     virtual const std::string get_group_id() const noexcept override { return _group_id; }
     virtual seastar::condition_variable& get_staging_done_condition() noexcept override { return _staging_done_condition; }
     dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override { return dht::token_range(); }
+    double sstables_per_read() const noexcept override { return 0; }
+    double read_rate() const noexcept override { return 0; }
+    double tombstones_per_read() const noexcept override { return 0; }
 };
 
 void validate_output_dir(std::filesystem::path output_dir, bool accept_nonempty_output_dir) {